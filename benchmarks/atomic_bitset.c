@@ -0,0 +1,92 @@
+/*
+ * cAtomicBitset scalability benchmark.
+ *
+ * Every thread claims slots with cAtomicBitset_claim_first_zero and releases them with
+ * cAtomicBitset_test_and_clear: claim/release throughput from 1 to N threads, with and without
+ * per-thread hints. tests/atomic_bitset.c checks that no slot is ever claimed twice.
+ *
+ * Build: cc -O2 -pthread -Iinclude benchmarks/atomic_bitset.c -o atomic_bitset
+ * Usage: ./atomic_bitset [max_threads]
+ */
+
+#include "bench.h"
+#include "cAtomicBitset.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define NUM_SLOTS 4096
+#define OPS_PER_THREAD 200000
+#define HELD_PER_THREAD 8
+
+static _Atomic uint64_t slots_buf[CBITSET64_WORDS(NUM_SLOTS)];
+static cAtomicBitset slots;
+
+typedef struct
+{
+    pthread_t thread;
+    int id;
+    int num_threads;
+    bool use_hint;
+} worker;
+
+static void* worker_run(void* arg)
+{
+    const worker* w = arg;
+    size_t held[HELD_PER_THREAD];
+    size_t hint = w->use_hint ? (size_t) w->id * NUM_SLOTS / w->num_threads : 0;
+
+    for (int op = 0; op < OPS_PER_THREAD; op += HELD_PER_THREAD)
+    {
+        for (int k = 0; k < HELD_PER_THREAD; k++)
+        {
+            held[k] = cAtomicBitset_claim_first_zero(&slots, hint);
+            if (w->use_hint)
+                hint = held[k];
+        }
+        for (int k = 0; k < HELD_PER_THREAD; k++)
+            cAtomicBitset_test_and_clear(&slots, held[k]);
+    }
+    return NULL;
+}
+
+/* Run num_threads workers, returns the elapsed time in ns */
+static uint64_t run(const int num_threads, const bool use_hint)
+{
+    worker workers[num_threads];
+    cAtomicBitset_init_from_buffer(&slots, slots_buf, NUM_SLOTS);
+    const uint64_t start = bench_now_ns();
+    for (int i = 0; i < num_threads; i++)
+    {
+        workers[i].id = i;
+        workers[i].num_threads = num_threads;
+        workers[i].use_hint = use_hint;
+        pthread_create(&workers[i].thread, NULL, worker_run, &workers[i]);
+    }
+    for (int i = 0; i < num_threads; i++)
+        pthread_join(workers[i].thread, NULL);
+    return bench_now_ns() - start;
+}
+
+int main(int argc, char** argv)
+{
+    long max_threads = (argc > 1) ? strtol(argv[1], NULL, 10) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (max_threads < 1)
+        max_threads = 1;
+    /* Every thread holds HELD_PER_THREAD slots at most, so claims can never fail */
+    if (max_threads * HELD_PER_THREAD > NUM_SLOTS)
+        max_threads = NUM_SLOTS / HELD_PER_THREAD;
+
+    printf("%-8s %16s %16s\n", "threads", "no hint Mops/s", "hint Mops/s");
+    /* 1, 2, 4, ... and max_threads */
+    for (int t = 1;; t = (t * 2 < max_threads) ? t * 2 : (int) max_threads)
+    {
+        const double ops = 2.0 * OPS_PER_THREAD * t; // one claim + one release per slot
+        const uint64_t plain = run(t, false);
+        const uint64_t hinted = run(t, true);
+        printf("%-8d %16.2f %16.2f\n", t, ops * 1000.0 / plain, ops * 1000.0 / hinted);
+        if (t >= max_threads)
+            break;
+    }
+    return 0;
+}
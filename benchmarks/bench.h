@@ -0,0 +1,173 @@
+/* SPDX-License-Identifier: MIT */
+
+/* Small timing helpers shared by the benchmarks, not part of the library */
+
+#pragma once
+
+#ifndef CSTL_BENCH_H
+#define CSTL_BENCH_H
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+/* syscall() for perf_event_open */
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* Monotonic time in nanoseconds */
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+}
+
+/* Results are written here so the compiler cannot drop the measured work */
+static volatile uint64_t bench_sink;
+
+/* xorshift64* generator, deterministic across runs */
+static inline uint64_t bench_rand(uint64_t* state)
+{
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/*
+ * CPU cycles and last level cache misses of the calling thread, counted with perf_event_open in
+ * user space only. available is false when the counters cannot be opened (not Linux, no PMU in a
+ * VM, or perf_event_paranoid too high), every read then returns 0.
+ */
+typedef struct
+{
+    int cycles_fd;
+    int misses_fd;
+    bool available;
+} bench_counters;
+
+#if defined(__linux__)
+static inline int bench_counter_open(const uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static inline void bench_counters_open(bench_counters* counters)
+{
+    counters->cycles_fd = bench_counter_open(PERF_COUNT_HW_CPU_CYCLES);
+    counters->misses_fd = bench_counter_open(PERF_COUNT_HW_CACHE_MISSES);
+    counters->available = (counters->cycles_fd >= 0) && (counters->misses_fd >= 0);
+    if (! counters->available)
+    {
+        if (counters->cycles_fd >= 0)
+            close(counters->cycles_fd);
+        if (counters->misses_fd >= 0)
+            close(counters->misses_fd);
+    }
+}
+
+static inline void bench_counters_close(bench_counters* counters)
+{
+    if (counters->available)
+    {
+        close(counters->cycles_fd);
+        close(counters->misses_fd);
+        counters->available = false;
+    }
+}
+
+/* Zero both counters, they stay stopped until bench_counters_resume */
+static inline void bench_counters_reset(bench_counters* counters)
+{
+    if (counters->available)
+    {
+        ioctl(counters->cycles_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counters->misses_fd, PERF_EVENT_IOC_RESET, 0);
+    }
+}
+
+static inline void bench_counters_resume(bench_counters* counters)
+{
+    if (counters->available)
+    {
+        ioctl(counters->cycles_fd, PERF_EVENT_IOC_ENABLE, 0);
+        ioctl(counters->misses_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+static inline void bench_counters_pause(bench_counters* counters)
+{
+    if (counters->available)
+    {
+        ioctl(counters->cycles_fd, PERF_EVENT_IOC_DISABLE, 0);
+        ioctl(counters->misses_fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+}
+
+/* Counts since the last reset */
+static inline void bench_counters_read(bench_counters* counters, uint64_t* cycles, uint64_t* misses)
+{
+    *cycles = *misses = 0;
+    if (counters->available && ((read(counters->cycles_fd, cycles, sizeof(*cycles)) != 8) ||
+                                (read(counters->misses_fd, misses, sizeof(*misses)) != 8)))
+        *cycles = *misses = 0;
+}
+#else
+static inline void bench_counters_open(bench_counters* counters)
+{
+    counters->cycles_fd = counters->misses_fd = -1;
+    counters->available = false;
+}
+
+static inline void bench_counters_close(bench_counters* counters)
+{
+    (void) counters;
+}
+
+static inline void bench_counters_reset(bench_counters* counters)
+{
+    (void) counters;
+}
+
+static inline void bench_counters_resume(bench_counters* counters)
+{
+    (void) counters;
+}
+
+static inline void bench_counters_pause(bench_counters* counters)
+{
+    (void) counters;
+}
+
+static inline void bench_counters_read(bench_counters* counters, uint64_t* cycles, uint64_t* misses)
+{
+    (void) counters;
+    *cycles = *misses = 0;
+}
+#endif
+
+#endif // CSTL_BENCH_H
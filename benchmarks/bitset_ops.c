@@ -0,0 +1,108 @@
+/*
+ * Whole-bitset algebra throughput: the per-bit cBitset_readbit loop against the SIMD kernels at
+ * every instruction set level this CPU supports.
+ *
+ * Build: cc -O2 -Iinclude benchmarks/bitset_ops.c -o bitset_ops
+ */
+
+#include "bench.h"
+#include "cBitset.h"
+#include <stdlib.h>
+
+static const char* isa_names[] = {"scalar", "sse2", "avx2", "avx512"};
+
+/* Input bytes processed per second, in GB/s */
+static double gbps(const size_t bytes, const int reps, const uint64_t ns)
+{
+    return ((double) bytes * reps) / (double) ns;
+}
+
+static void bench_size(const size_t num_bits, const int reps)
+{
+    const size_t bytes = CBITSET_SIZE(num_bits);
+    uint8_t* buf_a = malloc(bytes);
+    uint8_t* buf_b = malloc(bytes);
+    uint8_t* buf_d = malloc(bytes);
+    if (! buf_a || ! buf_b || ! buf_d)
+        return;
+
+    cBitset a, b, d;
+    cBitset_init_from_buffer(&a, buf_a, num_bits);
+    cBitset_init_from_buffer(&b, buf_b, num_bits);
+    cBitset_init_from_buffer(&d, buf_d, num_bits);
+    uint64_t seed = 42;
+    for (size_t i = 0; i < bytes; i++)
+    {
+        buf_a[i] = (uint8_t) bench_rand(&seed);
+        buf_b[i] = (uint8_t) bench_rand(&seed);
+    }
+
+    printf("%zu bits (%zu KB per bitset)\n", num_bits, bytes / 1024);
+
+    /* Per-bit baseline, what callers had to write before */
+    uint64_t start = bench_now_ns();
+    size_t count = 0;
+    for (int r = 0; r < reps; r++)
+    {
+        for (size_t i = 0; i < num_bits; i++)
+        {
+            if (cBitset_readbit(&a, i) && cBitset_readbit(&b, i))
+            {
+                cBitset_setbit(&d, i);
+                count++;
+            }
+            else
+            {
+                cBitset_clearbit(&d, i);
+            }
+        }
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+    bench_sink = count;
+    printf("  %-8s %-10s %8.3f GB/s\n", "per-bit", "and+count", gbps(2 * bytes, reps, elapsed));
+
+    const cSimd_isa best = cSimd_detect();
+    for (int isa = CSIMD_SCALAR; isa <= (int) best; isa++)
+    {
+        cSimd_isa_set((cSimd_isa) isa);
+
+        start = bench_now_ns();
+        for (int r = 0; r < reps; r++)
+            cBitset_and(&d, &a, &b);
+        elapsed = bench_now_ns() - start;
+        bench_sink = d.bitset[0];
+        printf("  %-8s %-10s %8.3f GB/s\n", isa_names[isa], "and", gbps(2 * bytes, reps, elapsed));
+
+        start = bench_now_ns();
+        for (int r = 0; r < reps; r++)
+            count = cBitset_and_count(&a, &b);
+        elapsed = bench_now_ns() - start;
+        bench_sink = count;
+        printf("  %-8s %-10s %8.3f GB/s\n",
+               isa_names[isa],
+               "and_count",
+               gbps(2 * bytes, reps, elapsed));
+
+        /* d = a & ~a is empty, so none() has to scan everything */
+        cBitset_andnot(&d, &a, &a);
+        start = bench_now_ns();
+        bool empty = true;
+        for (int r = 0; r < reps; r++)
+            empty &= cBitset_none(&d);
+        elapsed = bench_now_ns() - start;
+        bench_sink = empty;
+        printf("  %-8s %-10s %8.3f GB/s\n", isa_names[isa], "none", gbps(bytes, reps, elapsed));
+    }
+
+    free(buf_a);
+    free(buf_b);
+    free(buf_d);
+}
+
+int main(void)
+{
+    bench_size(1 << 15, 20000); // 4 KB, L1
+    bench_size(1 << 20, 500);   // 128 KB, L2
+    bench_size(1 << 26, 5);     // 8 MB, L3 / DRAM
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * cBTree benchmark against the sorted cArray map.
+ *
+ * For each size n, builds a map of n random 64-bit keys both as a cArray of key/value pairs kept
+ * sorted (push + sort, binsert alone would take hours at 10M) and as a B+tree, then measures at
+ * that size: inserting new random keys one by one (binsert against the B+tree insert), looking
+ * keys up (bsearch against find) and erasing them again. Reports ns per operation.
+ *
+ * Build: cc -O2 -Iinclude benchmarks/btree.c -o btree
+ * Usage: ./btree [num_keys ...]   (default 1000 100000 10000000)
+ */
+
+#include "bench.h"
+#include "cArray.h"
+#include "cBTree.h"
+#include <stdlib.h>
+
+#define OPS 10000
+/* binsert and delete move n / 2 pairs per call, run fewer of them on large arrays */
+#define ARRAY_OPS(n) (((n) > 1000000) ? 200 : OPS)
+#define LOOKUPS (1 << 20)
+
+typedef uint64_t u64;
+
+typedef struct
+{
+    u64 key;
+    u64 value;
+} Pair;
+
+static inline void Pair_cpy(Pair* dest, const Pair* src)
+{
+    *dest = *src;
+}
+
+static inline int Pair_cmp(const Pair* a, const Pair* b)
+{
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+static inline int u64_cmp(const u64* a, const u64* b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+CARRAY_GENERATE_EX(Pair, Pair_cpy, Pair_cmp, CARRAY_TRIVIAL)
+CBTREE_GENERATE(u64, u64, u64_cmp)
+
+static double ns_per_op(const uint64_t start, const int ops)
+{
+    return (double) (bench_now_ns() - start) / ops;
+}
+
+static int run(const int num_keys)
+{
+    const int total = num_keys + OPS;
+    const int num_nodes = (int) CBTREE_NODES(u64, total);
+    u64* keys = malloc((size_t) total * sizeof(u64));
+    Pair* pairs = malloc((size_t) total * sizeof(Pair));
+    cPool_cBTree_u64_u64_node_slot* slots = malloc((size_t) num_nodes * sizeof(*slots));
+    uint64_t* live = malloc(CBITSET64_WORDS(num_nodes) * sizeof(uint64_t));
+    if (! keys || ! pairs || ! slots || ! live)
+        return 1;
+    /* keys[num_keys..] are the new keys inserted (and erased) at size num_keys */
+    uint64_t state = 42;
+    for (int i = 0; i < total; i++)
+        keys[i] = bench_rand(&state);
+
+    cArray_Pair arr;
+    cArray_Pair_init_from_buffer(&arr, pairs, total);
+    cPool_cBTree_u64_u64_node pool;
+    cPool_cBTree_u64_u64_node_init_from_buffer(&pool, slots, live, num_nodes);
+    cBTree_u64_u64 tree;
+    if (! cBTree_u64_u64_init(&tree, &pool))
+        return 1;
+
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < num_keys; i++)
+    {
+        const Pair p = {keys[i], (u64) i};
+        cArray_Pair_push(&arr, &p);
+    }
+    cArray_Pair_sort(&arr);
+    const double sort_ns = ns_per_op(start, num_keys);
+    start = bench_now_ns();
+    for (int i = 0; i < num_keys; i++)
+    {
+        const u64 value = (u64) i;
+        cBTree_u64_u64_insert(&tree, &keys[i], &value);
+    }
+    const double build_ns = ns_per_op(start, num_keys);
+
+    const int array_ops = ARRAY_OPS(num_keys);
+    start = bench_now_ns();
+    for (int i = num_keys; i < num_keys + array_ops; i++)
+    {
+        const Pair p = {keys[i], (u64) i};
+        cArray_Pair_binsert(&arr, &p);
+    }
+    const double binsert_ns = ns_per_op(start, array_ops);
+    start = bench_now_ns();
+    for (int i = num_keys; i < total; i++)
+    {
+        const u64 value = (u64) i;
+        cBTree_u64_u64_insert(&tree, &keys[i], &value);
+    }
+    const double insert_ns = ns_per_op(start, OPS);
+
+    u64 found = 0;
+    start = bench_now_ns();
+    /* the same pseudo-random order of the keys for both */
+    for (int i = 0; i < LOOKUPS; i++)
+    {
+        const Pair p = {keys[((size_t) i * 7919) % (size_t) num_keys], 0};
+        found += (u64) (cArray_Pair_bsearch(&arr, &p) >= 0);
+    }
+    const double bsearch_ns = ns_per_op(start, LOOKUPS);
+    start = bench_now_ns();
+    for (int i = 0; i < LOOKUPS; i++)
+    {
+        const u64* key = &keys[((size_t) i * 7919) % (size_t) num_keys];
+        found += (u64) (cBTree_u64_u64_find(&tree, key) != NULL);
+    }
+    const double find_ns = ns_per_op(start, LOOKUPS);
+
+    start = bench_now_ns();
+    for (int i = num_keys; i < num_keys + array_ops; i++)
+    {
+        const Pair p = {keys[i], 0};
+        const int index = cArray_Pair_bsearch(&arr, &p);
+        if (index >= 0)
+            cArray_Pair_delete(&arr, index);
+    }
+    const double delete_ns = ns_per_op(start, array_ops);
+    start = bench_now_ns();
+    for (int i = num_keys; i < total; i++)
+        found += (u64) cBTree_u64_u64_erase(&tree, &keys[i]);
+    const double erase_ns = ns_per_op(start, OPS);
+    bench_sink = found;
+
+    printf("%d keys, B+tree height %d, %d nodes of %zu bytes\n", num_keys, tree.height, pool.size,
+           sizeof(*slots));
+    printf("%-22s %14s %14s\n", "operation", "sorted cArray", "cBTree");
+    printf("%-22s %14.1f %14.1f\n", "build", sort_ns, build_ns);
+    printf("%-22s %14.1f %14.1f\n", "insert one by one", binsert_ns, insert_ns);
+    printf("%-22s %14.1f %14.1f\n", "lookup", bsearch_ns, find_ns);
+    printf("%-22s %14.1f %14.1f\n\n", "erase one by one", delete_ns, erase_ns);
+
+    free(keys);
+    free(pairs);
+    free(slots);
+    free(live);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    static const int default_sizes[] = {1000, 100000, 10000000};
+    const int count = (argc > 1) ? argc - 1 : 3;
+    for (int i = 0; i < count; i++)
+    {
+        if (run((argc > 1) ? atoi(argv[i + 1]) : default_sizes[i]))
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * cExternalSort benchmark.
+ *
+ * Writes a file of n random 16 byte records (64-bit key + payload) and sorts it with a memory cap
+ * of a fraction of its size, through the page cache and with O_DIRECT, against loading the whole
+ * file, sorting it with cArray_sort and writing it back. Every output is checked to be sorted.
+ * The files and runs go to the given directory, which needs room for about 3 times the input.
+ *
+ * Build: cc -O2 -Iinclude benchmarks/external_sort.c -o external_sort
+ * Usage: ./external_sort [n] [memory_mb] [dir]   (default 16777216 32 /tmp)
+ */
+
+#define _GNU_SOURCE /* O_DIRECT */
+#include "bench.h"
+#include "cExternalSort.h"
+#include <stdlib.h>
+
+typedef struct
+{
+    uint64_t key;
+    uint64_t payload;
+} Record;
+
+static inline void Record_cpy(Record* dest, const Record* src)
+{
+    *dest = *src;
+}
+
+static inline int Record_cmp(const Record* a, const Record* b)
+{
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+CARRAY_GENERATE_EX(Record, Record_cpy, Record_cmp, CARRAY_TRIVIAL)
+CARRAY_GENERATE_EXTERNAL_SORT(Record, Record_cpy, Record_cmp)
+
+#define IO_RECORDS (1 << 16)
+
+/* Whether path holds n records in key order */
+static bool check_sorted(const char* path, const size_t n)
+{
+    FILE* file = fopen(path, "rb");
+    Record* buf = malloc(IO_RECORDS * sizeof(Record));
+    size_t count = 0, got;
+    uint64_t prev = 0;
+    bool sorted = (file != NULL) && (buf != NULL);
+    while (sorted && ((got = fread(buf, sizeof(Record), IO_RECORDS, file)) > 0))
+    {
+        for (size_t i = 0; i < got; i++)
+        {
+            sorted = sorted && (buf[i].key >= prev);
+            prev = buf[i].key;
+        }
+        count += got;
+    }
+    if (file)
+        fclose(file);
+    free(buf);
+    return sorted && (count == n);
+}
+
+/* Read the whole file, sort it in memory and write it back */
+static bool sort_in_memory(const char* input, const char* output, const size_t n)
+{
+    Record* all = malloc(n * sizeof(Record));
+    FILE* in = fopen(input, "rb");
+    bool ok = all && in && (fread(all, sizeof(Record), n, in) == n);
+    if (in)
+        fclose(in);
+    if (ok)
+    {
+        cArray_Record arr;
+        cArray_Record_init_from_buffer(&arr, all, (int) n);
+        arr.size = (int) n;
+        cArray_Record_sort(&arr);
+        FILE* out = fopen(output, "wb");
+        ok = out && (fwrite(all, sizeof(Record), n, out) == n);
+        ok = out && (fclose(out) == 0) && ok;
+    }
+    free(all);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t n = (argc > 1) ? (size_t) atol(argv[1]) : ((size_t) 1 << 24);
+    const size_t memory_mb = (argc > 2) ? (size_t) atol(argv[2]) : 32;
+    const char* dir = (argc > 3) ? argv[3] : "/tmp";
+    char input[1024], output[1024];
+    snprintf(input, sizeof(input), "%s/cstl_bench_records.bin", dir);
+    snprintf(output, sizeof(output), "%s/cstl_bench_sorted.bin", dir);
+
+    FILE* file = fopen(input, "wb");
+    Record* buf = malloc(IO_RECORDS * sizeof(Record));
+    if (! file || ! buf)
+        return 1;
+    uint64_t state = 42;
+    for (size_t done = 0; done < n; done += IO_RECORDS)
+    {
+        const size_t count = ((n - done) < IO_RECORDS) ? (n - done) : IO_RECORDS;
+        for (size_t i = 0; i < count; i++)
+        {
+            buf[i].key = bench_rand(&state);
+            buf[i].payload = done + i;
+        }
+        fwrite(buf, sizeof(Record), count, file);
+    }
+    fclose(file);
+    free(buf);
+
+    const double mb = (double) (n * sizeof(Record)) / (1 << 20);
+    printf("%zu records (%.0f MB), memory cap %zu MB\n", n, mb, memory_mb);
+    printf("%-28s %10s %10s\n", "sort", "s", "MB/s");
+    int failures = 0;
+    uint64_t start = bench_now_ns();
+    bool ok = sort_in_memory(input, output, n);
+    double s = (double) (bench_now_ns() - start) / 1e9;
+    failures += ! ok || ! check_sorted(output, n);
+    printf("%-28s %10.2f %10.0f\n", "in memory (load + sort)", s, mb / s);
+
+    for (int direct = 0; direct < 2; direct++)
+    {
+        cExtSort_config config = cExtSort_default_config();
+        config.memory = memory_mb << 20;
+        config.temp_dir = dir;
+        config.direct_io = direct;
+        start = bench_now_ns();
+        ok = cArray_Record_external_sort(input, output, &config);
+        s = (double) (bench_now_ns() - start) / 1e9;
+        failures += ! ok || ! check_sorted(output, n);
+        printf("%-28s %10.2f %10.0f\n", direct ? "external, O_DIRECT" : "external, page cache", s,
+               mb / s);
+    }
+
+    unlink(input);
+    unlink(output);
+    if (failures)
+        printf("%d wrong results\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * cHashMap benchmark against the sorted cArray map.
+ *
+ * Builds a map of num_keys random 64-bit keys to values, then runs random lookups that hit and
+ * that miss. The cArray map is an array of key/value pairs sorted by key: built with push + sort
+ * (and with binsert for small sizes, the only way to keep it sorted while inserting) and searched
+ * with bsearch. The hash map is sized for a load factor of at most 7/8. Reports ns per operation.
+ *
+ * Build: cc -O2 -Iinclude benchmarks/hashmap.c -o hashmap
+ * Usage: ./hashmap [num_keys]
+ */
+
+#include "bench.h"
+#include "cArray.h"
+#include "cHashMap.h"
+#include <stdlib.h>
+
+#define LOOKUPS (1 << 22)
+/* binsert is O(n) per insert, only run it up to this many keys */
+#define BINSERT_MAX_KEYS (1 << 17)
+
+typedef uint64_t u64;
+
+typedef struct
+{
+    u64 key;
+    u64 value;
+} Pair;
+
+static inline void Pair_cpy(Pair* dest, const Pair* src)
+{
+    *dest = *src;
+}
+
+static inline int Pair_cmp(const Pair* a, const Pair* b)
+{
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+CARRAY_GENERATE_EX(Pair, Pair_cpy, Pair_cmp, CARRAY_TRIVIAL)
+CHASH_PRIMITIVE(u64)
+CHASHMAP_GENERATE(u64, u64, u64_hash, u64_eq)
+
+static double ns_per_op(const uint64_t start, const int ops)
+{
+    return (double) (bench_now_ns() - start) / ops;
+}
+
+int main(int argc, char** argv)
+{
+    const int num_keys = (argc > 1) ? atoi(argv[1]) : 1000000;
+    size_t capacity = CHASH_GROUP;
+    while (CHASH_MAX_LOAD(capacity) < (size_t) num_keys)
+        capacity *= 2;
+
+    u64* keys = malloc((size_t) num_keys * sizeof(u64));
+    u64* misses = malloc((size_t) num_keys * sizeof(u64));
+    Pair* pairs = malloc((size_t) num_keys * sizeof(Pair));
+    uint8_t* ctrl = malloc(CHASH_CTRL_BYTES(capacity));
+    cHashMap_u64_u64_entry* entries = malloc(capacity * sizeof(cHashMap_u64_u64_entry));
+    if (! keys || ! misses || ! pairs || ! ctrl || ! entries)
+        return 1;
+    uint64_t state = 42;
+    /* odd keys are stored, even keys miss */
+    for (int i = 0; i < num_keys; i++)
+    {
+        keys[i] = bench_rand(&state) | 1;
+        misses[i] = bench_rand(&state) & ~1ULL;
+    }
+
+    cArray_Pair arr;
+    cArray_Pair_init_from_buffer(&arr, pairs, num_keys);
+    cHashMap_u64_u64 map;
+    if (! cHashMap_u64_u64_init_from_buffer(&map, ctrl, entries, capacity))
+        return 1;
+
+    printf("%d keys, hash map capacity %zu (load %.2f)\n", num_keys, capacity,
+           (double) num_keys / (double) capacity);
+    printf("%-22s %14s %14s\n", "operation", "sorted cArray", "cHashMap");
+
+    double binsert_ns = -1;
+    if (num_keys <= BINSERT_MAX_KEYS)
+    {
+        const uint64_t start = bench_now_ns();
+        for (int i = 0; i < num_keys; i++)
+        {
+            const Pair p = {keys[i], (u64) i};
+            cArray_Pair_binsert(&arr, &p);
+        }
+        binsert_ns = ns_per_op(start, num_keys);
+        arr.size = 0;
+    }
+
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < num_keys; i++)
+    {
+        const Pair p = {keys[i], (u64) i};
+        cArray_Pair_push(&arr, &p);
+    }
+    cArray_Pair_sort(&arr);
+    const double build_ns = ns_per_op(start, num_keys);
+
+    start = bench_now_ns();
+    for (int i = 0; i < num_keys; i++)
+    {
+        const u64 value = (u64) i;
+        cHashMap_u64_u64_insert(&map, &keys[i], &value);
+    }
+    const double insert_ns = ns_per_op(start, num_keys);
+
+    if (binsert_ns >= 0)
+        printf("%-22s %14.1f %14.1f\n", "insert one by one", binsert_ns, insert_ns);
+    printf("%-22s %14.1f %14.1f\n", "build (push + sort)", build_ns, insert_ns);
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const u64* probe = pass ? misses : keys;
+        u64 found = 0;
+        start = bench_now_ns();
+        /* the same pseudo-random order of the keys for both */
+        for (int i = 0; i < LOOKUPS; i++)
+        {
+            const Pair p = {probe[((size_t) i * 7919) % (size_t) num_keys], 0};
+            found += (u64) (cArray_Pair_bsearch(&arr, &p) >= 0);
+        }
+        const double sorted_ns = ns_per_op(start, LOOKUPS);
+        start = bench_now_ns();
+        for (int i = 0; i < LOOKUPS; i++)
+        {
+            const u64* key = &probe[((size_t) i * 7919) % (size_t) num_keys];
+            found += (u64) (cHashMap_u64_u64_find(&map, key) != NULL);
+        }
+        const double hash_ns = ns_per_op(start, LOOKUPS);
+        bench_sink = found;
+        printf("%-22s %14.1f %14.1f\n", pass ? "lookup (miss)" : "lookup (hit)", sorted_ns,
+               hash_ns);
+    }
+
+    free(keys);
+    free(misses);
+    free(pairs);
+    free(ctrl);
+    free(entries);
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * cHeap arity benchmark.
+ *
+ * Plain heap: pushes n random 64-bit keys and pops them all with 2-, 4- and 8-ary heaps, against a
+ * sorted cArray used as a priority queue (binsert in descending order, pop from the end) for sizes
+ * where its O(n) inserts finish. Every pop sequence is checked to be sorted.
+ * Indexed heap: runs Dijkstra's algorithm on a random graph of n vertices and 4 edges per vertex,
+ * which mixes push, pop and decrease_key, with the same arities.
+ *
+ * Build: cc -O2 -Iinclude benchmarks/heap.c -o heap
+ * Usage: ./heap [n]
+ */
+
+#include "bench.h"
+#include "cArray.h"
+#include "cHeap.h"
+#include <stdlib.h>
+
+#define DEGREE 4
+/* binsert is O(n) per push, only run it up to this many keys */
+#define BINSERT_MAX_KEYS (1 << 17)
+
+typedef uint64_t u64;
+
+static inline void u64_cpy(u64* dest, const u64* src)
+{
+    *dest = *src;
+}
+
+static inline int u64_cmp(const u64* a, const u64* b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+/* descending, so the smallest key is at the end of the array */
+static inline int u64_rcmp(const u64* a, const u64* b)
+{
+    return (*a < *b) - (*a > *b);
+}
+
+CARRAY_GENERATE_EX(u64, u64_cpy, u64_rcmp, CARRAY_TRIVIAL)
+
+/* Heaps of u64 named after their arity, e.g. cHeap_u64_4 */
+#define BENCH_HEAP_GENERATE(D)                                                                     \
+    CHEAP_GENERATE_D(u64_##D, u64, u64_cpy, u64_cmp, D)                                            \
+    CINDEXED_HEAP_GENERATE_D(u64_##D, u64, u64_cpy, u64_cmp, D)                                    \
+                                                                                                   \
+    static double push_pop_##D(const u64* keys, u64* buf, const int n, int* failures)              \
+    {                                                                                              \
+        cHeap_u64_##D heap;                                                                        \
+        cHeap_u64_##D##_init_from_buffer(&heap, buf, n);                                           \
+        const uint64_t start = bench_now_ns();                                                     \
+        for (int i = 0; i < n; i++)                                                                \
+            cHeap_u64_##D##_push(&heap, &keys[i]);                                                 \
+        u64 prev = 0, top;                                                                         \
+        while (cHeap_u64_##D##_pop(&heap, &top))                                                   \
+        {                                                                                          \
+            *failures += (top < prev);                                                             \
+            prev = top;                                                                            \
+        }                                                                                          \
+        return (double) (bench_now_ns() - start) / (2.0 * n);                                      \
+    }                                                                                              \
+                                                                                                   \
+    static double dijkstra_##D(const int* edges, const u64* weights, const int n, int* ids,        \
+                               int* pos, u64* dist, u64* checksum)                                 \
+    {                                                                                              \
+        cIndexedHeap_u64_##D heap;                                                                 \
+        cIndexedHeap_u64_##D##_init_from_buffer(&heap, ids, pos, dist, n);                         \
+        const uint64_t start = bench_now_ns();                                                     \
+        const u64 zero = 0;                                                                        \
+        cIndexedHeap_u64_##D##_push(&heap, 0, &zero);                                              \
+        int v;                                                                                     \
+        u64 d, total = 0;                                                                          \
+        while (cIndexedHeap_u64_##D##_pop(&heap, &v, &d))                                          \
+        {                                                                                          \
+            total += d; /* dist[v] stays d, so v is never pushed again */                          \
+            for (int e = v * DEGREE; e < (v + 1) * DEGREE; e++)                                    \
+            {                                                                                      \
+                const int to = edges[e];                                                           \
+                const u64 nd = d + weights[e];                                                     \
+                if (cIndexedHeap_u64_##D##_contains(&heap, to))                                    \
+                    cIndexedHeap_u64_##D##_decrease_key(&heap, to, &nd);                           \
+                else if (dist[to] == ~0ULL)                                                        \
+                    cIndexedHeap_u64_##D##_push(&heap, to, &nd);                                   \
+            }                                                                                      \
+        }                                                                                          \
+        *checksum = total;                                                                         \
+        return (double) (bench_now_ns() - start) / 1e6;                                            \
+    }
+
+BENCH_HEAP_GENERATE(2)
+BENCH_HEAP_GENERATE(4)
+BENCH_HEAP_GENERATE(8)
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+    u64* keys = malloc((size_t) n * sizeof(u64));
+    u64* buf = malloc((size_t) n * sizeof(u64));
+    int* edges = malloc((size_t) n * DEGREE * sizeof(int));
+    u64* weights = malloc((size_t) n * DEGREE * sizeof(u64));
+    int* ids = malloc((size_t) n * sizeof(int));
+    int* pos = malloc((size_t) n * sizeof(int));
+    u64* dist = malloc((size_t) n * sizeof(u64));
+    if (! keys || ! buf || ! edges || ! weights || ! ids || ! pos || ! dist)
+        return 1;
+    uint64_t state = 42;
+    for (int i = 0; i < n; i++)
+        keys[i] = bench_rand(&state);
+    for (int e = 0; e < n * DEGREE; e++)
+    {
+        edges[e] = (int) (bench_rand(&state) % (u64) n);
+        weights[e] = 1 + (bench_rand(&state) % 1000);
+    }
+
+    int failures = 0;
+    printf("%d keys, ns per push or pop\n", n);
+    printf("%-22s %10s\n", "priority queue", "ns/op");
+    if (n <= BINSERT_MAX_KEYS)
+    {
+        cArray_u64 arr;
+        cArray_u64_init_from_buffer(&arr, buf, n);
+        const uint64_t start = bench_now_ns();
+        for (int i = 0; i < n; i++)
+            cArray_u64_binsert(&arr, &keys[i]);
+        u64 prev = 0, top;
+        while (cArray_u64_pop(&arr, &top))
+        {
+            failures += (top < prev);
+            prev = top;
+        }
+        printf("%-22s %10.1f\n", "sorted cArray", (double) (bench_now_ns() - start) / (2.0 * n));
+    }
+    printf("%-22s %10.1f\n", "binary heap", push_pop_2(keys, buf, n, &failures));
+    printf("%-22s %10.1f\n", "4-ary heap", push_pop_4(keys, buf, n, &failures));
+    printf("%-22s %10.1f\n", "8-ary heap", push_pop_8(keys, buf, n, &failures));
+
+    printf("\nDijkstra, %d vertices, %d edges\n", n, n * DEGREE);
+    printf("%-22s %10s\n", "indexed heap", "ms");
+    double (*const runs[3])(const int*, const u64*, int, int*, int*, u64*, u64*) = {
+        dijkstra_2, dijkstra_4, dijkstra_8};
+    static const char* names[3] = {"binary heap", "4-ary heap", "8-ary heap"};
+    u64 sums[3];
+    for (int r = 0; r < 3; r++)
+    {
+        for (int i = 0; i < n; i++)
+            dist[i] = ~0ULL;
+        printf("%-22s %10.1f\n", names[r], runs[r](edges, weights, n, ids, pos, dist, &sums[r]));
+    }
+    failures += (sums[0] != sums[1]) || (sums[0] != sums[2]);
+    bench_sink = sums[0];
+
+    free(keys);
+    free(buf);
+    free(edges);
+    free(weights);
+    free(ids);
+    free(pos);
+    free(dist);
+    if (failures)
+        printf("%d wrong results\n", failures);
+    return failures ? 1 : 0;
+}
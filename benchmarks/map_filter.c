@@ -0,0 +1,183 @@
+/*
+ * cArray functional helpers benchmark.
+ *
+ * Compares the function-pointer cArray_int_map / cArray_int_filter (and hand-written loops
+ * calling a predicate through a pointer for count / reduce / any) with the macro-generated
+ * CARRAY_GENERATE_MAP / FILTER / REDUCE / PREDICATE versions, where the function is inlined and
+ * the loop can be vectorized. Reports nanoseconds per element.
+ *
+ * Build: cc -O2 -Iinclude benchmarks/map_filter.c -o map_filter
+ * (add -march=native to let the generated loops use AVX2 / AVX-512)
+ */
+
+#include "bench.h"
+#include "cArray.h"
+#include <stdlib.h>
+
+/* 256KB of ints, stays in L2 so the loops and not memory are measured */
+#define SIZE (1 << 16)
+#define REPEAT 2000
+
+CARRAY_GENERATE_PRIMITIVE(int)
+
+static inline void scale(int* a)
+{
+    *a = (*a * 3) + 1;
+}
+
+static inline bool is_odd(const int* a)
+{
+    return (*a & 1) != 0;
+}
+
+static inline bool is_negative(const int* a)
+{
+    return *a < 0;
+}
+
+static inline long long add(long long acc, const int* a)
+{
+    return acc + *a;
+}
+
+/* Pointer versions take non-const arguments */
+static void scale_ptr(int* a)
+{
+    scale(a);
+}
+
+static bool is_odd_ptr(int* a)
+{
+    return is_odd(a);
+}
+
+CARRAY_GENERATE_MAP(int, scale, scale)
+CARRAY_GENERATE_FILTER(int, int_cpy, odd, is_odd)
+CARRAY_GENERATE_REDUCE(int, long long, sum, add)
+CARRAY_GENERATE_PREDICATE(int, odd, is_odd)
+CARRAY_GENERATE_PREDICATE(int, negative, is_negative)
+
+/* The callbacks are read through volatile pointers, as if they came from another translation
+ * unit, so the compiler cannot see which function is called and specialize the loops */
+static void (*volatile map_fn)(int*) = scale_ptr;
+static bool (*volatile filter_fn)(int*) = is_odd_ptr;
+static bool (*volatile odd_fn)(const int*) = is_odd;
+static bool (*volatile negative_fn)(const int*) = is_negative;
+static long long (*volatile add_fn)(long long, const int*) = add;
+
+static int count_if_ptr(const cArray_int* arr, bool (*pred)(const int*))
+{
+    int count = 0;
+    for (int i = 0; i < arr->size; i++)
+        count += pred(&arr->array[i]);
+    return count;
+}
+
+static long long reduce_ptr(const cArray_int* arr, long long (*fn)(long long, const int*))
+{
+    long long acc = 0;
+    for (int i = 0; i < arr->size; i++)
+        acc = fn(acc, &arr->array[i]);
+    return acc;
+}
+
+static bool any_of_ptr(const cArray_int* arr, bool (*pred)(const int*))
+{
+    for (int i = 0; i < arr->size; i++)
+    {
+        if (pred(&arr->array[i]))
+            return true;
+    }
+    return false;
+}
+
+static void fill(cArray_int* arr)
+{
+    uint64_t state = 7;
+    arr->size = SIZE;
+    for (int i = 0; i < SIZE; i++)
+        arr->array[i] = (int) (bench_rand(&state) % 1000000);
+}
+
+static void report(const char* name, const uint64_t ns_pointer, const uint64_t ns_generated)
+{
+    const double per_pointer = (double) ns_pointer / ((double) SIZE * REPEAT);
+    const double per_generated = (double) ns_generated / ((double) SIZE * REPEAT);
+    printf("%-10s %10.3f %10.3f %8.1fx\n", name, per_pointer, per_generated,
+           per_pointer / per_generated);
+}
+
+int main(void)
+{
+    int* buf = malloc(SIZE * sizeof(int));
+    if (! buf)
+        return 1;
+    cArray_int arr;
+    cArray_int_init_from_buffer(&arr, buf, SIZE);
+
+    printf("%d elements, ns per element\n", SIZE);
+    printf("%-10s %10s %10s %9s\n", "operation", "pointer", "generated", "speedup");
+
+    uint64_t start, pointer, generated;
+    fill(&arr);
+    start = bench_now_ns();
+    for (int r = 0; r < REPEAT; r++)
+        cArray_int_map(&arr, map_fn);
+    pointer = bench_now_ns() - start;
+    start = bench_now_ns();
+    for (int r = 0; r < REPEAT; r++)
+        cArray_int_map_scale(&arr);
+    generated = bench_now_ns() - start;
+    report("map", pointer, generated);
+
+    pointer = generated = 0;
+    for (int r = 0; r < REPEAT; r++)
+    {
+        fill(&arr);
+        start = bench_now_ns();
+        cArray_int_filter(&arr, filter_fn);
+        pointer += bench_now_ns() - start;
+        bench_sink += (uint64_t) arr.size;
+        fill(&arr);
+        start = bench_now_ns();
+        cArray_int_filter_odd(&arr);
+        generated += bench_now_ns() - start;
+        bench_sink += (uint64_t) arr.size;
+    }
+    report("filter", pointer, generated);
+
+    fill(&arr);
+    start = bench_now_ns();
+    for (int r = 0; r < REPEAT; r++)
+        bench_sink += (uint64_t) count_if_ptr(&arr, odd_fn);
+    pointer = bench_now_ns() - start;
+    start = bench_now_ns();
+    for (int r = 0; r < REPEAT; r++)
+        bench_sink += (uint64_t) cArray_int_count_if_odd(&arr);
+    generated = bench_now_ns() - start;
+    report("count_if", pointer, generated);
+
+    start = bench_now_ns();
+    for (int r = 0; r < REPEAT; r++)
+        bench_sink += (uint64_t) reduce_ptr(&arr, add_fn);
+    pointer = bench_now_ns() - start;
+    start = bench_now_ns();
+    for (int r = 0; r < REPEAT; r++)
+        bench_sink += (uint64_t) cArray_int_reduce_sum(&arr, 0);
+    generated = bench_now_ns() - start;
+    report("reduce", pointer, generated);
+
+    /* No element is negative, so any_of scans everything */
+    start = bench_now_ns();
+    for (int r = 0; r < REPEAT; r++)
+        bench_sink += any_of_ptr(&arr, negative_fn);
+    pointer = bench_now_ns() - start;
+    start = bench_now_ns();
+    for (int r = 0; r < REPEAT; r++)
+        bench_sink += cArray_int_any_of_negative(&arr);
+    generated = bench_now_ns() - start;
+    report("any_of", pointer, generated);
+
+    free(buf);
+    return 0;
+}
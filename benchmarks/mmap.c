@@ -0,0 +1,110 @@
+/*
+ * cMmap startup benchmark.
+ *
+ * Builds a sorted cArray of n random 64-bit keys and a cBitset64 of 8n bits the way a service
+ * would at startup (push + sort, setbit), saves both, then compares with opening the saved files:
+ * mapping alone, mapping with the checksum verified, and mapping followed by 100K lookups (which
+ * fault in the pages they touch). The files are written to the given directory.
+ *
+ * Build: cc -O2 -Iinclude benchmarks/mmap.c -o mmap
+ * Usage: ./mmap [n] [dir]   (default 10000000 /tmp)
+ */
+
+#include "bench.h"
+#include "cMmap.h"
+#include <stdlib.h>
+
+#define LOOKUPS 100000
+
+typedef uint64_t u64;
+
+CARRAY_GENERATE_PRIMITIVE(u64)
+CARRAY_GENERATE_MMAP(u64)
+
+static double ms_since(const uint64_t start)
+{
+    return (double) (bench_now_ns() - start) / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1) ? atoi(argv[1]) : 10000000;
+    const char* dir = (argc > 2) ? argv[2] : "/tmp";
+    char array_path[1024], bits_path[1024];
+    snprintf(array_path, sizeof(array_path), "%s/cstl_bench_array.bin", dir);
+    snprintf(bits_path, sizeof(bits_path), "%s/cstl_bench_bits.bin", dir);
+    const size_t num_bits = (size_t) n * 8;
+    u64* keys = malloc((size_t) n * sizeof(u64));
+    uint64_t* words = malloc(CBITSET64_WORDS(num_bits) * sizeof(uint64_t));
+    if (! keys || ! words)
+        return 1;
+
+    uint64_t state = 42;
+    uint64_t start = bench_now_ns();
+    cArray_u64 arr;
+    cArray_u64_init_from_buffer(&arr, keys, n);
+    for (int i = 0; i < n; i++)
+    {
+        const u64 key = bench_rand(&state);
+        cArray_u64_push(&arr, &key);
+    }
+    cArray_u64_sort(&arr);
+    cBitset64 bits;
+    cBitset64_init_from_buffer(&bits, words, num_bits);
+    for (int i = 0; i < n; i++)
+        cBitset64_setbit(&bits, (size_t) (bench_rand(&state) % num_bits));
+    const double build_ms = ms_since(start);
+
+    start = bench_now_ns();
+    if (! cArray_u64_save(&arr, array_path) || ! cBitset64_save(&bits, bits_path))
+    {
+        printf("cannot write to %s\n", dir);
+        return 1;
+    }
+    const double save_ms = ms_since(start);
+
+    cMmap array_map, bits_map;
+    cArray_u64 mapped;
+    cBitset64 mapped_bits;
+    start = bench_now_ns();
+    bool ok = cArray_u64_open_mmap(&mapped, &array_map, array_path, CMMAP_READ_ONLY, false) &&
+              cBitset64_open_mmap(&mapped_bits, &bits_map, bits_path, CMMAP_READ_ONLY, false);
+    const double open_ms = ms_since(start);
+    u64 found = 0;
+    start = bench_now_ns();
+    for (int i = 0; ok && (i < LOOKUPS); i++)
+    {
+        const u64* key = &keys[((size_t) i * 7919) % (size_t) n];
+        found += (u64) (cArray_u64_bsearch(&mapped, key) >= 0);
+        found += (u64) cBitset64_readbit(&mapped_bits, (size_t) (*key % num_bits));
+    }
+    const double lookup_ms = ms_since(start);
+    cMmap_close(&array_map);
+    cMmap_close(&bits_map);
+
+    start = bench_now_ns();
+    ok = ok && cArray_u64_open_mmap(&mapped, &array_map, array_path, CMMAP_READ_ONLY, true) &&
+         cBitset64_open_mmap(&mapped_bits, &bits_map, bits_path, CMMAP_READ_ONLY, true);
+    const double verify_ms = ms_since(start);
+    ok = ok && (mapped.size == n) && cBitset64_equal(&mapped_bits, &bits);
+    cMmap_close(&array_map);
+    cMmap_close(&bits_map);
+    bench_sink = found;
+
+    printf("%d keys (%zu MB) and %zu bits (%zu MB)\n", n, (size_t) n * sizeof(u64) >> 20, num_bits,
+           num_bits >> 23);
+    printf("%-34s %10s\n", "startup", "ms");
+    printf("%-34s %10.1f\n", "rebuild (push + sort, setbit)", build_ms);
+    printf("%-34s %10.1f\n", "save", save_ms);
+    printf("%-34s %10.3f\n", "open_mmap", open_ms);
+    printf("%-34s %10.1f\n", "open_mmap + 100K lookups", open_ms + lookup_ms);
+    printf("%-34s %10.1f\n", "open_mmap with checksum", verify_ms);
+
+    unlink(array_path);
+    unlink(bits_path);
+    free(keys);
+    free(words);
+    if (! ok)
+        printf("mapped data differs\n");
+    return ok ? 0 : 1;
+}
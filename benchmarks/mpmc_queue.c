@@ -0,0 +1,167 @@
+/*
+ * cMpmcQueue contention benchmark.
+ *
+ * Half of the threads produce and half consume num_items ints in total, through a mutex around
+ * cArray_int_enqueue / dequeue and through cMpmcQueue_int_enqueue / dequeue, for 2, 4, 8, ...
+ * threads. Prints the throughput of both and checks that every item is received exactly once
+ * (by comparing the sum and count of the received values).
+ *
+ * Build: cc -O2 -pthread -Iinclude benchmarks/mpmc_queue.c -o mpmc_queue
+ * Usage: ./mpmc_queue [max_threads] [num_items]
+ */
+
+#include "bench.h"
+#include "cArray.h"
+#include "cMpmcQueue.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+CARRAY_GENERATE_PRIMITIVE(int)
+CMPMC_QUEUE_GENERATE(int, int_cpy)
+
+#define CAPACITY 1024
+#define MAX_THREADS 256
+
+typedef struct
+{
+    bool use_mutex;
+    int items_per_producer;
+    int items_per_consumer;
+    cArray_int ring;
+    pthread_mutex_t lock;
+    cMpmcQueue_int queue;
+    _Atomic uint64_t sum;
+    _Atomic uint64_t count;
+} Shared;
+
+typedef struct
+{
+    Shared* shared;
+    int id;
+} Worker;
+
+static void* producer(void* arg)
+{
+    Worker* w = (Worker*) arg;
+    Shared* s = w->shared;
+    const int first = w->id * s->items_per_producer;
+    for (int i = first; i < first + s->items_per_producer; i++)
+    {
+        if (! s->use_mutex)
+        {
+            cMpmcQueue_int_enqueue(&s->queue, &i);
+            continue;
+        }
+        unsigned spins = 0;
+        for (;;)
+        {
+            pthread_mutex_lock(&s->lock);
+            const bool ok = cArray_int_enqueue(&s->ring, &i);
+            pthread_mutex_unlock(&s->lock);
+            if (ok)
+                break;
+            cMpmcQueue_backoff(&spins);
+        }
+    }
+    return NULL;
+}
+
+static void* consumer(void* arg)
+{
+    Worker* w = (Worker*) arg;
+    Shared* s = w->shared;
+    uint64_t sum = 0;
+    for (int i = 0; i < s->items_per_consumer; i++)
+    {
+        int value;
+        if (! s->use_mutex)
+        {
+            cMpmcQueue_int_dequeue(&s->queue, &value);
+        }
+        else
+        {
+            unsigned spins = 0;
+            for (;;)
+            {
+                pthread_mutex_lock(&s->lock);
+                const bool ok = cArray_int_dequeue(&s->ring, &value);
+                pthread_mutex_unlock(&s->lock);
+                if (ok)
+                    break;
+                cMpmcQueue_backoff(&spins);
+            }
+        }
+        sum += (uint64_t) value;
+    }
+    atomic_fetch_add(&s->sum, sum);
+    atomic_fetch_add(&s->count, (uint64_t) s->items_per_consumer);
+    return NULL;
+}
+
+/* Run one configuration, returns the time in ms or -1 if items were lost or duplicated */
+static double run(Shared* s, const int threads, const int num_items)
+{
+    static int ring_buf[CAPACITY];
+    static cMpmcQueue_int_slot slots[CAPACITY];
+    const int producers = threads / 2, consumers = threads - producers;
+    const int total = num_items / (producers * consumers) * (producers * consumers);
+    s->items_per_producer = total / producers;
+    s->items_per_consumer = total / consumers;
+    cArray_int_init_from_buffer(&s->ring, ring_buf, CAPACITY);
+    cMpmcQueue_int_init_from_buffer(&s->queue, slots, CAPACITY);
+    atomic_store(&s->sum, 0);
+    atomic_store(&s->count, 0);
+
+    pthread_t ids[MAX_THREADS];
+    Worker workers[MAX_THREADS];
+    const uint64_t start = bench_now_ns();
+    for (int t = 0; t < threads; t++)
+    {
+        workers[t].shared = s;
+        workers[t].id = (t < producers) ? t : t - producers;
+        pthread_create(&ids[t], NULL, (t < producers) ? producer : consumer, &workers[t]);
+    }
+    for (int t = 0; t < threads; t++)
+        pthread_join(ids[t], NULL);
+    const double ms = (double) (bench_now_ns() - start) / 1e6;
+
+    const uint64_t expected_sum = (uint64_t) total * (uint64_t) (total - 1) / 2;
+    if ((atomic_load(&s->count) != (uint64_t) total) || (atomic_load(&s->sum) != expected_sum))
+        return -1;
+    return ms;
+}
+
+int main(int argc, char** argv)
+{
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = (argc > 1) ? atoi(argv[1]) : (int) ((cpus > 2) ? cpus : 2);
+    const int num_items = (argc > 2) ? atoi(argv[2]) : 4000000;
+    if (max_threads > MAX_THREADS)
+        max_threads = MAX_THREADS;
+    if (max_threads < 2)
+        max_threads = 2;
+
+    static Shared s;
+    pthread_mutex_init(&s.lock, NULL);
+    printf("%d items, capacity %d, half producers / half consumers\n", num_items, CAPACITY);
+    printf("%8s %16s %16s %8s\n", "threads", "mutex Mitems/s", "mpmc Mitems/s", "speedup");
+    int failures = 0;
+    /* 2, 4, 8, ... and max_threads */
+    for (int threads = 2;; threads = (threads * 2 < max_threads) ? threads * 2 : max_threads)
+    {
+        s.use_mutex = true;
+        const double mutex_ms = run(&s, threads, num_items);
+        s.use_mutex = false;
+        const double mpmc_ms = run(&s, threads, num_items);
+        failures += (mutex_ms < 0) + (mpmc_ms < 0);
+        printf("%8d %16.1f %16.1f %8.2f\n", threads, num_items / mutex_ms / 1e3,
+               num_items / mpmc_ms / 1e3, mutex_ms / mpmc_ms);
+        if (threads >= max_threads)
+            break;
+    }
+    pthread_mutex_destroy(&s.lock);
+    if (failures)
+        printf("%d runs lost or duplicated items\n", failures);
+    return failures ? 1 : 0;
+}
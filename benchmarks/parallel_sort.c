@@ -0,0 +1,115 @@
+/*
+ * cArray parallel sort scaling benchmark.
+ *
+ * Sorts the same input with cArray_int_sort (serial pdqsort) and cArray_int_parallel_sort from 1
+ * to N threads, for several input distributions, and prints the time and speedup over the serial
+ * sort. Every result is checked to be sorted.
+ *
+ * Build: cc -O2 -pthread -Iinclude benchmarks/parallel_sort.c -o parallel_sort
+ * Usage: ./parallel_sort [max_threads] [num_elements]
+ */
+
+#include "bench.h"
+#include "cArrayParallel.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+CARRAY_GENERATE_PRIMITIVE(int)
+CARRAY_GENERATE_PARALLEL(int, int_cpy, int_cmp)
+
+enum
+{
+    DIST_RANDOM,
+    DIST_FEW_UNIQUE,
+    DIST_SORTED,
+    DIST_REVERSED,
+    DIST_NEARLY_SORTED,
+    DIST_COUNT
+};
+
+static const char* dist_names[DIST_COUNT] = {
+    "random", "few-unique", "sorted", "reversed", "nearly-sorted"};
+
+static void fill(int* buf, const int n, const int dist)
+{
+    uint64_t state = 42;
+    for (int i = 0; i < n; i++)
+    {
+        switch (dist)
+        {
+        case DIST_RANDOM:
+            buf[i] = (int) bench_rand(&state);
+            break;
+        case DIST_FEW_UNIQUE:
+            buf[i] = (int) (bench_rand(&state) % 16);
+            break;
+        case DIST_SORTED:
+            buf[i] = i;
+            break;
+        case DIST_REVERSED:
+            buf[i] = n - i;
+            break;
+        default:
+            buf[i] = (bench_rand(&state) % 100 == 0) ? (int) (bench_rand(&state) % n) : i;
+            break;
+        }
+    }
+}
+
+static bool is_sorted(const int* buf, const int n)
+{
+    for (int i = 1; i < n; i++)
+    {
+        if (buf[i - 1] > buf[i])
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    const int max_threads = (argc > 1) ? atoi(argv[1]) : (int) ((cpus > 0) ? cpus : 1);
+    const int n = (argc > 2) ? atoi(argv[2]) : 10000000;
+
+    int* buf = malloc((size_t) n * sizeof(int));
+    int* scratch = malloc((size_t) n * sizeof(int));
+    if (! buf || ! scratch)
+        return 1;
+
+    printf("%d elements, up to %d threads\n", n, max_threads);
+    printf("%-14s %8s %10s %8s\n", "distribution", "threads", "ms", "speedup");
+    int failures = 0;
+    for (int dist = 0; dist < DIST_COUNT; dist++)
+    {
+        cArray_int arr;
+        cArray_int_init_from_buffer(&arr, buf, n);
+        arr.size = n;
+
+        fill(buf, n, dist);
+        uint64_t start = bench_now_ns();
+        cArray_int_sort(&arr);
+        const double serial_ms = (double) (bench_now_ns() - start) / 1e6;
+        failures += ! is_sorted(buf, n);
+        printf("%-14s %8s %10.1f %8.2f\n", dist_names[dist], "serial", serial_ms, 1.0);
+
+        /* 1, 2, 4, ... and max_threads */
+        for (int threads = 1;; threads = (threads * 2 < max_threads) ? threads * 2 : max_threads)
+        {
+            fill(buf, n, dist);
+            start = bench_now_ns();
+            cArray_int_parallel_sort(&arr, 0, n - 1, scratch, threads);
+            const double ms = (double) (bench_now_ns() - start) / 1e6;
+            failures += ! is_sorted(buf, n);
+            printf("%-14s %8d %10.1f %8.2f\n", dist_names[dist], threads, ms, serial_ms / ms);
+            if (threads >= max_threads)
+                break;
+        }
+    }
+    free(buf);
+    free(scratch);
+    if (failures)
+        printf("%d unsorted results\n", failures);
+    return failures ? 1 : 0;
+}
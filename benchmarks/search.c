@@ -0,0 +1,104 @@
+/*
+ * cArray search benchmark.
+ *
+ * Random lookups in a sorted int array sized to fit L1, L2, L3 and DRAM, comparing the classic
+ * branchy binary search (the loop cArray_int_bsearch used to run: two CMP calls and branches per
+ * step), the branchless cArray_int_lower_bound and the Eytzinger index. Reports ns per lookup.
+ *
+ * Build: cc -O2 -Iinclude benchmarks/search.c -o search
+ * Usage: ./search [max_elements]
+ */
+
+#include "bench.h"
+#include "cArray.h"
+#include <stdlib.h>
+
+#define LOOKUPS (1 << 22)
+
+CARRAY_GENERATE_PRIMITIVE(int)
+
+/* The loop of the original cArray_int_bsearch */
+static int bsearch_branchy(const cArray_int* vector, const int* element)
+{
+    if (vector->size <= 0)
+        return -1;
+    if ((int_cmp(element, &vector->array[vector->size - 1]) > 0) ||
+        (int_cmp(element, &vector->array[0]) < 0))
+        return -1;
+
+    int head = 0, tail = vector->size - 1;
+    while (head <= tail)
+    {
+        int index = head + (tail - head) / 2;
+        if (int_cmp(element, &vector->array[index]) == 0)
+            return index;
+        else if (int_cmp(element, &vector->array[index]) > 0)
+            head = index + 1;
+        else
+            tail = index - 1;
+    }
+    return -1;
+}
+
+int main(int argc, char** argv)
+{
+    const int max_elements = (argc > 1) ? atoi(argv[1]) : (1 << 25);
+    /* 16KB (L1), 256KB (L2), 4MB (L3) and 128MB (DRAM) of ints */
+    const int sizes[] = {1 << 12, 1 << 16, 1 << 20, 1 << 25};
+    const char* levels[] = {"L1", "L2", "L3", "DRAM"};
+
+    int* keys = malloc(LOOKUPS * sizeof(int));
+    if (! keys)
+        return 1;
+
+    printf("%-5s %10s %10s %12s %10s\n", "level", "elements", "branchy", "lower_bound",
+           "eytzinger");
+    for (int s = 0; s < 4; s++)
+    {
+        const int n = sizes[s];
+        if (n > max_elements)
+            break;
+        int* buf = malloc((size_t) n * sizeof(int));
+        int* tree = malloc(((size_t) n + 1) * sizeof(int));
+        int* rank = malloc(((size_t) n + 1) * sizeof(int));
+        if (! buf || ! tree || ! rank)
+            return 1;
+
+        /* Even numbers, half of the lookups hit */
+        cArray_int arr;
+        cArray_int_init_from_buffer(&arr, buf, n);
+        for (int i = 0; i < n; i++)
+            buf[i] = 2 * i;
+        arr.size = n;
+        cArray_int_eytzinger index;
+        cArray_int_eytzinger_init(&index, tree, rank, &arr);
+
+        uint64_t state = 99;
+        for (int i = 0; i < LOOKUPS; i++)
+            keys[i] = (int) (bench_rand(&state) % (2ULL * (uint64_t) n));
+
+        uint64_t sum = 0;
+        uint64_t start = bench_now_ns();
+        for (int i = 0; i < LOOKUPS; i++)
+            sum += (uint64_t) bsearch_branchy(&arr, &keys[i]);
+        const double branchy = (double) (bench_now_ns() - start) / LOOKUPS;
+
+        start = bench_now_ns();
+        for (int i = 0; i < LOOKUPS; i++)
+            sum += (uint64_t) cArray_int_lower_bound(&arr, &keys[i]);
+        const double lower = (double) (bench_now_ns() - start) / LOOKUPS;
+
+        start = bench_now_ns();
+        for (int i = 0; i < LOOKUPS; i++)
+            sum += (uint64_t) cArray_int_eytzinger_lower_bound(&index, &keys[i]);
+        const double eytzinger = (double) (bench_now_ns() - start) / LOOKUPS;
+        bench_sink += sum;
+
+        printf("%-5s %10d %8.1fns %10.1fns %8.1fns\n", levels[s], n, branchy, lower, eytzinger);
+        free(buf);
+        free(tree);
+        free(rank);
+    }
+    free(keys);
+    return 0;
+}
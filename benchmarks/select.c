@@ -0,0 +1,131 @@
+/*
+ * Selection benchmark: the statistics a full sort was used for, against nth_element,
+ * partial_sort / top_k and minmax.
+ *
+ * On n random latencies (double), measures: sorting the whole array, the p50 and p99 with
+ * nth_element, the 100 smallest and largest values with partial_sort and top_k (bounded heap) and
+ * the smallest and largest 1% of the values (select then sort), and min / max with the SIMD
+ * kernel and with the CMP loop (same values as a struct, so the kernels do not apply).
+ * Every result is checked against the sorted array.
+ *
+ * Build: cc -O2 -Iinclude benchmarks/select.c -o select
+ * Usage: ./select [n]
+ */
+
+#include "bench.h"
+#include "cArray.h"
+#include <stdlib.h>
+
+#define TOP 100
+
+typedef struct
+{
+    double value;
+} Sample;
+
+static inline void Sample_cpy(Sample* dest, const Sample* src)
+{
+    *dest = *src;
+}
+
+static inline int Sample_cmp(const Sample* a, const Sample* b)
+{
+    return (a->value > b->value) - (a->value < b->value);
+}
+
+CARRAY_GENERATE_PRIMITIVE(double)
+CARRAY_GENERATE(Sample, Sample_cpy, Sample_cmp)
+
+static double ms_since(const uint64_t start)
+{
+    return (double) (bench_now_ns() - start) / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+    const int n = (argc > 1) ? atoi(argv[1]) : 10000000;
+    double* values = malloc((size_t) n * sizeof(double));
+    double* sorted = malloc((size_t) n * sizeof(double));
+    double* buf = malloc((size_t) n * sizeof(double));
+    Sample* samples = malloc((size_t) n * sizeof(Sample));
+    if (! values || ! sorted || ! buf || ! samples || (n < TOP))
+        return 1;
+    /* log-normal-ish latencies in microseconds */
+    uint64_t state = 42;
+    for (int i = 0; i < n; i++)
+    {
+        const double u = (double) (bench_rand(&state) >> 11) / 9007199254740992.0;
+        values[i] = 50.0 / (1.0 - (0.999 * u));
+        samples[i].value = values[i];
+    }
+    const size_t bytes = (size_t) n * sizeof(double);
+    cArray_double arr;
+    cArray_double_init_from_buffer(&arr, sorted, n);
+    arr.size = n;
+    memcpy(sorted, values, bytes);
+    uint64_t start = bench_now_ns();
+    cArray_double_sort(&arr);
+    const double sort_ms = ms_since(start);
+
+    int failures = 0;
+    arr.array = buf;
+    printf("%d values\n", n);
+    printf("%-34s %10s\n", "operation", "ms");
+    printf("%-34s %10.2f\n", "sort (every statistic below)", sort_ms);
+
+    const int p50 = n / 2, p99 = (int) (((int64_t) n * 99) / 100);
+    memcpy(buf, values, bytes);
+    start = bench_now_ns();
+    cArray_double_nth_element(&arr, 0, n - 1, p50);
+    printf("%-34s %10.2f\n", "nth_element p50", ms_since(start));
+    failures += (buf[p50] != sorted[p50]);
+    memcpy(buf, values, bytes);
+    start = bench_now_ns();
+    cArray_double_nth_element(&arr, 0, n - 1, p99);
+    printf("%-34s %10.2f\n", "nth_element p99", ms_since(start));
+    failures += (buf[p99] != sorted[p99]);
+
+    const int ks[2] = {TOP, n / 100};
+    for (int q = 0; q < 2; q++)
+    {
+        const int k = ks[q];
+        char label[64];
+        memcpy(buf, values, bytes);
+        start = bench_now_ns();
+        cArray_double_partial_sort(&arr, 0, n - 1, k);
+        snprintf(label, sizeof(label), "partial_sort k = %d", k);
+        printf("%-34s %10.2f\n", label, ms_since(start));
+        failures += (memcmp(buf, sorted, (size_t) k * sizeof(double)) != 0);
+        memcpy(buf, values, bytes);
+        start = bench_now_ns();
+        cArray_double_top_k(&arr, 0, n - 1, k);
+        snprintf(label, sizeof(label), "top_k k = %d", k);
+        printf("%-34s %10.2f\n", label, ms_since(start));
+        for (int i = 0; i < k; i++)
+            failures += (buf[i] != sorted[n - 1 - i]);
+    }
+
+    memcpy(buf, values, bytes);
+    double min, max;
+    start = bench_now_ns();
+    cArray_double_minmax(&arr, 0, n - 1, &min, &max);
+    printf("%-34s %10.2f\n", "minmax (SIMD)", ms_since(start));
+    failures += (min != sorted[0]) || (max != sorted[n - 1]);
+    cArray_Sample sample_arr;
+    cArray_Sample_init_from_buffer(&sample_arr, samples, n);
+    sample_arr.size = n;
+    Sample smin, smax;
+    start = bench_now_ns();
+    cArray_Sample_minmax(&sample_arr, 0, n - 1, &smin, &smax);
+    printf("%-34s %10.2f\n", "minmax (CMP)", ms_since(start));
+    failures += (smin.value != sorted[0]) || (smax.value != sorted[n - 1]);
+    bench_sink = (uint64_t) (min + max + smin.value + smax.value);
+
+    free(values);
+    free(sorted);
+    free(buf);
+    free(samples);
+    if (failures)
+        printf("%d wrong results\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,186 @@
+/*
+ * cSpscQueue throughput and latency benchmark.
+ *
+ * Throughput: a producer thread sends num_items ints to a consumer thread through a mutex around
+ * cArray_int_enqueue / dequeue, through cSpscQueue_int_enqueue / dequeue and through enqueue_n /
+ * dequeue_n in batches of 64. The consumer checks that every item arrives in order.
+ * Latency: two threads bounce one int through a pair of queues, the round trip time is reported.
+ * Spinning threads yield when the queue is full or empty, so the numbers stay meaningful when
+ * both threads share a core, but the queue is meant for threads on separate cores.
+ *
+ * Build: cc -O2 -pthread -Iinclude benchmarks/spsc_queue.c -o spsc_queue
+ * Usage: ./spsc_queue [num_items]
+ */
+
+#include "bench.h"
+#include "cArray.h"
+#include "cSpscQueue.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+CARRAY_GENERATE_PRIMITIVE(int)
+CSPSC_QUEUE_GENERATE(int, int_cpy)
+
+#define CAPACITY 4096
+#define BATCH 64
+#define ROUND_TRIPS 100000
+
+enum
+{
+    MODE_MUTEX,
+    MODE_SPSC,
+    MODE_SPSC_BATCH,
+    MODE_COUNT
+};
+
+static const char* mode_names[MODE_COUNT] = {"mutex + cArray", "spsc", "spsc batch 64"};
+
+typedef struct
+{
+    int mode;
+    int num_items;
+    cArray_int ring;
+    pthread_mutex_t lock;
+    cSpscQueue_int queue;
+    cSpscQueue_int reply;
+    int errors;
+} Shared;
+
+static bool mutex_enqueue(Shared* s, const int* value)
+{
+    pthread_mutex_lock(&s->lock);
+    const bool ok = cArray_int_enqueue(&s->ring, value);
+    pthread_mutex_unlock(&s->lock);
+    return ok;
+}
+
+static bool mutex_dequeue(Shared* s, int* value)
+{
+    pthread_mutex_lock(&s->lock);
+    const bool ok = cArray_int_dequeue(&s->ring, value);
+    pthread_mutex_unlock(&s->lock);
+    return ok;
+}
+
+static void* producer(void* arg)
+{
+    Shared* s = (Shared*) arg;
+    int batch[BATCH];
+    for (int i = 0; i < s->num_items;)
+    {
+        if (s->mode == MODE_SPSC_BATCH)
+        {
+            const int n = (s->num_items - i < BATCH) ? s->num_items - i : BATCH;
+            for (int k = 0; k < n; k++)
+                batch[k] = i + k;
+            size_t sent = 0;
+            while (sent < (size_t) n)
+            {
+                const size_t done = cSpscQueue_int_enqueue_n(&s->queue, batch + sent, n - sent);
+                if (! done)
+                    sched_yield();
+                sent += done;
+            }
+            i += n;
+            continue;
+        }
+        const bool ok = (s->mode == MODE_MUTEX) ? mutex_enqueue(s, &i)
+                                                : cSpscQueue_int_enqueue(&s->queue, &i);
+        if (ok)
+            i++;
+        else
+            sched_yield();
+    }
+    return NULL;
+}
+
+static void consume(Shared* s)
+{
+    int batch[BATCH];
+    for (int expected = 0; expected < s->num_items;)
+    {
+        if (s->mode == MODE_SPSC_BATCH)
+        {
+            const size_t n = cSpscQueue_int_dequeue_n(&s->queue, batch, BATCH);
+            if (! n)
+                sched_yield();
+            for (size_t k = 0; k < n; k++)
+                s->errors += (batch[k] != expected++);
+            continue;
+        }
+        int value;
+        const bool ok = (s->mode == MODE_MUTEX) ? mutex_dequeue(s, &value)
+                                                : cSpscQueue_int_dequeue(&s->queue, &value);
+        if (! ok)
+        {
+            sched_yield();
+            continue;
+        }
+        s->errors += (value != expected++);
+    }
+}
+
+/* Echo every int received on queue back on reply */
+static void* echo(void* arg)
+{
+    Shared* s = (Shared*) arg;
+    for (int i = 0; i < ROUND_TRIPS; i++)
+    {
+        int value;
+        while (! cSpscQueue_int_dequeue(&s->queue, &value))
+            sched_yield();
+        while (! cSpscQueue_int_enqueue(&s->reply, &value))
+            sched_yield();
+    }
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    const int num_items = (argc > 1) ? atoi(argv[1]) : 10000000;
+    static int ring_buf[CAPACITY], queue_buf[CAPACITY], reply_buf[CAPACITY];
+    static Shared s;
+    pthread_mutex_init(&s.lock, NULL);
+    s.num_items = num_items;
+
+    printf("%d items, capacity %d\n", num_items, CAPACITY);
+    printf("%-16s %10s %14s\n", "queue", "ms", "Mitems/s");
+    for (int mode = 0; mode < MODE_COUNT; mode++)
+    {
+        s.mode = mode;
+        cArray_int_init_from_buffer(&s.ring, ring_buf, CAPACITY);
+        cSpscQueue_int_init_from_buffer(&s.queue, queue_buf, CAPACITY);
+
+        pthread_t thread;
+        const uint64_t start = bench_now_ns();
+        pthread_create(&thread, NULL, producer, &s);
+        consume(&s);
+        pthread_join(thread, NULL);
+        const double ms = (double) (bench_now_ns() - start) / 1e6;
+        printf("%-16s %10.1f %14.1f\n", mode_names[mode], ms, num_items / ms / 1e3);
+    }
+
+    cSpscQueue_int_init_from_buffer(&s.queue, queue_buf, CAPACITY);
+    cSpscQueue_int_init_from_buffer(&s.reply, reply_buf, CAPACITY);
+    pthread_t thread;
+    pthread_create(&thread, NULL, echo, &s);
+    const uint64_t start = bench_now_ns();
+    for (int i = 0; i < ROUND_TRIPS; i++)
+    {
+        int value = i;
+        while (! cSpscQueue_int_enqueue(&s.queue, &value))
+            sched_yield();
+        while (! cSpscQueue_int_dequeue(&s.reply, &value))
+            sched_yield();
+        s.errors += (value != i);
+    }
+    const double ns = (double) (bench_now_ns() - start) / ROUND_TRIPS;
+    pthread_join(thread, NULL);
+    printf("round trip latency: %.0f ns\n", ns);
+
+    pthread_mutex_destroy(&s.lock);
+    if (s.errors)
+        printf("%d items out of order\n", s.errors);
+    return s.errors ? 1 : 0;
+}
@@ -0,0 +1,12 @@
+/*
+ * std::sort for benchmarks/suite.c, which is C: compiled as C++ and linked into the suite (see
+ * benchmarks/Makefile).
+ */
+
+#include <algorithm>
+#include <cstddef>
+
+extern "C" void bench_std_sort_int(int* data, size_t n)
+{
+    std::sort(data, data + n);
+}
@@ -0,0 +1,482 @@
+/*
+ * Benchmark suite of the cArray and cBitset operations, with machine-readable results.
+ *
+ * Every case runs once to warm up, then repeats until it measured at least MIN_TIME_NS. Only the
+ * operations are timed, refilling the input between repetitions is not. Results are printed to
+ * stdout as one JSON document, progress goes to stderr:
+ * {"suite": "cstl", "compiler": ..., "perf_counters": true, "results": [{"group": "sort",
+ *  "op": "pdq_sort", "type": "int", "distribution": "random", "n": 1000, "reps": 812,
+ *  "ns_per_op": 21.3, "cycles_per_op": 80.1, "cache_misses_per_op": 0.01}, ...]}
+ * cycles_per_op and cache_misses_per_op come from perf_event_open and are null when the counters
+ * are not available (bench.h). An op is one element for sorts, push, enqueue / dequeue and bit
+ * accesses, and one call for insert, delete, find, bsearch and binsert.
+ *
+ * Groups, each at every size up to max_n (default 1000 32768 1048576):
+ * - array: push, insert / delete at random indices, find, bsearch and binsert of random keys
+ * - sort: pdq_sort, tim_sort, radix_sort, quick_sort, merge_sort and insertion_sort (up to
+ *   INSERTION_MAX_N) against qsort and std::sort, on random, sorted, reversed, few-unique (16
+ *   values) and organ-pipe input
+ * - queue: cArray enqueue and dequeue
+ * - bitset: setbit and readbit of cBitset and cBitset64, at sorted and random bit indices
+ * Every sort result is checked.
+ *
+ * Build: make -C benchmarks   (every benchmark, and the suite with std::sort, in benchmarks/build)
+ *        or without C++: cc -O2 -Iinclude benchmarks/suite.c -o suite
+ * Usage: ./suite [max_n] [group ...] > results.json
+ */
+
+#include "bench.h"
+#include "cArray.h"
+#include "cBitset.h"
+#include <stdlib.h>
+
+/* Minimum measured time of every case */
+#define MIN_TIME_NS 20000000ULL
+/* insert, delete, find and binsert cost O(n) per call, time this many calls */
+#define SLOW_OPS 1000
+#define LOOKUPS 65536
+/* insertion_sort is O(n^2), skip it beyond this size */
+#define INSERTION_MAX_N 32768
+
+CARRAY_GENERATE_PRIMITIVE(int)
+CARRAY_GENERATE_RADIX_PRIMITIVE(int)
+
+#ifdef BENCH_STD_SORT
+void bench_std_sort_int(int* data, size_t n);
+#endif
+
+enum
+{
+    DIST_RANDOM,
+    DIST_SORTED,
+    DIST_REVERSED,
+    DIST_FEW_UNIQUE,
+    DIST_ORGAN_PIPE,
+    DIST_COUNT
+};
+
+static const char* dist_names[DIST_COUNT] = {
+    "random", "sorted", "reversed", "few-unique", "organ-pipe"};
+
+enum
+{
+    SORT_PDQ,
+    SORT_TIM,
+    SORT_RADIX,
+    SORT_QUICK,
+    SORT_MERGE,
+    SORT_INSERTION,
+    SORT_QSORT,
+    SORT_STD,
+    SORT_COUNT
+};
+
+static const char* sort_names[SORT_COUNT] = {
+    "pdq_sort", "tim_sort", "radix_sort", "quick_sort", "merge_sort", "insertion_sort", "qsort",
+    "std::sort"};
+
+/* State shared by the setup and run functions of the current case */
+static struct
+{
+    int n;
+    int sort;
+    int* input;  /* n values of the current distribution */
+    int* sorted; /* input sorted */
+    int* keys;   /* LOOKUPS random values of input */
+    int* index;  /* LOOKUPS random indices */
+    int* work;   /* buffer of arr, n + SLOW_OPS elements */
+    int* scratch;
+    cArray_int arr;
+    uint8_t* bytes;
+    uint64_t* words;
+    cBitset bits;
+    cBitset64 bits64;
+} g;
+
+static bench_counters counters;
+static int num_results = 0;
+static int failures = 0;
+
+static void fill(int* buf, const int n, const int dist)
+{
+    uint64_t state = 42;
+    for (int i = 0; i < n; i++)
+    {
+        switch (dist)
+        {
+            case DIST_RANDOM:
+                buf[i] = (int) bench_rand(&state);
+                break;
+            case DIST_SORTED:
+                buf[i] = i;
+                break;
+            case DIST_REVERSED:
+                buf[i] = n - i;
+                break;
+            case DIST_FEW_UNIQUE:
+                buf[i] = (int) (bench_rand(&state) % 16);
+                break;
+            default:
+                buf[i] = (i < n / 2) ? i : n - i;
+                break;
+        }
+    }
+}
+
+static int int_qsort_cmp(const void* a, const void* b)
+{
+    const int x = *(const int*) a, y = *(const int*) b;
+    return (x > y) - (x < y);
+}
+
+/* Run one case and print its JSON result */
+static void measure(const char* group,
+                    const char* op,
+                    const char* dist,
+                    void (*setup)(void),
+                    uint64_t (*run)(void))
+{
+    setup();
+    run();
+    uint64_t elapsed = 0, ops = 0, cycles, misses;
+    int reps = 0;
+    bench_counters_reset(&counters);
+    while (elapsed < MIN_TIME_NS)
+    {
+        setup();
+        bench_counters_resume(&counters);
+        const uint64_t start = bench_now_ns();
+        ops += run();
+        elapsed += bench_now_ns() - start;
+        bench_counters_pause(&counters);
+        reps++;
+    }
+    bench_counters_read(&counters, &cycles, &misses);
+
+    printf("%s\n    {\"group\": \"%s\", \"op\": \"%s\", \"type\": \"int\", "
+           "\"distribution\": \"%s\", \"n\": %d, \"reps\": %d, \"ns_per_op\": %.3f, ",
+           num_results ? "," : "", group, op, dist, g.n, reps, (double) elapsed / (double) ops);
+    if (counters.available)
+        printf("\"cycles_per_op\": %.3f, \"cache_misses_per_op\": %.4f}",
+               (double) cycles / (double) ops, (double) misses / (double) ops);
+    else
+        printf("\"cycles_per_op\": null, \"cache_misses_per_op\": null}");
+    fflush(stdout);
+    fprintf(stderr, "%-8s %-18s %-12s n=%-9d %10.2f ns/op\n", group, op, dist, g.n,
+            (double) elapsed / (double) ops);
+    num_results++;
+}
+
+/* array */
+
+static void setup_empty(void)
+{
+    g.arr.size = 0;
+    g.arr.head = 0;
+}
+
+static void setup_input(void)
+{
+    memcpy(g.work, g.input, (size_t) g.n * sizeof(int));
+    g.arr.size = g.n;
+}
+
+static void setup_sorted(void)
+{
+    memcpy(g.work, g.sorted, (size_t) g.n * sizeof(int));
+    g.arr.size = g.n;
+}
+
+static void setup_none(void)
+{
+}
+
+static uint64_t run_push(void)
+{
+    for (int i = 0; i < g.n; i++)
+        cArray_int_push(&g.arr, &g.input[i]);
+    return (uint64_t) g.n;
+}
+
+static uint64_t run_insert(void)
+{
+    for (int i = 0; i < SLOW_OPS; i++)
+        cArray_int_insert(&g.arr, &g.keys[i], g.index[i] % (g.arr.size + 1));
+    return SLOW_OPS;
+}
+
+static uint64_t run_delete(void)
+{
+    const int ops = (g.n < SLOW_OPS) ? g.n : SLOW_OPS;
+    for (int i = 0; i < ops; i++)
+        cArray_int_delete(&g.arr, g.index[i] % g.arr.size);
+    return (uint64_t) ops;
+}
+
+static uint64_t run_find(void)
+{
+    uint64_t found = 0;
+    for (int i = 0; i < SLOW_OPS; i++)
+        found += (uint64_t) cArray_int_find(&g.arr, &g.keys[i]);
+    bench_sink = found;
+    return SLOW_OPS;
+}
+
+static uint64_t run_bsearch(void)
+{
+    uint64_t found = 0;
+    for (int i = 0; i < LOOKUPS; i++)
+        found += (uint64_t) cArray_int_bsearch(&g.arr, &g.keys[i]);
+    bench_sink = found;
+    return LOOKUPS;
+}
+
+static uint64_t run_binsert(void)
+{
+    for (int i = 0; i < SLOW_OPS; i++)
+        cArray_int_binsert(&g.arr, &g.keys[i]);
+    return SLOW_OPS;
+}
+
+/* sort */
+
+static uint64_t run_sort(void)
+{
+    const int n = g.n;
+    switch (g.sort)
+    {
+        case SORT_PDQ:
+            cArray_int_pdq_sort(&g.arr, 0, n - 1);
+            break;
+        case SORT_TIM:
+            cArray_int_tim_sort(&g.arr, 0, n - 1, g.scratch);
+            break;
+        case SORT_RADIX:
+            cArray_int_radix_sort(&g.arr, 0, n - 1, g.scratch);
+            break;
+        case SORT_QUICK:
+            cArray_int_quick_sort(&g.arr, 0, n - 1);
+            break;
+        case SORT_MERGE:
+            cArray_int_merge_sort(&g.arr, 0, n - 1);
+            break;
+        case SORT_INSERTION:
+            cArray_int_insertion_sort(&g.arr, 0, n - 1);
+            break;
+        case SORT_QSORT:
+            qsort(g.work, (size_t) n, sizeof(int), int_qsort_cmp);
+            break;
+        default:
+#ifdef BENCH_STD_SORT
+            bench_std_sort_int(g.work, (size_t) n);
+#endif
+            break;
+    }
+    return (uint64_t) n;
+}
+
+/* queue */
+
+static void setup_full_queue(void)
+{
+    setup_empty();
+    for (int i = 0; i < g.n; i++)
+        cArray_int_enqueue(&g.arr, &g.input[i]);
+}
+
+static uint64_t run_enqueue(void)
+{
+    for (int i = 0; i < g.n; i++)
+        cArray_int_enqueue(&g.arr, &g.input[i]);
+    return (uint64_t) g.n;
+}
+
+static uint64_t run_dequeue(void)
+{
+    uint64_t sum = 0;
+    int out;
+    while (cArray_int_dequeue(&g.arr, &out))
+        sum += (uint64_t) out;
+    bench_sink = sum;
+    return (uint64_t) g.n;
+}
+
+/* bitset, g.index holds the bit indices */
+
+static void setup_bits(void)
+{
+    cBitset_clear_all(&g.bits);
+    cBitset64_clear_all(&g.bits64);
+}
+
+static uint64_t run_setbit(void)
+{
+    for (int i = 0; i < g.n; i++)
+        cBitset_setbit(&g.bits, (size_t) g.index[i]);
+    return (uint64_t) g.n;
+}
+
+static uint64_t run_readbit(void)
+{
+    uint64_t count = 0;
+    for (int i = 0; i < g.n; i++)
+        count += cBitset_readbit(&g.bits, (size_t) g.index[i]);
+    bench_sink = count;
+    return (uint64_t) g.n;
+}
+
+static uint64_t run_setbit64(void)
+{
+    for (int i = 0; i < g.n; i++)
+        cBitset64_setbit(&g.bits64, (size_t) g.index[i]);
+    return (uint64_t) g.n;
+}
+
+static uint64_t run_readbit64(void)
+{
+    uint64_t count = 0;
+    for (int i = 0; i < g.n; i++)
+        count += cBitset64_readbit(&g.bits64, (size_t) g.index[i]);
+    bench_sink = count;
+    return (uint64_t) g.n;
+}
+
+static void fill_indices(const int count, const int n, const bool random)
+{
+    uint64_t state = 7;
+    for (int i = 0; i < count; i++)
+        g.index[i] = random ? (int) (bench_rand(&state) % (uint64_t) n) : (i % n);
+}
+
+static void run_size(const int n, const bool* groups)
+{
+    g.n = n;
+    cArray_int_init_from_buffer(&g.arr, g.work, n + SLOW_OPS);
+    const int lookups = (n > LOOKUPS) ? n : LOOKUPS;
+
+    if (groups[0])
+    {
+        fill(g.input, n, DIST_RANDOM);
+        memcpy(g.sorted, g.input, (size_t) n * sizeof(int));
+        qsort(g.sorted, (size_t) n, sizeof(int), int_qsort_cmp);
+        uint64_t state = 3;
+        for (int i = 0; i < LOOKUPS; i++)
+            g.keys[i] = g.input[bench_rand(&state) % (uint64_t) n];
+        fill_indices(lookups, n + SLOW_OPS, true);
+        measure("array", "push", "random", setup_empty, run_push);
+        measure("array", "insert", "random", setup_input, run_insert);
+        measure("array", "delete", "random", setup_input, run_delete);
+        measure("array", "find", "random", setup_input, run_find);
+        measure("array", "bsearch", "random", setup_sorted, run_bsearch);
+        measure("array", "binsert", "random", setup_sorted, run_binsert);
+    }
+
+    if (groups[1])
+    {
+        for (int dist = 0; dist < DIST_COUNT; dist++)
+        {
+            fill(g.input, n, dist);
+            memcpy(g.sorted, g.input, (size_t) n * sizeof(int));
+            qsort(g.sorted, (size_t) n, sizeof(int), int_qsort_cmp);
+            for (g.sort = 0; g.sort < SORT_COUNT; g.sort++)
+            {
+#ifndef BENCH_STD_SORT
+                if (g.sort == SORT_STD)
+                    continue;
+#endif
+                if ((g.sort == SORT_INSERTION) && (n > INSERTION_MAX_N))
+                    continue;
+                measure("sort", sort_names[g.sort], dist_names[dist], setup_input, run_sort);
+                if (memcmp(g.work, g.sorted, (size_t) n * sizeof(int)) != 0)
+                {
+                    fprintf(stderr, "%s did not sort %s input of %d elements\n",
+                            sort_names[g.sort], dist_names[dist], n);
+                    failures++;
+                }
+            }
+        }
+    }
+
+    if (groups[2])
+    {
+        fill(g.input, n, DIST_RANDOM);
+        cArray_int_init_from_buffer(&g.arr, g.work, n);
+        measure("queue", "enqueue", "random", setup_empty, run_enqueue);
+        measure("queue", "dequeue", "random", setup_full_queue, run_dequeue);
+    }
+
+    if (groups[3])
+    {
+        cBitset_init_from_buffer(&g.bits, g.bytes, (size_t) n);
+        cBitset64_init_from_buffer(&g.bits64, g.words, (size_t) n);
+        for (int random = 0; random < 2; random++)
+        {
+            const char* dist = random ? "random" : "sorted";
+            fill_indices(n, n, random);
+            measure("bitset", "cBitset_setbit", dist, setup_bits, run_setbit);
+            measure("bitset", "cBitset_readbit", dist, setup_none, run_readbit);
+            measure("bitset", "cBitset64_setbit", dist, setup_bits, run_setbit64);
+            measure("bitset", "cBitset64_readbit", dist, setup_none, run_readbit64);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    static const int sizes[] = {1000, 32768, 1048576};
+    static const char* group_names[4] = {"array", "sort", "queue", "bitset"};
+    const int max_n = (argc > 1) ? atoi(argv[1]) : 1048576;
+    bool groups[4] = {argc <= 2, argc <= 2, argc <= 2, argc <= 2};
+    for (int a = 2; a < argc; a++)
+    {
+        for (int i = 0; i < 4; i++)
+            groups[i] |= (strcmp(argv[a], group_names[i]) == 0);
+    }
+    if (max_n < 1)
+        return 1;
+
+    /* max_n itself is always run, sizes above it are not */
+    const size_t cap = (size_t) max_n + SLOW_OPS;
+    const size_t lookups = (cap > LOOKUPS) ? cap : LOOKUPS;
+    g.input = malloc(cap * sizeof(int));
+    g.sorted = malloc(cap * sizeof(int));
+    g.keys = malloc(LOOKUPS * sizeof(int));
+    g.index = malloc(lookups * sizeof(int));
+    g.work = malloc(cap * sizeof(int));
+    g.scratch = malloc(cap * sizeof(int));
+    g.bytes = malloc(CBITSET_SIZE(cap));
+    g.words = malloc(CBITSET64_WORDS(cap) * sizeof(uint64_t));
+    if (! g.input || ! g.sorted || ! g.keys || ! g.index || ! g.work || ! g.scratch || ! g.bytes ||
+        ! g.words)
+        return 1;
+
+    bench_counters_open(&counters);
+    printf("{\n  \"suite\": \"cstl\",\n  \"compiler\": \"%s\",\n  \"perf_counters\": %s,\n"
+           "  \"results\": [",
+#ifdef __VERSION__
+           __VERSION__,
+#else
+           "unknown",
+#endif
+           counters.available ? "true" : "false");
+    for (int i = 0; i < 3; i++)
+    {
+        if (sizes[i] < max_n)
+            run_size(sizes[i], groups);
+    }
+    run_size(max_n, groups);
+    printf("\n  ]\n}\n");
+    bench_counters_close(&counters);
+
+    free(g.input);
+    free(g.sorted);
+    free(g.keys);
+    free(g.index);
+    free(g.work);
+    free(g.scratch);
+    free(g.bytes);
+    free(g.words);
+    if (failures)
+        fprintf(stderr, "%d wrong results\n", failures);
+    return failures ? 1 : 0;
+}
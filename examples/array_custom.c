@@ -62,7 +62,7 @@ int main(void)
     printf("---- After delete at index 2 ----\n");
     cArray_MyStruct_print(&arr);
 
-    /* Sort array (bubble sort) */
+    /* Sort array (pdqsort) */
     cArray_MyStruct_sort(&arr);
     printf("---- After sort (by id) ----\n");
     cArray_MyStruct_print(&arr);
@@ -0,0 +1,59 @@
+#include "cBitset.h"
+#include <stdio.h>
+
+#define NUM_BITS 200
+
+static void print_set_bits(const cBitset64* bitset)
+{
+    size_t i;
+    printf("{ ");
+    CBITSET64_FOREACH(bitset, i)
+    {
+        printf("%zu ", i);
+    }
+    printf("}\n");
+}
+
+int main(void)
+{
+    CBITSET64_CREATE(slots, NUM_BITS)
+
+    // set a range of bits
+    printf("---- Set range 60..70 ----\n");
+    cBitset64_set_range(&slots, 60, 70);
+    print_set_bits(&slots);
+    printf("count: %zu\n\n", cBitset64_count(&slots));
+
+    // clear part of the range
+    printf("---- Clear range 62..68 ----\n");
+    cBitset64_clear_range(&slots, 62, 68);
+    print_set_bits(&slots);
+    printf("\n");
+
+    // single bits
+    printf("---- Set bit 3 and 199 ----\n");
+    cBitset64_setbit(&slots, 3);
+    cBitset64_setbit(&slots, 199);
+    print_set_bits(&slots);
+    printf("\n");
+
+    // find
+    printf("---- Find ----\n");
+    printf("first set: %zu\n", cBitset64_find_first_set(&slots));
+    printf("next set from 4: %zu\n", cBitset64_find_next(&slots, 4));
+    printf("first zero: %zu\n", cBitset64_find_first_zero(&slots));
+    printf("\n");
+
+    // claim free slots
+    printf("---- Set all, then find zero ----\n");
+    cBitset64_set_all(&slots);
+    cBitset64_clearbit(&slots, 150);
+    printf("count: %zu, first zero: %zu\n",
+           cBitset64_count(&slots),
+           cBitset64_find_first_zero(&slots));
+    cBitset64_setbit(&slots, 150);
+    size_t none = cBitset64_find_first_zero(&slots);
+    printf("full: %s\n", (none == CBITSET_NPOS) ? "true" : "false");
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "cBTree.h"
+#include <stdio.h>
+
+static inline int int_cmp(const int* a, const int* b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+CBTREE_GENERATE(int, float, int_cmp)
+
+static void print_tree(cBTree_int_float* tree)
+{
+    const int* key;
+    float* value;
+    printf("{ ");
+    CBTREE_FOREACH(int, float, tree, key, value)
+    {
+        printf("%d: %.1f ", *key, *value);
+    }
+    printf("} size: %zu, height: %d\n", tree->size, tree->height);
+}
+
+int main(void)
+{
+    CBTREE_CREATE(prices, int, float, CBTREE_NODES(int, 64))
+
+    // insert in any order, iteration is always sorted
+    printf("---- Insert 40 prices ----\n");
+    for (int i = 0; i < 40; i++)
+    {
+        const int id = (i * 17) % 40;
+        const float price = (float) id * 10;
+        cBTree_int_float_insert(&prices, &id, &price);
+    }
+    print_tree(&prices);
+    printf("\n");
+
+    // lookup
+    printf("---- Find ----\n");
+    int id = 12;
+    float* price = cBTree_int_float_find(&prices, &id);
+    printf("price of %d: %.1f\n\n", id, price ? *price : -1.0f);
+
+    // erase every even id
+    printf("---- Erase even ids ----\n");
+    for (id = 0; id < 40; id += 2)
+        cBTree_int_float_erase(&prices, &id);
+    print_tree(&prices);
+    printf("\n");
+
+    // range scan from the first id >= 20
+    printf("---- Ids from 20 to 30 ----\n");
+    id = 20;
+    cBTree_int_float_iter it = cBTree_int_float_lower_bound(&prices, &id);
+    const int* key;
+    while (cBTree_int_float_next(&it, &key, NULL) && (*key <= 30))
+        printf("%d ", *key);
+    printf("\n");
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "cHashMap.h"
+#include <stdio.h>
+
+CHASH_PRIMITIVE(int)
+CHASHMAP_GENERATE(int, float, int_hash, int_eq)
+CHASHSET_GENERATE(int, int_hash, int_eq)
+
+static void print_map(cHashMap_int_float* map)
+{
+    cHashMap_int_float_entry* entry;
+    printf("{ ");
+    CHASHMAP_FOREACH(int, float, map, entry)
+    {
+        printf("%d: %.1f ", entry->key, entry->value);
+    }
+    printf("} size: %zu\n", map->size);
+}
+
+int main(void)
+{
+    CHASHMAP_CREATE(prices, int, float, 16)
+
+    // insert, and overwrite an existing key
+    printf("---- Insert 3 prices ----\n");
+    for (int id = 1; id <= 3; id++)
+    {
+        const float price = (float) id * 10;
+        cHashMap_int_float_insert(&prices, &id, &price);
+    }
+    int id = 2;
+    const float discounted = 15.0f;
+    cHashMap_int_float_insert(&prices, &id, &discounted);
+    print_map(&prices);
+    printf("\n");
+
+    // lookup
+    printf("---- Find ----\n");
+    float* price = cHashMap_int_float_find(&prices, &id);
+    printf("price of %d: %.1f\n", id, price ? *price : -1.0f);
+    id = 7;
+    printf("7 present? %s\n\n", cHashMap_int_float_find(&prices, &id) ? "true" : "false");
+
+    // erase
+    printf("---- Erase 1 ----\n");
+    id = 1;
+    cHashMap_int_float_erase(&prices, &id);
+    print_map(&prices);
+    printf("\n");
+
+    // a set only stores keys
+    printf("---- Set ----\n");
+    CHASHSET_CREATE(seen, int, 16)
+    const int values[] = {4, 8, 4, 15, 8, 4};
+    for (int i = 0; i < 6; i++)
+        cHashSet_int_insert(&seen, &values[i]);
+    printf("unique values: %zu\n", seen.size);
+    return 0;
+}
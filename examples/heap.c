@@ -0,0 +1,82 @@
+#include "cHeap.h"
+#include <stdio.h>
+
+typedef struct
+{
+    int deadline;
+    int id;
+} Task;
+
+static inline void Task_cpy(Task* dest, const Task* src)
+{
+    *dest = *src;
+}
+
+/* earliest deadline first */
+static inline int Task_cmp(const Task* a, const Task* b)
+{
+    return (a->deadline > b->deadline) - (a->deadline < b->deadline);
+}
+
+static inline void int_cpy(int* dest, const int* src)
+{
+    *dest = *src;
+}
+
+static inline int int_cmp(const int* a, const int* b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+CHEAP_GENERATE(Task, Task_cpy, Task_cmp)
+CHEAP_GENERATE(int, int_cpy, int_cmp)
+CINDEXED_HEAP_GENERATE(int, int_cpy, int_cmp)
+
+int main(void)
+{
+    CHEAP_CREATE(tasks, Task, 8)
+
+    // tasks come out by deadline, whatever the push order
+    printf("---- Push 5 tasks ----\n");
+    const int deadlines[] = {30, 10, 50, 20, 40};
+    for (int i = 0; i < 5; i++)
+    {
+        const Task t = {deadlines[i], i};
+        cHeap_Task_push(&tasks, &t);
+    }
+    Task t;
+    if (cHeap_Task_peek(&tasks, &t))
+        printf("next: task %d (deadline %d)\n", t.id, t.deadline);
+    while (cHeap_Task_pop(&tasks, &t))
+        printf("task %d (deadline %d)\n", t.id, t.deadline);
+    printf("\n");
+
+    // heap sort an existing buffer
+    printf("---- Heap sort ----\n");
+    int values[] = {5, 3, 9, 1, 7, 2};
+    cHeap_int heap;
+    cHeap_int_init_from_array(&heap, values, 6, 6);
+    cHeap_int_sort(&heap);
+    for (int i = 0; i < 6; i++)
+        printf("%d ", values[i]);
+    printf("\n\n");
+
+    // timers by id, rescheduled in place
+    printf("---- Timers ----\n");
+    CINDEXED_HEAP_CREATE(timers, int, 4)
+    for (int id = 0; id < 4; id++)
+    {
+        const int expiry = 100 * (id + 1);
+        cIndexedHeap_int_push(&timers, id, &expiry);
+    }
+    int expiry = 50;
+    cIndexedHeap_int_decrease_key(&timers, 3, &expiry); // timer 3 now expires first
+    expiry = 500;
+    cIndexedHeap_int_increase_key(&timers, 0, &expiry); // timer 0 now expires last
+    cIndexedHeap_int_erase(&timers, 1);                 // cancel timer 1
+    int id;
+    while (cIndexedHeap_int_pop(&timers, &id, &expiry))
+        printf("timer %d expires at %d\n", id, expiry);
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "cPool.h"
+#include <stdio.h>
+
+typedef struct
+{
+    int id;
+    int priority;
+} Request;
+
+CPOOL_GENERATE(Request)
+
+static void print_pool(cPool_Request* pool)
+{
+    Request* req;
+    printf("[ ");
+    CPOOL_FOREACH(Request, pool, req)
+    {
+        printf("{id: %d, slot: %d} ", req->id, cPool_Request_index(pool, req));
+    }
+    printf("] size: %d\n", pool->size);
+}
+
+int main(void)
+{
+    CPOOL_CREATE(pool, Request, 4)
+
+    // allocate objects
+    printf("---- Alloc 3 requests ----\n");
+    Request* a = cPool_Request_alloc(&pool);
+    a->id = 1;
+    Request* b = cPool_Request_alloc(&pool);
+    b->id = 2;
+    Request* c = cPool_Request_alloc(&pool);
+    c->id = 3;
+    print_pool(&pool);
+    printf("\n");
+
+    // free an object in the middle, no other object moves
+    printf("---- Free request 2 ----\n");
+    cPool_Request_free(&pool, b);
+    print_pool(&pool);
+    printf("double free rejected? %s\n\n", cPool_Request_free(&pool, b) ? "false" : "true");
+
+    // the freed slot is reused first
+    printf("---- Alloc 2 more requests ----\n");
+    Request* d = cPool_Request_alloc(&pool);
+    d->id = 4;
+    Request* e = cPool_Request_alloc(&pool);
+    e->id = 5;
+    print_pool(&pool);
+    printf("\n");
+
+    // pool is full
+    printf("---- Alloc when full ----\n");
+    Request* f = cPool_Request_alloc(&pool);
+    printf("alloc returned %s\n", f ? "a slot" : "NULL");
+
+    return 0;
+}
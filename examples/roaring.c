@@ -0,0 +1,63 @@
+#include "cRoaring.h"
+#include <stdio.h>
+
+#define MAX_CHUNKS 16
+#define DATA_WORDS 4096
+
+static void print_roaring(const cRoaring* r)
+{
+    uint32_t v;
+    int printed = 0;
+    printf("{ ");
+    CROARING_FOREACH(r, v)
+    {
+        if (printed++ == 10)
+        {
+            printf("... ");
+            break;
+        }
+        printf("%u ", v);
+    }
+    printf("} count: %llu, chunks: %d\n", (unsigned long long) cRoaring_count(r), r->num_chunks);
+}
+
+int main(void)
+{
+    CROARING_CREATE(ids, MAX_CHUNKS, DATA_WORDS)
+    CROARING_CREATE(other, MAX_CHUNKS, DATA_WORDS)
+    CROARING_CREATE(result, MAX_CHUNKS, DATA_WORDS)
+
+    // sparse ids across the whole 32-bit universe
+    printf("---- Set sparse bits ----\n");
+    cRoaring_setbit(&ids, 7);
+    cRoaring_setbit(&ids, 100000);
+    cRoaring_setbit(&ids, 4000000000U);
+    print_roaring(&ids);
+    printf("read 100000: %d, read 100001: %d\n\n",
+           cRoaring_readbit(&ids, 100000),
+           cRoaring_readbit(&ids, 100001));
+
+    // a clustered range is stored as a single run
+    printf("---- Set range 200000..299999 ----\n");
+    cRoaring_set_range(&ids, 200000, 299999);
+    print_roaring(&ids);
+    printf("\n");
+
+    // clear a bit
+    printf("---- Clear bit 7 ----\n");
+    cRoaring_clearbit(&ids, 7);
+    print_roaring(&ids);
+    printf("\n");
+
+    // set algebra
+    printf("---- Intersection and union ----\n");
+    cRoaring_set_range(&other, 250000, 250009);
+    cRoaring_setbit(&other, 42);
+    cRoaring_and(&result, &ids, &other);
+    print_roaring(&result);
+    cRoaring_or(&result, &ids, &other);
+    print_roaring(&result);
+    printf("and_count: %llu\n", (unsigned long long) cRoaring_and_count(&ids, &other));
+
+    return 0;
+}
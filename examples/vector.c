@@ -0,0 +1,59 @@
+#include "cVector.h"
+#include <stdio.h>
+
+static inline void int_cpy(int* dest, const int* src)
+{
+    *dest = *src;
+}
+
+CVECTOR_GENERATE(int, int_cpy)
+
+static void print_vector(const cVector_int* vec)
+{
+    int* x;
+    printf("[ ");
+    CVECTOR_FOREACH(vec, x)
+    {
+        printf("%d ", *x);
+    }
+    printf("] size: %zu, capacity: %zu\n", vec->size, vec->capacity);
+}
+
+int main(void)
+{
+    // on the C heap, the vector grows as needed
+    printf("---- Push 20 elements ----\n");
+    cVector_int vec;
+    cVector_int_init(&vec, cAllocator_heap());
+    for (int i = 0; i < 20; i++)
+        cVector_int_push(&vec, &i);
+    print_vector(&vec);
+    printf("\n");
+
+    printf("---- Shrink to fit ----\n");
+    cVector_int_shrink_to_fit(&vec);
+    print_vector(&vec);
+    cVector_int_free(&vec);
+    printf("\n");
+
+    // temporary vectors in an arena, freed all at once
+    printf("---- Arena ----\n");
+    static unsigned char scratch[4096];
+    cArena arena;
+    cArena_init_from_buffer(&arena, scratch, sizeof(scratch));
+    for (int batch = 1; batch <= 3; batch++)
+    {
+        cVector_int squares;
+        cVector_int_init(&squares, cArena_allocator(&arena));
+        for (int i = 1; i <= batch * 3; i++)
+        {
+            const int square = i * i;
+            cVector_int_push(&squares, &square);
+        }
+        print_vector(&squares);
+        printf("arena used: %zu bytes\n", arena.used);
+        cArena_reset(&arena);
+    }
+
+    return 0;
+}
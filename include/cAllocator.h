@@ -0,0 +1,359 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * cAllocator - a pluggable allocator interface for the growable containers, with three
+ * implementations:
+ * - the C heap (malloc / realloc / free),
+ * - cArena, a bump allocator over a user buffer: an allocation is a pointer increment and every
+ *   allocation is freed at once by a reset (or back to a mark), so a batch of temporary arrays
+ *   costs no free at all,
+ * - huge pages: blocks of CALLOC_HUGE_PAGE bytes and more are mapped with mmap and backed by 2 MB
+ *   pages (explicit huge pages if the system has some reserved, transparent ones otherwise),
+ *   which cuts TLB misses on very large arrays. Linux mremap grows them without copying.
+ */
+
+#pragma once
+
+#ifndef CSTL_ALLOCATOR_H
+#define CSTL_ALLOCATOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined(__unix__) || defined(__APPLE__)) && ! defined(CSTL_NO_MMAP)
+#include <sys/mman.h>
+#endif
+
+#ifndef CSTL_ALIGNOF
+#ifdef __cplusplus
+#define CSTL_ALIGNOF(T) alignof(T)
+#else
+#define CSTL_ALIGNOF(T) _Alignof(T)
+#endif
+#endif
+
+/* mmap needs anonymous mappings, which strict ISO modes (e.g. -std=c11 without _DEFAULT_SOURCE
+ * or _GNU_SOURCE) hide. Without them the huge page allocator is the heap allocator */
+#if defined(MAP_ANONYMOUS) || defined(MAP_ANON)
+#define CALLOC_HAVE_MMAP 1
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#else
+#define CALLOC_HAVE_MMAP 0
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Blocks of at least this many bytes are mapped by the huge page allocator */
+#ifndef CALLOC_HUGE_PAGE
+#define CALLOC_HUGE_PAGE ((size_t) 2 << 20)
+#endif
+
+/*
+ * Something that hands out memory. alloc returns a block of size bytes aligned to align (a power
+ * of two) or NULL. resize returns a block of new_size bytes holding the first
+ * min(old_size, new_size) bytes of ptr (which is then invalid), or NULL and leaves ptr
+ * untouched. release frees ptr. The sizes passed back are those of the alloc / resize call, so
+ * allocators do not need to store them. Plug your own in with any context, e.g. a thread-local
+ * pool.
+ */
+typedef struct
+{
+    void* (*alloc)(void* context, size_t size, size_t align);
+    void* (*resize)(void* context, void* ptr, size_t old_size, size_t new_size, size_t align);
+    void (*release)(void* context, void* ptr, size_t size);
+    void* context; // passed back to every call, e.g. the arena
+} cAllocator;
+
+/* Round size up to a multiple of align (a power of two), 0 if that overflows */
+static inline size_t cAllocator_round_up(const size_t size, const size_t align)
+{
+    const size_t rounded = (size + align - 1) & ~(align - 1);
+    return (rounded < size) ? 0 : rounded;
+}
+
+/* ---- C heap ---- */
+
+/* malloc only guarantees alignment for the standard types, stricter alignments use
+ * aligned_alloc */
+#define CALLOC_MALLOC_ALIGN (2 * sizeof(void*))
+
+static inline void* cAllocator_heap_alloc(void* context, const size_t size, const size_t align)
+{
+    (void) context;
+    if (align <= CALLOC_MALLOC_ALIGN)
+        return malloc(size ? size : 1);
+    const size_t rounded = cAllocator_round_up(size ? size : 1, align);
+    return rounded ? aligned_alloc(align, rounded) : NULL;
+}
+
+static inline void cAllocator_heap_release(void* context, void* ptr, const size_t size)
+{
+    (void) context;
+    (void) size;
+    free(ptr);
+}
+
+static inline void* cAllocator_heap_resize(
+    void* context, void* ptr, const size_t old_size, const size_t new_size, const size_t align)
+{
+    if (align <= CALLOC_MALLOC_ALIGN)
+        return realloc(ptr, new_size ? new_size : 1);
+    /* realloc would drop the alignment */
+    void* block = cAllocator_heap_alloc(context, new_size, align);
+    if (block)
+    {
+        memcpy(block, ptr, (old_size < new_size) ? old_size : new_size);
+        free(ptr);
+    }
+    return block;
+}
+
+/* Allocator using malloc, realloc and free */
+static inline cAllocator cAllocator_heap(void)
+{
+    cAllocator allocator;
+    allocator.alloc = cAllocator_heap_alloc;
+    allocator.resize = cAllocator_heap_resize;
+    allocator.release = cAllocator_heap_release;
+    allocator.context = NULL;
+    return allocator;
+}
+
+/* ---- Arena ---- */
+
+typedef struct
+{
+    unsigned char* buffer; // pointer to user-provided memory
+    size_t capacity;       // bytes of buffer
+    size_t used;           // bytes handed out, the next block starts here (after alignment)
+    size_t last;           // offset of the last block, which can grow or shrink in place
+} cArena;
+
+/* Initialize an empty arena with your buffer of capacity bytes */
+static inline void cArena_init_from_buffer(cArena* arena, void* buffer, const size_t capacity)
+{
+    arena->buffer = (unsigned char*) buffer;
+    arena->capacity = capacity;
+    arena->used = 0;
+    arena->last = 0;
+}
+
+/* Block of size bytes aligned to align (a power of two), or NULL if the arena is full. O(1) */
+static inline void* cArena_alloc(cArena* arena, const size_t size, const size_t align)
+{
+    const uintptr_t base = (uintptr_t) arena->buffer;
+    const size_t start = (size_t) (cAllocator_round_up(base + arena->used, align) - base);
+    if ((start < arena->used) || (start > arena->capacity) || (size > arena->capacity - start))
+        return NULL;
+    arena->last = start;
+    arena->used = start + size;
+    return arena->buffer + start;
+}
+
+/* Resize a block of the arena. The last block grows or shrinks in place, any other one is copied
+ * to a new block (its old bytes are only reclaimed by a reset). NULL if the arena is full */
+static inline void* cArena_resize(
+    cArena* arena, void* ptr, const size_t old_size, const size_t new_size, const size_t align)
+{
+    if (ptr && ((unsigned char*) ptr == arena->buffer + arena->last)
+        && (arena->last + old_size == arena->used))
+    {
+        if (new_size > arena->capacity - arena->last)
+            return NULL;
+        arena->used = arena->last + new_size;
+        return ptr;
+    }
+    void* block = cArena_alloc(arena, new_size, align);
+    if (block && ptr)
+        memcpy(block, ptr, (old_size < new_size) ? old_size : new_size);
+    return block;
+}
+
+/* Free a block. Only the last block is given back, the others wait for a reset */
+static inline void cArena_release(cArena* arena, void* ptr, const size_t size)
+{
+    if (ptr && ((unsigned char*) ptr == arena->buffer + arena->last)
+        && (arena->last + size == arena->used))
+        arena->used = arena->last;
+}
+
+/* Free every block at once. O(1) */
+static inline void cArena_reset(cArena* arena)
+{
+    arena->used = 0;
+    arena->last = 0;
+}
+
+/* Current fill of the arena, cArena_rewind(arena, mark) later frees every block allocated since */
+static inline size_t cArena_mark(const cArena* arena)
+{
+    return arena->used;
+}
+
+/* Free every block allocated since mark was taken. O(1) */
+static inline void cArena_rewind(cArena* arena, const size_t mark)
+{
+    if (mark <= arena->used)
+    {
+        arena->used = mark;
+        arena->last = mark;
+    }
+}
+
+static inline void* cArena_alloc_fn(void* context, const size_t size, const size_t align)
+{
+    return cArena_alloc((cArena*) context, size, align);
+}
+
+static inline void* cArena_resize_fn(
+    void* context, void* ptr, const size_t old_size, const size_t new_size, const size_t align)
+{
+    return cArena_resize((cArena*) context, ptr, old_size, new_size, align);
+}
+
+static inline void cArena_release_fn(void* context, void* ptr, const size_t size)
+{
+    cArena_release((cArena*) context, ptr, size);
+}
+
+/* Allocator handing out blocks of arena, which must outlive every container using it */
+static inline cAllocator cArena_allocator(cArena* arena)
+{
+    cAllocator allocator;
+    allocator.alloc = cArena_alloc_fn;
+    allocator.resize = cArena_resize_fn;
+    allocator.release = cArena_release_fn;
+    allocator.context = arena;
+    return allocator;
+}
+
+/* ---- Huge pages ---- */
+
+#if CALLOC_HAVE_MMAP
+
+/* Map size bytes (a multiple of CALLOC_HUGE_PAGE), NULL on failure */
+static inline void* cAllocator_huge_map(const size_t size)
+{
+    void* block = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    /* explicit huge pages, only if the system has some reserved (vm.nr_hugepages) */
+    block = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1,
+                 0);
+#endif
+    if (block == MAP_FAILED)
+    {
+        block = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (block == MAP_FAILED)
+            return NULL;
+#ifdef MADV_HUGEPAGE
+        /* ask for transparent huge pages */
+        madvise(block, size, MADV_HUGEPAGE);
+#endif
+    }
+    return block;
+}
+
+static inline void* cAllocator_huge_alloc(void* context, const size_t size, const size_t align)
+{
+    if (size < CALLOC_HUGE_PAGE)
+        return cAllocator_heap_alloc(context, size, align);
+    const size_t mapped = cAllocator_round_up(size, CALLOC_HUGE_PAGE);
+    return mapped ? cAllocator_huge_map(mapped) : NULL;
+}
+
+static inline void cAllocator_huge_release(void* context, void* ptr, const size_t size)
+{
+    if (size < CALLOC_HUGE_PAGE)
+        cAllocator_heap_release(context, ptr, size);
+    else if (ptr)
+        munmap(ptr, cAllocator_round_up(size, CALLOC_HUGE_PAGE));
+}
+
+static inline void* cAllocator_huge_resize(
+    void* context, void* ptr, const size_t old_size, const size_t new_size, const size_t align)
+{
+    if ((old_size < CALLOC_HUGE_PAGE) && (new_size < CALLOC_HUGE_PAGE))
+        return cAllocator_heap_resize(context, ptr, old_size, new_size, align);
+    if ((old_size >= CALLOC_HUGE_PAGE) && (new_size >= CALLOC_HUGE_PAGE))
+    {
+        const size_t old_mapped = cAllocator_round_up(old_size, CALLOC_HUGE_PAGE);
+        const size_t new_mapped = cAllocator_round_up(new_size, CALLOC_HUGE_PAGE);
+        if (! new_mapped)
+            return NULL;
+        if (new_mapped == old_mapped)
+            return ptr;
+#ifdef MREMAP_MAYMOVE
+        /* moves the page table entries, no copy */
+        void* moved = mremap(ptr, old_mapped, new_mapped, MREMAP_MAYMOVE);
+        if (moved != MAP_FAILED)
+            return moved;
+#endif
+    }
+    void* block = cAllocator_huge_alloc(context, new_size, align);
+    if (block)
+    {
+        memcpy(block, ptr, (old_size < new_size) ? old_size : new_size);
+        cAllocator_huge_release(context, ptr, old_size);
+    }
+    return block;
+}
+
+/* Allocator mapping blocks of CALLOC_HUGE_PAGE bytes and more on huge pages, smaller blocks come
+ * from the C heap */
+static inline cAllocator cAllocator_huge_pages(void)
+{
+    cAllocator allocator;
+    allocator.alloc = cAllocator_huge_alloc;
+    allocator.resize = cAllocator_huge_resize;
+    allocator.release = cAllocator_huge_release;
+    allocator.context = NULL;
+    return allocator;
+}
+
+#else
+
+/* No mmap on this platform (or in this compilation mode), use the C heap */
+static inline cAllocator cAllocator_huge_pages(void)
+{
+    return cAllocator_heap();
+}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_ALLOCATOR_H
@@ -30,25 +30,122 @@
 #define CSTL_ARRAY_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "cSimd.h"
+#include "cStats.h"
+
+#ifdef __cplusplus
+#include <type_traits>
+#endif
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+/* pdqsort tuning: partitions smaller than this are insertion sorted */
+#define CARRAY_PDQ_INSERTION_THRESHOLD 24
+/* Partitions larger than this pick the pivot with a ninther instead of a median of 3 */
+#define CARRAY_PDQ_NINTHER_THRESHOLD 128
+/* Max elements moved by the optimistic insertion sort before it gives up */
+#define CARRAY_PDQ_PARTIAL_LIMIT 8
+/* Elements classified per block by the branchless partition (at most 255) */
+#define CARRAY_PDQ_BLOCK 64
+
+/* TimSort tuning: initial number of consecutive wins before a merge switches to galloping */
+#define CARRAY_TIM_MIN_GALLOP 7
+/* Max pending runs, enough for any int sized range */
+#define CARRAY_TIM_MAX_RUNS 40
+/* Elements of scratch needed by tim_sort for a range of n elements */
+#define CARRAY_TIM_SCRATCH(n) (((n) / 2) + 1)
+
+/* Default bits per radix sort pass: 8 keeps the histograms in L1, 11 needs one pass less for
+ * 32-bit keys (3 instead of 4) */
+#ifndef CARRAY_RADIX_DIGIT_BITS
+#define CARRAY_RADIX_DIGIT_BITS 8
+#endif
+
+/* Hint the CPU to start loading the cache line of address p */
+#if defined(__GNUC__) || defined(__clang__)
+#define CARRAY_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define CARRAY_PREFETCH(p) ((void) 0)
+#endif
+
+/* partial_sort / top_k keep a bounded heap for k up to n >> CARRAY_PARTIAL_HEAP_SHIFT (n / 256,
+ * about where the heap stops being faster on random input), and select then sort beyond */
+#define CARRAY_PARTIAL_HEAP_SHIFT 8
+
+/* nth_element partitions at most this many times n elements with quickselect pivots before it
+ * switches to median of medians pivots (random input needs about 2.5) */
+#define CARRAY_SELECT_WORK 4
+
+/* Elements checked per block by any_of / all_of before testing for an early exit */
+#define CARRAY_SCAN_BLOCK 64
+
+/* FLAGS of CARRAY_GENERATE_EX, describing what T is beyond CPY and CMP */
+#define CARRAY_INTEGER 1 /* integer or pointer: CMP(a, b) == 0 iff a and b have the same bits */
+#define CARRAY_FLOAT 2   /* float or double compared like CARRAY_PRIMITIVE_CMP */
+#define CARRAY_TRIVIAL 4 /* CPY is a plain assignment, so copies can use memmove */
+
+/* With CARRAY_INTEGER or CARRAY_FLOAT: CMP orders T like <, so minmax can use the cSimd kernels */
+#define CARRAY_NATURAL_ORDER 8
+
+/* CARRAY_INTEGER or CARRAY_FLOAT for a primitive type T. Before C11 (no _Generic) it is 0, so the
+ * primitive arrays use CMP instead of the cSimd kernels */
+#ifdef __cplusplus
+#define CARRAY_KIND(T) (std::is_floating_point<T>::value ? CARRAY_FLOAT : CARRAY_INTEGER)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define CARRAY_KIND(T)                                                                             \
+    _Generic((T) 0, float: CARRAY_FLOAT, double: CARRAY_FLOAT, long double: CARRAY_FLOAT,          \
+             default: CARRAY_INTEGER)
+#else
+#define CARRAY_KIND(T) 0
+#endif
+
+/* cSimd_elem of a T described by FLAGS, or -1 if the search kernels cannot handle it */
+#define CARRAY_SIMD_ELEM(T, FLAGS)                                                                 \
+    (((FLAGS) & CARRAY_FLOAT)                                                                      \
+         ? ((sizeof(T) == 4) ? (int) CSIMD_FLOAT : (sizeof(T) == 8) ? (int) CSIMD_DOUBLE : -1)     \
+     : ((FLAGS) & CARRAY_INTEGER)                                                                  \
+         ? ((sizeof(T) == 1)   ? (int) CSIMD_INT8                                                  \
+            : (sizeof(T) == 2) ? (int) CSIMD_INT16                                                 \
+            : (sizeof(T) == 4) ? (int) CSIMD_INT32                                                 \
+            : (sizeof(T) == 8) ? (int) CSIMD_INT64                                                 \
+                               : -1)                                                               \
+         : -1)
+
+/* Whether the integer or pointer type T orders like an unsigned integer, for the minmax kernels.
+ * Always false before C11, where CARRAY_KIND never selects those kernels */
+#ifdef __cplusplus
+#define CARRAY_UNSIGNED(T) (! std::is_signed<T>::value)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define CARRAY_UNSIGNED(T)                                                                         \
+    _Generic((T*) 0, signed char*: false, short*: false, int*: false, long*: false,                \
+             long long*: false, char*: ((char) -1 < 0) ? false : true, default: true)
+#else
+#define CARRAY_UNSIGNED(T) false
+#endif
+
 /**
- * Generate the cArray for type T and its associated functions
+ * Generate the cArray for type T and its associated functions, through CARRAY_GENERATE_EX below
  * @param T type of the array
  * @param CPY of signature void T_cpy(T* dest, const T* src)
  * @param CMP of signature int T_cmp(const T* a, const T* b)
+ * @param FLAGS CARRAY_INTEGER or CARRAY_FLOAT if T is such a primitive type (linear searches then
+ * use the cSimd kernels instead of CMP), or-ed with CARRAY_NATURAL_ORDER if CMP also orders T like
+ * < does (minmax then uses the cSimd kernels too) and with CARRAY_TRIVIAL if T can be copied with
+ * memcpy (shifts and bulk copies then skip CPY), 0 otherwise
  *
  * @note CMP should return an integer such that:
  * @note CMP(&a, &b) = 0 => a == b
  * @note CMP(&a, &b) < 0 => a < b
  * @note CMP(&a, &b) > 0 => a > b
  */
-#define CARRAY_GENERATE(T, CPY, CMP)                                                               \
+#define CARRAY_GENERATE_BODY(T, CPY, CMP, FLAGS)                                                   \
     typedef struct                                                                                 \
     {                                                                                              \
         T* array;                                                                                  \
@@ -67,12 +164,36 @@ extern "C"
         vector->head = 0;                                                                          \
     }                                                                                              \
                                                                                                    \
+    /* Copy n elements from src to dst, the ranges may overlap. One memmove if CARRAY_TRIVIAL */   \
+    static inline void cArray_##T##_move_n(T* dst, const T* src, const int n)                      \
+    {                                                                                              \
+        if ((n <= 0) || (dst == src))                                                              \
+            return;                                                                                \
+        CSTATS_ADD(cArray_##T##_stats_data, shifts, n);                                            \
+        if ((FLAGS) & CARRAY_TRIVIAL)                                                              \
+        {                                                                                          \
+            memmove(dst, src, (size_t) n * sizeof(T));                                             \
+        }                                                                                          \
+        else if ((uintptr_t) dst < (uintptr_t) src)                                                \
+        {                                                                                          \
+            for (int i = 0; i < n; i++)                                                            \
+                CPY(&dst[i], &src[i]);                                                             \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            for (int i = n - 1; i >= 0; i--)                                                       \
+                CPY(&dst[i], &src[i]);                                                             \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
     static inline bool cArray_##T##_push(cArray_##T* vector, const T* element)                     \
     {                                                                                              \
+        CSTATS_ADD(cArray_##T##_stats_data, failed_pushes, vector->size >= vector->capacity);      \
         if (vector->size >= vector->capacity)                                                      \
             return false;                                                                          \
         CPY(&vector->array[vector->size], element);                                                \
         vector->size++;                                                                            \
+        CSTATS_MAX(cArray_##T##_stats_data, high_water, vector->size);                             \
         return true;                                                                               \
     }                                                                                              \
                                                                                                    \
@@ -88,14 +209,14 @@ extern "C"
                                                                                                    \
     static inline bool cArray_##T##_insert(cArray_##T* vector, const T* element, const int index)  \
     {                                                                                              \
+        CSTATS_ADD(cArray_##T##_stats_data, failed_pushes, vector->size >= vector->capacity);      \
         if ((vector->size >= vector->capacity) || (index > vector->size) || (index < 0))           \
             return false;                                                                          \
-        for (int i = (vector->size - 1); i >= index; i--)                                          \
-        {                                                                                          \
-            CPY(&vector->array[i + 1], &vector->array[i]);                                         \
-        }                                                                                          \
+        cArray_##T##_move_n(                                                                       \
+            &vector->array[index + 1], &vector->array[index], vector->size - index);               \
         CPY(&vector->array[index], element);                                                       \
         vector->size++;                                                                            \
+        CSTATS_MAX(cArray_##T##_stats_data, high_water, vector->size);                             \
         return true;                                                                               \
     }                                                                                              \
                                                                                                    \
@@ -103,16 +224,86 @@ extern "C"
     {                                                                                              \
         if ((vector->size <= 0) || (index >= vector->size) || (index < 0))                         \
             return false;                                                                          \
-        for (int i = index; i < (vector->size - 1); i++)                                           \
-        {                                                                                          \
-            CPY(&vector->array[i], &vector->array[i + 1]);                                         \
-        }                                                                                          \
+        cArray_##T##_move_n(                                                                       \
+            &vector->array[index], &vector->array[index + 1], vector->size - index - 1);           \
         vector->size--;                                                                            \
         return true;                                                                               \
     }                                                                                              \
                                                                                                    \
-    static inline int cArray_##T##_find(cArray_##T* vector, const T* element)                      \
+    /* Insert n elements at index, elements must not point into the array. Returns false (and      \
+     * inserts nothing) if they do not all fit or index is invalid */                              \
+    static inline bool cArray_##T##_insert_range(                                                  \
+        cArray_##T* vector, const T* elements, const int n, const int index)                       \
+    {                                                                                              \
+        CSTATS_ADD(cArray_##T##_stats_data, failed_pushes, n > vector->capacity - vector->size);   \
+        if ((n < 0) || (index < 0) || (index > vector->size) ||                                    \
+            (n > vector->capacity - vector->size))                                                 \
+            return false;                                                                          \
+        cArray_##T##_move_n(                                                                       \
+            &vector->array[index + n], &vector->array[index], vector->size - index);               \
+        cArray_##T##_move_n(&vector->array[index], elements, n);                                   \
+        vector->size += n;                                                                         \
+        CSTATS_MAX(cArray_##T##_stats_data, high_water, vector->size);                             \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Append n elements, false (and nothing appended) if they do not all fit */                   \
+    static inline bool cArray_##T##_push_n(cArray_##T* vector, const T* elements, const int n)     \
+    {                                                                                              \
+        return cArray_##T##_insert_range(vector, elements, n, vector->size);                       \
+    }                                                                                              \
+                                                                                                   \
+    /* Append all the elements of other, which may be vector itself */                             \
+    static inline bool cArray_##T##_append_array(cArray_##T* vector, const cArray_##T* other)      \
+    {                                                                                              \
+        return cArray_##T##_push_n(vector, other->array, other->size);                             \
+    }                                                                                              \
+                                                                                                   \
+    /* Delete the elements in [start, end], false if the range is invalid */                       \
+    static inline bool cArray_##T##_erase_range(                                                   \
+        cArray_##T* vector, const int start, const int end)                                        \
+    {                                                                                              \
+        if ((start < 0) || (end >= vector->size) || (start > end))                                 \
+            return false;                                                                          \
+        cArray_##T##_move_n(                                                                       \
+            &vector->array[start], &vector->array[end + 1], vector->size - end - 1);               \
+        vector->size -= end - start + 1;                                                           \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Replace the content with n elements, false (and unchanged) if n exceeds the capacity */     \
+    static inline bool cArray_##T##_assign(cArray_##T* vector, const T* elements, const int n)     \
+    {                                                                                              \
+        if ((n < 0) || (n > vector->capacity))                                                     \
+            return false;                                                                          \
+        cArray_##T##_move_n(vector->array, elements, n);                                           \
+        vector->size = n;                                                                          \
+        CSTATS_MAX(cArray_##T##_stats_data, high_water, vector->size);                             \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Set the size, new elements are copies of fill (left as they are in the buffer if fill is    \
+     * NULL). False (and unchanged) if size is negative or exceeds the capacity */                 \
+    static inline bool cArray_##T##_resize(cArray_##T* vector, const int size, const T* fill)      \
+    {                                                                                              \
+        if ((size < 0) || (size > vector->capacity))                                               \
+            return false;                                                                          \
+        for (int i = vector->size; fill && (i < size); i++)                                        \
+            CPY(&vector->array[i], fill);                                                          \
+        vector->size = size;                                                                       \
+        CSTATS_MAX(cArray_##T##_stats_data, high_water, vector->size);                             \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Index of the first element equal to element, -1 if none. SIMD for primitive types */        \
+    static inline int cArray_##T##_find(const cArray_##T* vector, const T* element)                \
     {                                                                                              \
+        if (CARRAY_SIMD_ELEM(T, FLAGS) >= 0)                                                       \
+        {                                                                                          \
+            const size_t i = cSimd_find(vector->array, (size_t) vector->size, element,             \
+                                        (cSimd_elem) CARRAY_SIMD_ELEM(T, FLAGS));                  \
+            return (i == CSIMD_NPOS) ? -1 : (int) i;                                               \
+        }                                                                                          \
         for (int i = 0; i < vector->size; i++)                                                     \
         {                                                                                          \
             if (CMP(element, &vector->array[i]) == 0)                                              \
@@ -121,6 +312,43 @@ extern "C"
         return -1;                                                                                 \
     }                                                                                              \
                                                                                                    \
+    /* Index of the last element equal to element, -1 if none */                                   \
+    static inline int cArray_##T##_find_last(const cArray_##T* vector, const T* element)           \
+    {                                                                                              \
+        if (CARRAY_SIMD_ELEM(T, FLAGS) >= 0)                                                       \
+        {                                                                                          \
+            const size_t i = cSimd_find_last(vector->array, (size_t) vector->size, element,        \
+                                             (cSimd_elem) CARRAY_SIMD_ELEM(T, FLAGS));             \
+            return (i == CSIMD_NPOS) ? -1 : (int) i;                                               \
+        }                                                                                          \
+        for (int i = vector->size - 1; i >= 0; i--)                                                \
+        {                                                                                          \
+            if (CMP(element, &vector->array[i]) == 0)                                              \
+                return i;                                                                          \
+        }                                                                                          \
+        return -1;                                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    /* Number of elements equal to element */                                                      \
+    static inline int cArray_##T##_count(const cArray_##T* vector, const T* element)               \
+    {                                                                                              \
+        if (CARRAY_SIMD_ELEM(T, FLAGS) >= 0)                                                       \
+        {                                                                                          \
+            return (int) cSimd_count(vector->array, (size_t) vector->size, element,                \
+                                     (cSimd_elem) CARRAY_SIMD_ELEM(T, FLAGS));                     \
+        }                                                                                          \
+        int count = 0;                                                                             \
+        for (int i = 0; i < vector->size; i++)                                                     \
+            count += (CMP(element, &vector->array[i]) == 0);                                       \
+        return count;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    /* Whether an element equal to element is present */                                           \
+    static inline bool cArray_##T##_contains(const cArray_##T* vector, const T* element)           \
+    {                                                                                              \
+        return cArray_##T##_find(vector, element) >= 0;                                            \
+    }                                                                                              \
+                                                                                                   \
     static inline bool cArray_##T##_push_unique(cArray_##T* vector, const T* element)              \
     {                                                                                              \
         if (cArray_##T##_find(vector, element) >= 0)                                               \
@@ -136,62 +364,157 @@ extern "C"
         return cArray_##T##_insert(vector, element, index);                                        \
     }                                                                                              \
                                                                                                    \
+    /* Index of the first element not less than element (size if there is none), the array must be \
+     * sorted. Branchless: the loop runs exactly ceil(log2(size)) times and the comparison only    \
+     * selects the next base (a conditional move), both candidate midpoints of the next step are   \
+     * prefetched so large arrays overlap their cache misses */                                    \
+    static inline int cArray_##T##_lower_bound(const cArray_##T* vector, const T* element)         \
+    {                                                                                              \
+        const T* base = vector->array;                                                             \
+        int len = vector->size;                                                                    \
+        if (len <= 0)                                                                              \
+            return 0;                                                                              \
+        while (len > 1)                                                                            \
+        {                                                                                          \
+            const int half = len / 2;                                                              \
+            CARRAY_PREFETCH(&base[(len - half) / 2]);                                              \
+            CARRAY_PREFETCH(&base[half + ((len - half) / 2)]);                                     \
+            base = (CMP(&base[half], element) < 0) ? &base[half] : base;                           \
+            len -= half;                                                                           \
+        }                                                                                          \
+        return (int) (base - vector->array) + (CMP(base, element) < 0);                            \
+    }                                                                                              \
+                                                                                                   \
+    /* Index of the first element greater than element (size if there is none), the array must be  \
+     * sorted. Branchless like lower_bound */                                                      \
+    static inline int cArray_##T##_upper_bound(const cArray_##T* vector, const T* element)         \
+    {                                                                                              \
+        const T* base = vector->array;                                                             \
+        int len = vector->size;                                                                    \
+        if (len <= 0)                                                                              \
+            return 0;                                                                              \
+        while (len > 1)                                                                            \
+        {                                                                                          \
+            const int half = len / 2;                                                              \
+            CARRAY_PREFETCH(&base[(len - half) / 2]);                                              \
+            CARRAY_PREFETCH(&base[half + ((len - half) / 2)]);                                     \
+            base = (CMP(&base[half], element) <= 0) ? &base[half] : base;                          \
+            len -= half;                                                                           \
+        }                                                                                          \
+        return (int) (base - vector->array) + (CMP(base, element) <= 0);                           \
+    }                                                                                              \
+                                                                                                   \
+    /* Find the elements equal to element in a sorted array, they are between first and last       \
+     * (inclusive). Returns false (and leaves first / last unchanged) if there is none */          \
+    static inline bool cArray_##T##_equal_range(                                                   \
+        const cArray_##T* vector, const T* element, int* first, int* last)                         \
+    {                                                                                              \
+        const int lower = cArray_##T##_lower_bound(vector, element);                               \
+        if ((lower >= vector->size) || (CMP(&vector->array[lower], element) != 0))                 \
+            return false;                                                                          \
+        *first = lower;                                                                            \
+        *last = cArray_##T##_upper_bound(vector, element) - 1;                                     \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+                                                                                                   \
     static inline bool cArray_##T##_binsert(cArray_##T* vector, const T* element)                  \
     {                                                                                              \
+        CSTATS_ADD(cArray_##T##_stats_data, failed_pushes, vector->size >= vector->capacity);      \
         if (vector->size >= vector->capacity)                                                      \
             return false;                                                                          \
-        int head = 0, tail = vector->size - 1;                                                     \
-        int index = vector->size;                                                                  \
-        while (head <= tail)                                                                       \
-        {                                                                                          \
-            int mid = head + (tail - head) / 2;                                                    \
-            if (CMP(element, &vector->array[mid]) > 0)                                             \
-            {                                                                                      \
-                head = mid + 1;                                                                    \
-            }                                                                                      \
-            else                                                                                   \
-            {                                                                                      \
-                index = mid;                                                                       \
-                tail = mid - 1;                                                                    \
-            }                                                                                      \
-        }                                                                                          \
-        return cArray_##T##_insert(vector, element, index);                                        \
+        return cArray_##T##_insert(vector, element, cArray_##T##_lower_bound(vector, element));    \
     }                                                                                              \
                                                                                                    \
     static inline int cArray_##T##_bsearch(cArray_##T* vector, const T* element)                   \
     {                                                                                              \
-        if (vector->size <= 0)                                                                     \
-            return -1;                                                                             \
-        if ((CMP(element, &vector->array[vector->size - 1]) > 0) ||                                \
-            (CMP(element, &vector->array[0]) < 0))                                                 \
+        const int index = cArray_##T##_lower_bound(vector, element);                               \
+        if ((index >= vector->size) || (CMP(element, &vector->array[index]) != 0))                 \
             return -1;                                                                             \
+        return index;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    /* Read-only search index of a sorted array in Eytzinger (BFS) order: node k has its children  \
+     * at 2k and 2k + 1, so the first levels of every search share a few cache lines and the next  \
+     * levels can be prefetched 4 at a time */                                                     \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        T* tree;   /* size + 1 elements, tree[0] is unused */                                      \
+        int* rank; /* rank[k] is the index of tree[k] in the sorted array */                       \
+        int size;                                                                                  \
+    } cArray_##T##_eytzinger;                                                                      \
+                                                                                                   \
+    static inline int cArray_##T##_eytzinger_fill(                                                 \
+        cArray_##T##_eytzinger* index, const T* sorted, int i, const int k)                        \
+    {                                                                                              \
+        if (k > index->size)                                                                       \
+            return i;                                                                              \
+        i = cArray_##T##_eytzinger_fill(index, sorted, i, 2 * k);                                  \
+        CPY(&index->tree[k], &sorted[i]);                                                          \
+        index->rank[k] = i;                                                                        \
+        i++;                                                                                       \
+        return cArray_##T##_eytzinger_fill(index, sorted, i, (2 * k) + 1);                         \
+    }                                                                                              \
+                                                                                                   \
+    /* Build an Eytzinger index of a sorted array into the buffers tree and rank of                \
+     * vector->size + 1 elements each. O(n), the index is a copy: rebuild it after modifying the   \
+     * array */                                                                                    \
+    static inline void cArray_##T##_eytzinger_init(                                                \
+        cArray_##T##_eytzinger* index, T* tree, int* rank, const cArray_##T* vector)               \
+    {                                                                                              \
+        index->tree = tree;                                                                        \
+        index->rank = rank;                                                                        \
+        index->size = (vector->size > 0) ? vector->size : 0;                                       \
+        cArray_##T##_eytzinger_fill(index, vector->array, 0, 1);                                   \
+    }                                                                                              \
                                                                                                    \
-        int head = 0, tail = vector->size - 1;                                                     \
-        while (head <= tail)                                                                       \
+    /* Node of the first element not less than element, 0 if there is none */                      \
+    static inline int cArray_##T##_eytzinger_node(                                                 \
+        const cArray_##T##_eytzinger* index, const T* element)                                     \
+    {                                                                                              \
+        /* Nodes 4 levels below k (16 ints) share a cache line, fetch it while we compare k */     \
+        const long long ahead = (sizeof(T) >= 64) ? 1 : (long long) (64 / sizeof(T));              \
+        const int size = index->size;                                                              \
+        int k = 1;                                                                                 \
+        while (k <= size)                                                                          \
         {                                                                                          \
-            int index = head + (tail - head) / 2;                                                  \
-            if (CMP(element, &vector->array[index]) == 0)                                          \
-            {                                                                                      \
-                return index;                                                                      \
-            }                                                                                      \
-            else if (CMP(element, &vector->array[index]) > 0)                                      \
-            {                                                                                      \
-                head = index + 1;                                                                  \
-            }                                                                                      \
-            else                                                                                   \
-            {                                                                                      \
-                tail = index - 1;                                                                  \
-            }                                                                                      \
+            if (k * ahead <= size)                                                                 \
+                CARRAY_PREFETCH(&index->tree[k * ahead]);                                          \
+            k = (2 * k) + (CMP(&index->tree[k], element) < 0);                                     \
         }                                                                                          \
-        return -1;                                                                                 \
+        /* Undo the right turns taken after the last left turn, k is then the answer's node */     \
+        while (k & 1)                                                                              \
+            k >>= 1;                                                                               \
+        return k >> 1;                                                                             \
+    }                                                                                              \
+                                                                                                   \
+    /* Same result as lower_bound on the indexed array: index of the first element not less than   \
+     * element in the sorted array, or size if there is none */                                    \
+    static inline int cArray_##T##_eytzinger_lower_bound(                                          \
+        const cArray_##T##_eytzinger* index, const T* element)                                     \
+    {                                                                                              \
+        const int k = cArray_##T##_eytzinger_node(index, element);                                 \
+        return (k == 0) ? index->size : index->rank[k];                                            \
+    }                                                                                              \
+                                                                                                   \
+    /* Index of element in the sorted array (the first one if repeated) using the index, or -1 */  \
+    static inline int cArray_##T##_eytzinger_find(                                                 \
+        const cArray_##T##_eytzinger* index, const T* element)                                     \
+    {                                                                                              \
+        const int k = cArray_##T##_eytzinger_node(index, element);                                 \
+        if ((k == 0) || (CMP(&index->tree[k], element) != 0))                                      \
+            return -1;                                                                             \
+        return index->rank[k];                                                                     \
     }                                                                                              \
                                                                                                    \
     static inline bool cArray_##T##_enqueue(cArray_##T* vector, const T* element)                  \
     {                                                                                              \
+        CSTATS_ADD(cArray_##T##_stats_data, failed_enqueues, vector->size >= vector->capacity);    \
         if (vector->size >= vector->capacity)                                                      \
             return false;                                                                          \
         CPY(&vector->array[(vector->head + vector->size) % vector->capacity], element);            \
         vector->size++;                                                                            \
+        CSTATS_MAX(cArray_##T##_stats_data, high_water, vector->size);                             \
         return true;                                                                               \
     }                                                                                              \
                                                                                                    \
@@ -306,6 +629,7 @@ extern "C"
                                                                                                    \
     static inline void cArray_##T##_merge_sort(cArray_##T* vector, const int start, const int end) \
     {                                                                                              \
+        CSTATS_TIME_SCOPE(cArray_##T##_stats_data, sort);                                          \
         if ((start < 0) || (end >= vector->size) || (start >= end))                                \
             return;                                                                                \
         T* temp = (T*) malloc((end - start + 1) * sizeof(T));                                      \
@@ -318,6 +642,7 @@ extern "C"
     static inline void cArray_##T##_insertion_sort(                                                \
         cArray_##T* vector, const int start, const int end)                                        \
     {                                                                                              \
+        CSTATS_TIME_SCOPE(cArray_##T##_stats_data, sort);                                          \
         if ((start < 0) || (end >= vector->size) || (start >= end))                                \
             return;                                                                                \
                                                                                                    \
@@ -339,6 +664,7 @@ extern "C"
                                                                                                    \
     static inline void cArray_##T##_quick_sort(cArray_##T* vector, int start, int end)             \
     {                                                                                              \
+        CSTATS_TIME_SCOPE(cArray_##T##_stats_data, sort);                                          \
         if ((start < 0) || (end >= vector->size) || (start >= end))                                \
             return;                                                                                \
         /* Tail recursion - iteratively recurse from the smallest to the largest partition */      \
@@ -388,24 +714,1452 @@ extern "C"
                 end = j;                                                                           \
             }                                                                                      \
         }                                                                                          \
-    }
-
-#define CARRAY_PRIMITIVE_CPY(T)                                                                    \
-    static inline void T##_cpy(T* a, const T* b)                                                   \
+    }                                                                                              \
+                                                                                                   \
+    /* Insertion sort of a[begin, end), used for small partitions */                               \
+    static inline void cArray_##T##_pdq_insertion(T* a, const int begin, const int end)            \
     {                                                                                              \
-        *a = *b;                                                                                   \
-    }
-
-#define CARRAY_PRIMITIVE_CMP(T)                                                                    \
-    static inline int T##_cmp(const T* a, const T* b)                                              \
+        for (int i = begin + 1; i < end; i++)                                                      \
+        {                                                                                          \
+            if (CMP(&a[i], &a[i - 1]) >= 0)                                                        \
+                continue;                                                                          \
+            T key;                                                                                 \
+            CPY(&key, &a[i]);                                                                      \
+            int j = i;                                                                             \
+            do                                                                                     \
+            {                                                                                      \
+                CPY(&a[j], &a[j - 1]);                                                             \
+                j--;                                                                               \
+            } while ((j > begin) && (CMP(&key, &a[j - 1]) < 0));                                   \
+            CPY(&a[j], &key);                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Insertion sort of a[begin, end) without the lower bound check, a[begin - 1] must be <=      \
+     * every element of the range so it stops the scan */                                          \
+    static inline void cArray_##T##_pdq_unguarded_insertion(T* a, const int begin, const int end)  \
     {                                                                                              \
-        return ((*a > *b) - (*a < *b));                                                            \
-    }
-
-#define CARRAY_GENERATE_PRIMITIVE(T)                                                               \
-    CARRAY_PRIMITIVE_CPY(T)                                                                        \
-    CARRAY_PRIMITIVE_CMP(T)                                                                        \
-    CARRAY_GENERATE(T, T##_cpy, T##_cmp)
+        for (int i = begin + 1; i < end; i++)                                                      \
+        {                                                                                          \
+            if (CMP(&a[i], &a[i - 1]) >= 0)                                                        \
+                continue;                                                                          \
+            T key;                                                                                 \
+            CPY(&key, &a[i]);                                                                      \
+            int j = i;                                                                             \
+            do                                                                                     \
+            {                                                                                      \
+                CPY(&a[j], &a[j - 1]);                                                             \
+                j--;                                                                               \
+            } while (CMP(&key, &a[j - 1]) < 0);                                                    \
+            CPY(&a[j], &key);                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Insertion sort of a[begin, end) that gives up (returns false) once more than                \
+     * CARRAY_PDQ_PARTIAL_LIMIT elements had to be moved */                                        \
+    static inline bool cArray_##T##_pdq_partial_insertion(T* a, const int begin, const int end)    \
+    {                                                                                              \
+        int moved = 0;                                                                             \
+        for (int i = begin + 1; i < end; i++)                                                      \
+        {                                                                                          \
+            if (CMP(&a[i], &a[i - 1]) >= 0)                                                        \
+                continue;                                                                          \
+            T key;                                                                                 \
+            CPY(&key, &a[i]);                                                                      \
+            int j = i;                                                                             \
+            do                                                                                     \
+            {                                                                                      \
+                CPY(&a[j], &a[j - 1]);                                                             \
+                j--;                                                                               \
+            } while ((j > begin) && (CMP(&key, &a[j - 1]) < 0));                                   \
+            CPY(&a[j], &key);                                                                      \
+            moved += i - j;                                                                        \
+            if (moved > CARRAY_PDQ_PARTIAL_LIMIT)                                                  \
+                return false;                                                                      \
+        }                                                                                          \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline void cArray_##T##_pdq_sort2(T* a, const int i, const int j)                      \
+    {                                                                                              \
+        if (CMP(&a[j], &a[i]) < 0)                                                                 \
+            cArray_##T##_swap(&a[i], &a[j]);                                                       \
+    }                                                                                              \
+                                                                                                   \
+    /* Order a[i] <= a[j] <= a[k] */                                                               \
+    static inline void cArray_##T##_pdq_sort3(T* a, const int i, const int j, const int k)         \
+    {                                                                                              \
+        cArray_##T##_pdq_sort2(a, i, j);                                                           \
+        cArray_##T##_pdq_sort2(a, j, k);                                                           \
+        cArray_##T##_pdq_sort2(a, i, j);                                                           \
+    }                                                                                              \
+                                                                                                   \
+    static inline void cArray_##T##_sift_down(T* a, const int begin, int root, const int size)     \
+    {                                                                                              \
+        T value;                                                                                   \
+        CPY(&value, &a[begin + root]);                                                             \
+        int child;                                                                                 \
+        while ((child = (2 * root) + 1) < size)                                                    \
+        {                                                                                          \
+            if ((child + 1 < size) && (CMP(&a[begin + child], &a[begin + child + 1]) < 0))         \
+                child++;                                                                           \
+            if (CMP(&value, &a[begin + child]) >= 0)                                               \
+                break;                                                                             \
+            CPY(&a[begin + root], &a[begin + child]);                                              \
+            root = child;                                                                          \
+        }                                                                                          \
+        CPY(&a[begin + root], &value);                                                             \
+    }                                                                                              \
+                                                                                                   \
+    /* Heapsort of a[begin, end), the O(n log n) fallback when pivots keep going bad */            \
+    static inline void cArray_##T##_pdq_heap_sort(T* a, const int begin, const int end)            \
+    {                                                                                              \
+        const int size = end - begin;                                                              \
+        for (int i = (size / 2) - 1; i >= 0; i--)                                                  \
+            cArray_##T##_sift_down(a, begin, i, size);                                             \
+        for (int n = size - 1; n > 0; n--)                                                         \
+        {                                                                                          \
+            cArray_##T##_swap(&a[begin], &a[begin + n]);                                           \
+            cArray_##T##_sift_down(a, begin, 0, n);                                                \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Move the misplaced elements recorded in two offset blocks across the pivot. With equal      \
+     * counts plain swaps are used (needed to keep descending input O(n)), otherwise a cyclic      \
+     * permutation that needs one copy per element instead of three */                             \
+    static inline void cArray_##T##_pdq_swap_offsets(T* a,                                         \
+                                                      const int left_base,                         \
+                                                      const int right_base,                        \
+                                                      const unsigned char* offsets_l,              \
+                                                      const unsigned char* offsets_r,              \
+                                                      const int num,                               \
+                                                      const bool use_swaps)                        \
+    {                                                                                              \
+        if (use_swaps)                                                                             \
+        {                                                                                          \
+            for (int i = 0; i < num; i++)                                                          \
+                cArray_##T##_swap(&a[left_base + offsets_l[i]], &a[right_base - offsets_r[i]]);    \
+        }                                                                                          \
+        else if (num > 0)                                                                          \
+        {                                                                                          \
+            int l = left_base + offsets_l[0];                                                      \
+            int r = right_base - offsets_r[0];                                                     \
+            T temp;                                                                                \
+            CPY(&temp, &a[l]);                                                                     \
+            CPY(&a[l], &a[r]);                                                                     \
+            for (int i = 1; i < num; i++)                                                          \
+            {                                                                                      \
+                l = left_base + offsets_l[i];                                                      \
+                CPY(&a[r], &a[l]);                                                                 \
+                r = right_base - offsets_r[i];                                                     \
+                CPY(&a[l], &a[r]);                                                                 \
+            }                                                                                      \
+            CPY(&a[r], &temp);                                                                     \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /*                                                                                             \
+     * Partition a[begin, end) around the pivot a[begin] into [< pivot][pivot][>= pivot] and       \
+     * return the final pivot index. already_partitioned is set if no element had to move.         \
+     * Elements are classified a block at a time into offset buffers with branch-free code (the    \
+     * comparison result only bumps a counter), then swapped in bulk, so a random input costs no   \
+     * branch mispredictions in the scan (BlockQuicksort, Edelkamp & Weiss).                       \
+     * NOTE: needs an element >= pivot after begin, the median-of-3 guarantees one                 \
+     */                                                                                            \
+    static inline int cArray_##T##_pdq_partition_right(                                            \
+        T* a, const int begin, const int end, bool* already_partitioned)                           \
+    {                                                                                              \
+        T pivot;                                                                                   \
+        CPY(&pivot, &a[begin]);                                                                    \
+        int first = begin, last = end;                                                             \
+                                                                                                   \
+        /* First element >= pivot, and last element < pivot (guarded if nothing preceded first) */ \
+        while (CMP(&a[++first], &pivot) < 0)                                                       \
+            ;                                                                                      \
+        if (first - 1 == begin)                                                                    \
+        {                                                                                          \
+            while ((first < last) && (CMP(&a[--last], &pivot) >= 0))                               \
+                ;                                                                                  \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            while (CMP(&a[--last], &pivot) >= 0)                                                   \
+                ;                                                                                  \
+        }                                                                                          \
+                                                                                                   \
+        *already_partitioned = (first >= last);                                                    \
+        if (! *already_partitioned)                                                                \
+        {                                                                                          \
+            cArray_##T##_swap(&a[first], &a[last]);                                                \
+            first++;                                                                               \
+                                                                                                   \
+            unsigned char offsets_l[CARRAY_PDQ_BLOCK], offsets_r[CARRAY_PDQ_BLOCK];                \
+            int left_base = first, right_base = last;                                              \
+            int num_l = 0, num_r = 0, start_l = 0, start_r = 0;                                    \
+            while (first < last)                                                                   \
+            {                                                                                      \
+                /* Split the unknown elements between the blocks that need refilling */            \
+                const int unknown = last - first;                                                  \
+                const int left_split = (num_l == 0) ? ((num_r == 0) ? unknown / 2 : unknown) : 0;  \
+                const int right_split = (num_r == 0) ? (unknown - left_split) : 0;                 \
+                                                                                                   \
+                const int left_count =                                                             \
+                    (left_split < CARRAY_PDQ_BLOCK) ? left_split : CARRAY_PDQ_BLOCK;               \
+                for (int i = 0; i < left_count; i++)                                               \
+                {                                                                                  \
+                    offsets_l[num_l] = (unsigned char) i;                                          \
+                    num_l += (CMP(&a[first], &pivot) >= 0);                                        \
+                    first++;                                                                       \
+                }                                                                                  \
+                const int right_count =                                                            \
+                    (right_split < CARRAY_PDQ_BLOCK) ? right_split : CARRAY_PDQ_BLOCK;             \
+                for (int i = 1; i <= right_count; i++)                                             \
+                {                                                                                  \
+                    offsets_r[num_r] = (unsigned char) i;                                          \
+                    num_r += (CMP(&a[--last], &pivot) < 0);                                        \
+                }                                                                                  \
+                                                                                                   \
+                const int num = (num_l < num_r) ? num_l : num_r;                                   \
+                cArray_##T##_pdq_swap_offsets(a,                                                   \
+                                              left_base,                                           \
+                                              right_base,                                          \
+                                              offsets_l + start_l,                                 \
+                                              offsets_r + start_r,                                 \
+                                              num,                                                 \
+                                              num_l == num_r);                                     \
+                num_l -= num;                                                                      \
+                num_r -= num;                                                                      \
+                start_l += num;                                                                    \
+                start_r += num;                                                                    \
+                if (num_l == 0)                                                                    \
+                {                                                                                  \
+                    start_l = 0;                                                                   \
+                    left_base = first;                                                             \
+                }                                                                                  \
+                if (num_r == 0)                                                                    \
+                {                                                                                  \
+                    start_r = 0;                                                                   \
+                    right_base = last;                                                             \
+                }                                                                                  \
+            }                                                                                      \
+                                                                                                   \
+            /* One block may still hold misplaced elements, move them to the boundary */           \
+            if (num_l)                                                                             \
+            {                                                                                      \
+                while (num_l--)                                                                    \
+                    cArray_##T##_swap(&a[left_base + offsets_l[start_l + num_l]], &a[--last]);     \
+                first = last;                                                                      \
+            }                                                                                      \
+            if (num_r)                                                                             \
+            {                                                                                      \
+                while (num_r--)                                                                    \
+                    cArray_##T##_swap(&a[right_base - offsets_r[start_r + num_r]], &a[first++]);   \
+                last = first;                                                                      \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        const int pivot_pos = first - 1;                                                           \
+        CPY(&a[begin], &a[pivot_pos]);                                                             \
+        CPY(&a[pivot_pos], &pivot);                                                                \
+        return pivot_pos;                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Partition a[begin, end) into [<= pivot][> pivot] around a[begin] and return the pivot       \
+     * index. Used when the pivot equals the element before the range, so the whole run of equal   \
+     * elements is put in place at once and inputs with many duplicates take O(n * distinct) */    \
+    static inline int cArray_##T##_pdq_partition_left(T* a, const int begin, const int end)        \
+    {                                                                                              \
+        T pivot;                                                                                   \
+        CPY(&pivot, &a[begin]);                                                                    \
+        int first = begin, last = end;                                                             \
+                                                                                                   \
+        while (CMP(&pivot, &a[--last]) < 0)                                                        \
+            ;                                                                                      \
+        if (last + 1 == end)                                                                       \
+        {                                                                                          \
+            while ((first < last) && (CMP(&pivot, &a[++first]) >= 0))                              \
+                ;                                                                                  \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            while (CMP(&pivot, &a[++first]) >= 0)                                                  \
+                ;                                                                                  \
+        }                                                                                          \
+        while (first < last)                                                                       \
+        {                                                                                          \
+            cArray_##T##_swap(&a[first], &a[last]);                                                \
+            while (CMP(&pivot, &a[--last]) < 0)                                                    \
+                ;                                                                                  \
+            while (CMP(&pivot, &a[++first]) >= 0)                                                  \
+                ;                                                                                  \
+        }                                                                                          \
+                                                                                                   \
+        CPY(&a[begin], &a[last]);                                                                  \
+        CPY(&a[last], &pivot);                                                                     \
+        return last;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Move the pivot of a[begin, end) to a[begin]: the median of 3, or the pseudo-median of 9     \
+     * (Tukey's ninther) for large sizes. Leaves an element >= pivot after begin */                \
+    static inline void cArray_##T##_pdq_choose_pivot(T* a, const int begin, const int end)         \
+    {                                                                                              \
+        const int size = end - begin;                                                              \
+        const int half = size / 2;                                                                 \
+        if (size > CARRAY_PDQ_NINTHER_THRESHOLD)                                                   \
+        {                                                                                          \
+            cArray_##T##_pdq_sort3(a, begin, begin + half, end - 1);                               \
+            cArray_##T##_pdq_sort3(a, begin + 1, begin + half - 1, end - 2);                       \
+            cArray_##T##_pdq_sort3(a, begin + 2, begin + half + 1, end - 3);                       \
+            cArray_##T##_pdq_sort3(a, begin + half - 1, begin + half, begin + half + 1);           \
+            cArray_##T##_swap(&a[begin], &a[begin + half]);                                        \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            cArray_##T##_pdq_sort3(a, begin + half, begin, end - 1);                               \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Main pdqsort loop over a[begin, end). bad_allowed is the number of highly unbalanced        \
+     * partitions tolerated before switching to heapsort, leftmost is false when a[begin - 1] is a \
+     * lower bound of the range */                                                                 \
+    static inline void cArray_##T##_pdq_loop(T* a, int begin, const int end, int bad_allowed,      \
+                                             bool leftmost)                                        \
+    {                                                                                              \
+        while (true)                                                                               \
+        {                                                                                          \
+            const int size = end - begin;                                                          \
+            if (size < CARRAY_PDQ_INSERTION_THRESHOLD)                                             \
+            {                                                                                      \
+                if (leftmost)                                                                      \
+                    cArray_##T##_pdq_insertion(a, begin, end);                                     \
+                else                                                                               \
+                    cArray_##T##_pdq_unguarded_insertion(a, begin, end);                           \
+                return;                                                                            \
+            }                                                                                      \
+                                                                                                   \
+            cArray_##T##_pdq_choose_pivot(a, begin, end);                                          \
+                                                                                                   \
+            /* The pivot equals the lower bound of the range: everything equal to it goes left and \
+             * is done, only the elements greater than it still need sorting */                    \
+            if (! leftmost && (CMP(&a[begin - 1], &a[begin]) >= 0))                                \
+            {                                                                                      \
+                begin = cArray_##T##_pdq_partition_left(a, begin, end) + 1;                        \
+                continue;                                                                          \
+            }                                                                                      \
+                                                                                                   \
+            bool already_partitioned;                                                              \
+            const int pivot_pos =                                                                  \
+                cArray_##T##_pdq_partition_right(a, begin, end, &already_partitioned);             \
+            const int l_size = pivot_pos - begin;                                                  \
+            const int r_size = end - (pivot_pos + 1);                                              \
+                                                                                                   \
+            if ((l_size < size / 8) || (r_size < size / 8))                                        \
+            {                                                                                      \
+                /* Too many bad pivots, guarantee O(n log n) with heapsort */                      \
+                if (--bad_allowed == 0)                                                            \
+                {                                                                                  \
+                    cArray_##T##_pdq_heap_sort(a, begin, end);                                     \
+                    return;                                                                        \
+                }                                                                                  \
+                /* Break up patterns that produce bad pivots by shuffling a few elements */        \
+                if (l_size >= CARRAY_PDQ_INSERTION_THRESHOLD)                                      \
+                {                                                                                  \
+                    cArray_##T##_swap(&a[begin], &a[begin + l_size / 4]);                          \
+                    cArray_##T##_swap(&a[pivot_pos - 1], &a[pivot_pos - l_size / 4]);              \
+                    if (l_size > CARRAY_PDQ_NINTHER_THRESHOLD)                                     \
+                    {                                                                              \
+                        cArray_##T##_swap(&a[begin + 1], &a[begin + (l_size / 4 + 1)]);            \
+                        cArray_##T##_swap(&a[begin + 2], &a[begin + (l_size / 4 + 2)]);            \
+                        cArray_##T##_swap(&a[pivot_pos - 2], &a[pivot_pos - (l_size / 4 + 1)]);    \
+                        cArray_##T##_swap(&a[pivot_pos - 3], &a[pivot_pos - (l_size / 4 + 2)]);    \
+                    }                                                                              \
+                }                                                                                  \
+                if (r_size >= CARRAY_PDQ_INSERTION_THRESHOLD)                                      \
+                {                                                                                  \
+                    cArray_##T##_swap(&a[pivot_pos + 1], &a[pivot_pos + (1 + r_size / 4)]);        \
+                    cArray_##T##_swap(&a[end - 1], &a[end - r_size / 4]);                          \
+                    if (r_size > CARRAY_PDQ_NINTHER_THRESHOLD)                                     \
+                    {                                                                              \
+                        cArray_##T##_swap(&a[pivot_pos + 2], &a[pivot_pos + (2 + r_size / 4)]);    \
+                        cArray_##T##_swap(&a[pivot_pos + 3], &a[pivot_pos + (3 + r_size / 4)]);    \
+                        cArray_##T##_swap(&a[end - 2], &a[end - (1 + r_size / 4)]);                \
+                        cArray_##T##_swap(&a[end - 3], &a[end - (2 + r_size / 4)]);                \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+            else if (already_partitioned &&                                                        \
+                     cArray_##T##_pdq_partial_insertion(a, begin, pivot_pos) &&                    \
+                     cArray_##T##_pdq_partial_insertion(a, pivot_pos + 1, end))                    \
+            {                                                                                      \
+                /* Nothing moved and both sides were (nearly) sorted already */                    \
+                return;                                                                            \
+            }                                                                                      \
+                                                                                                   \
+            cArray_##T##_pdq_loop(a, begin, pivot_pos, bad_allowed, leftmost);                     \
+            begin = pivot_pos + 1;                                                                 \
+            leftmost = false;                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /*                                                                                             \
+     * Sort the array between start and end (inclusive) with pattern-defeating quicksort           \
+     * (pdqsort). O(n log n) worst case (heapsort fallback after log2(n) bad partitions), O(n) for \
+     * sorted and reverse-sorted inputs, no heap allocation. Not stable.                           \
+     */                                                                                            \
+    static inline void cArray_##T##_pdq_sort(cArray_##T* vector, const int start, const int end)   \
+    {                                                                                              \
+        CSTATS_TIME_SCOPE(cArray_##T##_stats_data, sort);                                          \
+        if ((start < 0) || (end >= vector->size) || (start >= end))                                \
+            return;                                                                                \
+        T* a = vector->array;                                                                      \
+                                                                                                   \
+        /* Already sorted or strictly descending input is finished with a single scan */           \
+        int run = start + 1;                                                                       \
+        if (CMP(&a[run], &a[start]) < 0)                                                           \
+        {                                                                                          \
+            while ((run < end) && (CMP(&a[run + 1], &a[run]) < 0))                                 \
+                run++;                                                                             \
+            if (run == end)                                                                        \
+            {                                                                                      \
+                cArray_##T##_reverse(vector, start, end);                                          \
+                return;                                                                            \
+            }                                                                                      \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            while ((run < end) && (CMP(&a[run + 1], &a[run]) >= 0))                                \
+                run++;                                                                             \
+            if (run == end)                                                                        \
+                return;                                                                            \
+        }                                                                                          \
+                                                                                                   \
+        int bad_allowed = 0;                                                                       \
+        for (int n = end - start + 1; n > 0; n >>= 1)                                              \
+            bad_allowed++;                                                                         \
+        cArray_##T##_pdq_loop(a, start, end + 1, bad_allowed, true);                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Sort the whole array, see pdq_sort */                                                       \
+    static inline void cArray_##T##_sort(cArray_##T* vector)                                       \
+    {                                                                                              \
+        cArray_##T##_pdq_sort(vector, 0, vector->size - 1);                                        \
+    }                                                                                              \
+                                                                                                   \
+    /* Number of elements of the sorted base[0, len) that are < key, or <= key if right is set.    \
+     * Exponential search from the start (or the end if from_end is set) then binary search, so    \
+     * finding k costs O(log k) comparisons instead of O(log len) */                               \
+    static inline int cArray_##T##_gallop(                                                         \
+        const T* key, const T* base, const int len, const bool right, const bool from_end)         \
+    {                                                                                              \
+        /* base[i] comes before key <=> CMP(&base[i], key) < right */                              \
+        const int bound = right ? 1 : 0;                                                           \
+        int lo, hi;                                                                                \
+        if (len <= 0)                                                                              \
+            return 0;                                                                              \
+        if (! from_end)                                                                            \
+        {                                                                                          \
+            if (CMP(&base[0], key) >= bound)                                                       \
+                return 0;                                                                          \
+            int last = 0, ofs = 1;                                                                 \
+            while ((ofs < len) && (CMP(&base[ofs], key) < bound))                                  \
+            {                                                                                      \
+                last = ofs;                                                                        \
+                ofs = (ofs > len / 2) ? len : (2 * ofs) + 1;                                       \
+            }                                                                                      \
+            lo = last + 1;                                                                         \
+            hi = (ofs < len) ? ofs : len;                                                          \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            if (CMP(&base[len - 1], key) < bound)                                                  \
+                return len;                                                                        \
+            int last = len - 1, ofs = 1;                                                           \
+            while ((ofs < len) && (CMP(&base[len - 1 - ofs], key) >= bound))                       \
+            {                                                                                      \
+                last = len - 1 - ofs;                                                              \
+                ofs = (ofs > len / 2) ? len : (2 * ofs) + 1;                                       \
+            }                                                                                      \
+            lo = (ofs < len) ? len - ofs : 0;                                                      \
+            hi = last;                                                                             \
+        }                                                                                          \
+        while (lo < hi)                                                                            \
+        {                                                                                          \
+            const int mid = lo + ((hi - lo) / 2);                                                  \
+            if (CMP(&base[mid], key) < bound)                                                      \
+                lo = mid + 1;                                                                      \
+            else                                                                                   \
+                hi = mid;                                                                          \
+        }                                                                                          \
+        return lo;                                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    static inline void cArray_##T##_reverse_range(T* a, int lo, int hi)                            \
+    {                                                                                              \
+        while (lo < hi)                                                                            \
+            cArray_##T##_swap(&a[lo++], &a[hi--]);                                                 \
+    }                                                                                              \
+                                                                                                   \
+    /* Length of the run starting at a[lo] (bounded by hi), a strictly descending run is reversed  \
+     * in place so every run is ascending. Strict, so reversing keeps equal elements in order */   \
+    static inline int cArray_##T##_tim_count_run(T* a, const int lo, const int hi)                 \
+    {                                                                                              \
+        int i = lo + 1;                                                                            \
+        if (i >= hi)                                                                               \
+            return 1;                                                                              \
+        if (CMP(&a[i], &a[lo]) < 0)                                                                \
+        {                                                                                          \
+            while ((i + 1 < hi) && (CMP(&a[i + 1], &a[i]) < 0))                                    \
+                i++;                                                                               \
+            cArray_##T##_reverse_range(a, lo, i);                                                  \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            while ((i + 1 < hi) && (CMP(&a[i + 1], &a[i]) >= 0))                                   \
+                i++;                                                                               \
+        }                                                                                          \
+        return i - lo + 1;                                                                         \
+    }                                                                                              \
+                                                                                                   \
+    /* Stable binary insertion sort of a[lo, hi) where a[lo, sorted) is already sorted */          \
+    static inline void cArray_##T##_tim_binary_insertion(                                          \
+        T* a, const int lo, const int hi, int sorted)                                              \
+    {                                                                                              \
+        for (; sorted < hi; sorted++)                                                              \
+        {                                                                                          \
+            T key;                                                                                 \
+            CPY(&key, &a[sorted]);                                                                 \
+            int left = lo, right = sorted;                                                         \
+            while (left < right)                                                                   \
+            {                                                                                      \
+                const int mid = left + ((right - left) / 2);                                       \
+                if (CMP(&key, &a[mid]) < 0)                                                        \
+                    right = mid;                                                                   \
+                else                                                                               \
+                    left = mid + 1;                                                                \
+            }                                                                                      \
+            for (int j = sorted; j > left; j--)                                                    \
+                CPY(&a[j], &a[j - 1]);                                                             \
+            CPY(&a[left], &key);                                                                   \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Merge a[base1, +len1) and the following a[base2, +len2) with len1 <= len2, run1 is copied   \
+     * to tmp. Requires a[base2] < a[base1] and a[base1 + len1 - 1] > a[base2 + len2 - 1] (the     \
+     * trimming in tim_merge_at ensures this). Switches to galloping when one run keeps winning */ \
+    static inline void cArray_##T##_tim_merge_lo(T* a, const int base1, const int len1,            \
+                                                 const int base2, const int len2, T* tmp,          \
+                                                 int* min_gallop)                                  \
+    {                                                                                              \
+        for (int i = 0; i < len1; i++)                                                             \
+            CPY(&tmp[i], &a[base1 + i]);                                                           \
+        int c1 = 0, c2 = base2, dest = base1;                                                      \
+        const int end2 = base2 + len2;                                                             \
+                                                                                                   \
+        CPY(&a[dest++], &a[c2++]);                                                                 \
+        if (c2 == end2)                                                                            \
+            goto done;                                                                             \
+        while (true)                                                                               \
+        {                                                                                          \
+            int count1 = 0, count2 = 0;                                                            \
+            /* One element at a time until a run wins min_gallop times in a row */                 \
+            do                                                                                     \
+            {                                                                                      \
+                if (CMP(&a[c2], &tmp[c1]) < 0)                                                     \
+                {                                                                                  \
+                    CPY(&a[dest++], &a[c2++]);                                                     \
+                    count2++;                                                                      \
+                    count1 = 0;                                                                    \
+                    if (c2 == end2)                                                                \
+                        goto done;                                                                 \
+                }                                                                                  \
+                else                                                                               \
+                {                                                                                  \
+                    CPY(&a[dest++], &tmp[c1++]);                                                   \
+                    count1++;                                                                      \
+                    count2 = 0;                                                                    \
+                    if (c1 == len1)                                                                \
+                        goto done;                                                                 \
+                }                                                                                  \
+            } while ((count1 | count2) < *min_gallop);                                             \
+                                                                                                   \
+            /* Gallop: count the elements taken in a row from each run with exponential search */  \
+            do                                                                                     \
+            {                                                                                      \
+                count1 = cArray_##T##_gallop(&a[c2], &tmp[c1], len1 - c1, true, false);            \
+                for (int k = 0; k < count1; k++)                                                   \
+                    CPY(&a[dest++], &tmp[c1++]);                                                   \
+                if (c1 == len1)                                                                    \
+                    goto done;                                                                     \
+                CPY(&a[dest++], &a[c2++]);                                                         \
+                if (c2 == end2)                                                                    \
+                    goto done;                                                                     \
+                                                                                                   \
+                count2 = cArray_##T##_gallop(&tmp[c1], &a[c2], end2 - c2, false, false);           \
+                for (int k = 0; k < count2; k++)                                                   \
+                    CPY(&a[dest++], &a[c2++]);                                                     \
+                if (c2 == end2)                                                                    \
+                    goto done;                                                                     \
+                CPY(&a[dest++], &tmp[c1++]);                                                       \
+                if (c1 == len1)                                                                    \
+                    goto done;                                                                     \
+                                                                                                   \
+                if (*min_gallop > 1)                                                               \
+                    (*min_gallop)--;                                                               \
+            } while ((count1 >= CARRAY_TIM_MIN_GALLOP) || (count2 >= CARRAY_TIM_MIN_GALLOP));      \
+            /* Galloping stopped paying off, make it harder to get back into */                    \
+            (*min_gallop) += 2;                                                                    \
+        }                                                                                          \
+                                                                                                   \
+    done:                                                                                          \
+        /* If run2 ran out the rest of run1 goes last, else run2's tail is in place already */     \
+        while (c1 < len1)                                                                          \
+            CPY(&a[dest++], &tmp[c1++]);                                                           \
+    }                                                                                              \
+                                                                                                   \
+    /* Mirror of tim_merge_lo for len1 > len2, run2 is copied to tmp and merged backwards */       \
+    static inline void cArray_##T##_tim_merge_hi(T* a, const int base1, const int len1,            \
+                                                 const int base2, const int len2, T* tmp,          \
+                                                 int* min_gallop)                                  \
+    {                                                                                              \
+        for (int i = 0; i < len2; i++)                                                             \
+            CPY(&tmp[i], &a[base2 + i]);                                                           \
+        int c1 = base1 + len1 - 1, c2 = len2 - 1, dest = base2 + len2 - 1;                         \
+                                                                                                   \
+        CPY(&a[dest--], &a[c1--]);                                                                 \
+        if (c1 < base1)                                                                            \
+            goto done;                                                                             \
+        while (true)                                                                               \
+        {                                                                                          \
+            int count1 = 0, count2 = 0;                                                            \
+            do                                                                                     \
+            {                                                                                      \
+                if (CMP(&tmp[c2], &a[c1]) < 0)                                                     \
+                {                                                                                  \
+                    CPY(&a[dest--], &a[c1--]);                                                     \
+                    count1++;                                                                      \
+                    count2 = 0;                                                                    \
+                    if (c1 < base1)                                                                \
+                        goto done;                                                                 \
+                }                                                                                  \
+                else                                                                               \
+                {                                                                                  \
+                    CPY(&a[dest--], &tmp[c2--]);                                                   \
+                    count2++;                                                                      \
+                    count1 = 0;                                                                    \
+                    if (c2 < 0)                                                                    \
+                        goto done;                                                                 \
+                }                                                                                  \
+            } while ((count1 | count2) < *min_gallop);                                             \
+                                                                                                   \
+            do                                                                                     \
+            {                                                                                      \
+                const int left1 = c1 - base1 + 1;                                                  \
+                count1 = left1 - cArray_##T##_gallop(&tmp[c2], &a[base1], left1, true, true);      \
+                for (int k = 0; k < count1; k++)                                                   \
+                    CPY(&a[dest--], &a[c1--]);                                                     \
+                if (c1 < base1)                                                                    \
+                    goto done;                                                                     \
+                CPY(&a[dest--], &tmp[c2--]);                                                       \
+                if (c2 < 0)                                                                        \
+                    goto done;                                                                     \
+                                                                                                   \
+                count2 = (c2 + 1) - cArray_##T##_gallop(&a[c1], tmp, c2 + 1, false, true);         \
+                for (int k = 0; k < count2; k++)                                                   \
+                    CPY(&a[dest--], &tmp[c2--]);                                                   \
+                if (c2 < 0)                                                                        \
+                    goto done;                                                                     \
+                CPY(&a[dest--], &a[c1--]);                                                         \
+                if (c1 < base1)                                                                    \
+                    goto done;                                                                     \
+                                                                                                   \
+                if (*min_gallop > 1)                                                               \
+                    (*min_gallop)--;                                                               \
+            } while ((count1 >= CARRAY_TIM_MIN_GALLOP) || (count2 >= CARRAY_TIM_MIN_GALLOP));      \
+            (*min_gallop) += 2;                                                                    \
+        }                                                                                          \
+                                                                                                   \
+    done:                                                                                          \
+        while (c2 >= 0)                                                                            \
+            CPY(&a[dest--], &tmp[c2--]);                                                           \
+    }                                                                                              \
+                                                                                                   \
+    /* Stable merge of a[first, middle) and a[middle, last) without a buffer: split the larger run \
+     * in half, binary search the matching cut in the other run and rotate the middle pieces.      \
+     * O(n log n) moves, only used when no scratch buffer is given */                              \
+    static inline void cArray_##T##_tim_merge_in_place(T* a, int first, int middle, int last)      \
+    {                                                                                              \
+        while ((first < middle) && (middle < last))                                                \
+        {                                                                                          \
+            if (last - first == 2)                                                                 \
+            {                                                                                      \
+                if (CMP(&a[middle], &a[first]) < 0)                                                \
+                    cArray_##T##_swap(&a[first], &a[middle]);                                      \
+                return;                                                                            \
+            }                                                                                      \
+            int cut1, cut2;                                                                        \
+            if (middle - first > last - middle)                                                    \
+            {                                                                                      \
+                cut1 = first + ((middle - first) / 2);                                             \
+                cut2 = middle +                                                                    \
+                       cArray_##T##_gallop(&a[cut1], &a[middle], last - middle, false, false);     \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                cut2 = middle + ((last - middle) / 2);                                             \
+                cut1 =                                                                             \
+                    first + cArray_##T##_gallop(&a[cut2], &a[first], middle - first, true, false); \
+            }                                                                                      \
+            /* Rotate [cut1, middle) [middle, cut2) into [middle, cut2) [cut1, middle) */          \
+            cArray_##T##_reverse_range(a, cut1, middle - 1);                                       \
+            cArray_##T##_reverse_range(a, middle, cut2 - 1);                                       \
+            cArray_##T##_reverse_range(a, cut1, cut2 - 1);                                         \
+            const int new_middle = cut1 + (cut2 - middle);                                         \
+                                                                                                   \
+            /* Recurse into the smaller half, loop on the larger one */                            \
+            if ((new_middle - first) < (last - new_middle))                                        \
+            {                                                                                      \
+                cArray_##T##_tim_merge_in_place(a, first, cut1, new_middle);                       \
+                first = new_middle;                                                                \
+                middle = cut2;                                                                     \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                cArray_##T##_tim_merge_in_place(a, new_middle, cut2, last);                        \
+                last = new_middle;                                                                 \
+                middle = cut1;                                                                     \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Merge the adjacent runs a[base1, +len1) and a[base2, +len2) */                              \
+    static inline void cArray_##T##_tim_merge_at(T* a, int base1, int len1, const int base2,       \
+                                                 int len2, T* tmp, int* min_gallop)                \
+    {                                                                                              \
+        /* Elements of run1 <= run2[0] and elements of run2 >= the last of run1 are in place       \
+         * already, on partially sorted data this usually leaves little or nothing to merge */     \
+        const int skip = cArray_##T##_gallop(&a[base2], &a[base1], len1, true, false);             \
+        base1 += skip;                                                                             \
+        len1 -= skip;                                                                              \
+        if (len1 == 0)                                                                             \
+            return;                                                                                \
+        len2 = cArray_##T##_gallop(&a[base1 + len1 - 1], &a[base2], len2, false, true);            \
+        if (len2 == 0)                                                                             \
+            return;                                                                                \
+                                                                                                   \
+        if (! tmp)                                                                                 \
+            cArray_##T##_tim_merge_in_place(a, base1, base2, base2 + len2);                        \
+        else if (len1 <= len2)                                                                     \
+            cArray_##T##_tim_merge_lo(a, base1, len1, base2, len2, tmp, min_gallop);               \
+        else                                                                                       \
+            cArray_##T##_tim_merge_hi(a, base1, len1, base2, len2, tmp, min_gallop);               \
+    }                                                                                              \
+                                                                                                   \
+    /* Powersort merge priority of the boundary between run1 (starting s1 elements into a range    \
+     * of n) and the following run2: the depth of the boundary's midpoint in a perfectly balanced  \
+     * merge tree. Merging while the previous boundary has a higher power keeps it near-optimal */ \
+    static inline int cArray_##T##_tim_power(                                                      \
+        const int s1, const int n1, const int n2, const int n)                                     \
+    {                                                                                              \
+        long long a = (2LL * s1) + n1;                                                             \
+        long long b = a + n1 + n2;                                                                 \
+        int power = 0;                                                                             \
+        while (true)                                                                               \
+        {                                                                                          \
+            power++;                                                                               \
+            if (a >= n)                                                                            \
+            {                                                                                      \
+                a -= n;                                                                            \
+                b -= n;                                                                            \
+            }                                                                                      \
+            else if (b >= n)                                                                       \
+            {                                                                                      \
+                break;                                                                             \
+            }                                                                                      \
+            a <<= 1;                                                                               \
+            b <<= 1;                                                                               \
+        }                                                                                          \
+        return power;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    /*                                                                                             \
+     * Stable sort of the array between start and end (inclusive) with TimSort (powersort merge    \
+     * policy). Natural ascending and descending runs are detected and merged with galloping, so   \
+     * already sorted or append-mostly data costs close to O(n).                                   \
+     * scratch must hold CARRAY_TIM_SCRATCH(end - start + 1) elements. With scratch = NULL the     \
+     * runs are merged in place with rotations (no extra memory, O(n log^2 n), still stable).      \
+     */                                                                                            \
+    static inline void cArray_##T##_tim_sort(                                                      \
+        cArray_##T* vector, const int start, const int end, T* scratch)                            \
+    {                                                                                              \
+        CSTATS_TIME_SCOPE(cArray_##T##_stats_data, sort);                                          \
+        if ((start < 0) || (end >= vector->size) || (start >= end))                                \
+            return;                                                                                \
+        T* a = vector->array;                                                                      \
+        const int n = end - start + 1;                                                             \
+                                                                                                   \
+        /* Short runs are extended to min_run (in [32, 64]) with binary insertion, chosen so       \
+         * n / min_run is close to a power of two */                                               \
+        int min_run = n, low_bit = 0;                                                              \
+        while (min_run >= 64)                                                                      \
+        {                                                                                          \
+            low_bit |= min_run & 1;                                                                \
+            min_run >>= 1;                                                                         \
+        }                                                                                          \
+        min_run += low_bit;                                                                        \
+                                                                                                   \
+        /* Pending runs, powers strictly increase up the stack so it holds at most log2(n) + 2 */  \
+        int run_base[CARRAY_TIM_MAX_RUNS], run_len[CARRAY_TIM_MAX_RUNS];                           \
+        int run_power[CARRAY_TIM_MAX_RUNS];                                                        \
+        int top = 0, min_gallop = CARRAY_TIM_MIN_GALLOP;                                           \
+                                                                                                   \
+        for (int lo = start; lo <= end;)                                                           \
+        {                                                                                          \
+            int len = cArray_##T##_tim_count_run(a, lo, end + 1);                                  \
+            if (len < min_run)                                                                     \
+            {                                                                                      \
+                const int forced = (end + 1 - lo < min_run) ? end + 1 - lo : min_run;              \
+                cArray_##T##_tim_binary_insertion(a, lo, lo + forced, lo + len);                   \
+                len = forced;                                                                      \
+            }                                                                                      \
+            if (top > 0)                                                                           \
+            {                                                                                      \
+                const int power =                                                                  \
+                    cArray_##T##_tim_power(run_base[top - 1] - start, run_len[top - 1], len, n);   \
+                while ((top > 1) && (run_power[top - 2] > power))                                  \
+                {                                                                                  \
+                    cArray_##T##_tim_merge_at(a,                                                   \
+                                              run_base[top - 2],                                   \
+                                              run_len[top - 2],                                    \
+                                              run_base[top - 1],                                   \
+                                              run_len[top - 1],                                    \
+                                              scratch,                                             \
+                                              &min_gallop);                                        \
+                    run_len[top - 2] += run_len[top - 1];                                          \
+                    top--;                                                                         \
+                }                                                                                  \
+                run_power[top - 1] = power;                                                        \
+            }                                                                                      \
+            run_base[top] = lo;                                                                    \
+            run_len[top] = len;                                                                    \
+            top++;                                                                                 \
+            lo += len;                                                                             \
+        }                                                                                          \
+        while (top > 1)                                                                            \
+        {                                                                                          \
+            cArray_##T##_tim_merge_at(a, run_base[top - 2], run_len[top - 2], run_base[top - 1],   \
+                                      run_len[top - 1], scratch, &min_gallop);                     \
+            run_len[top - 2] += run_len[top - 1];                                                  \
+            top--;                                                                                 \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Number of elements of the sorted batch[0, n) that are new to the sorted array: not equal to \
+     * an element of the array nor to the previous element of the batch. O(K log(n / K)) */        \
+    static inline int cArray_##T##_count_new_sorted(                                               \
+        const cArray_##T* vector, const T* batch, const int n)                                     \
+    {                                                                                              \
+        int count = 0, pos = 0;                                                                    \
+        for (int j = 0; j < n; j++)                                                                \
+        {                                                                                          \
+            if ((j > 0) && (CMP(&batch[j - 1], &batch[j]) == 0))                                   \
+                continue;                                                                          \
+            pos += cArray_##T##_gallop(&batch[j], &vector->array[pos], vector->size - pos, false,  \
+                                       false);                                                     \
+            count += (pos >= vector->size) || (CMP(&vector->array[pos], &batch[j]) != 0);          \
+        }                                                                                          \
+        return count;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    /* Insert the n elements of batch (which must be sorted) into the sorted array in one pass,    \
+     * the array stays sorted and new elements go after the equal elements already there. With     \
+     * unique set, elements equal to one of the array or to another one of the batch are only      \
+     * inserted once. Returns false (and changes nothing) if they do not fit.                      \
+     * Merges from the back: the elements greater than the last batch element are moved up once    \
+     * as a block, found with a gallop from the end, so O(K log n + moved elements) instead of K   \
+     * shifts with binsert */                                                                      \
+    static inline bool cArray_##T##_merge_insert_sorted(                                           \
+        cArray_##T* vector, const T* batch, const int n, const bool unique)                        \
+    {                                                                                              \
+        if (n <= 0)                                                                                \
+            return true;                                                                           \
+        const int count = unique ? cArray_##T##_count_new_sorted(vector, batch, n) : n;            \
+        CSTATS_ADD(cArray_##T##_stats_data, failed_pushes,                                         \
+                   count > vector->capacity - vector->size);                                       \
+        if (count > vector->capacity - vector->size)                                               \
+            return false;                                                                          \
+        T* a = vector->array;                                                                      \
+        int i = vector->size - 1;           /* last element of the array not moved yet */          \
+        int out = vector->size + count - 1; /* next slot to fill */                                \
+        for (int j = n - 1; j >= 0; j--)                                                           \
+        {                                                                                          \
+            if (unique && (j > 0) && (CMP(&batch[j - 1], &batch[j]) == 0))                         \
+                continue;                                                                          \
+            const int keep = cArray_##T##_gallop(&batch[j], a, i + 1, true, true);                 \
+            cArray_##T##_move_n(&a[out - (i - keep)], &a[keep], i + 1 - keep);                     \
+            out -= i + 1 - keep;                                                                   \
+            i = keep - 1;                                                                          \
+            if (unique && (i >= 0) && (CMP(&a[i], &batch[j]) == 0))                                \
+                continue;                                                                          \
+            CPY(&a[out], &batch[j]);                                                               \
+            out--;                                                                                 \
+        }                                                                                          \
+        vector->size += count;                                                                     \
+        CSTATS_MAX(cArray_##T##_stats_data, high_water, vector->size);                             \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Sort batch (in place, with pdqsort) and merge it into the sorted array, see                 \
+     * merge_insert_sorted. O(n + K log K) against O(K * n) for K binsert calls */                 \
+    static inline bool cArray_##T##_binsert_batch(                                                 \
+        cArray_##T* vector, T* batch, const int n, const bool unique)                              \
+    {                                                                                              \
+        cArray_##T sorted;                                                                         \
+        cArray_##T##_init_from_buffer(&sorted, batch, n);                                          \
+        sorted.size = n;                                                                           \
+        cArray_##T##_pdq_sort(&sorted, 0, n - 1);                                                  \
+        return cArray_##T##_merge_insert_sorted(vector, batch, n, unique);                         \
+    }                                                                                              \
+                                                                                                   \
+    static inline void cArray_##T##_select(T* a, int begin, int end, const int nth);               \
+                                                                                                   \
+    /* Pivot of a[begin, end) with a guaranteed 30% / 70% split: the median of the medians of      \
+     * groups of 5 (BFPRT), found by a recursive select. The medians are gathered at the start of  \
+     * the range, the pivot is moved to a[begin] */                                                \
+    static inline void cArray_##T##_median_of_medians(T* a, const int begin, const int end)        \
+    {                                                                                              \
+        int groups = 0;                                                                            \
+        for (int i = begin; i < end; i += 5)                                                       \
+        {                                                                                          \
+            const int group_end = (i + 5 < end) ? i + 5 : end;                                     \
+            cArray_##T##_pdq_insertion(a, i, group_end);                                           \
+            cArray_##T##_swap(&a[begin + groups], &a[i + ((group_end - i - 1) / 2)]);              \
+            groups++;                                                                              \
+        }                                                                                          \
+        const int mid = begin + ((groups - 1) / 2);                                                \
+        cArray_##T##_select(a, begin, begin + groups, mid);                                        \
+        cArray_##T##_swap(&a[begin], &a[mid]);                                                     \
+    }                                                                                              \
+                                                                                                   \
+    /* Introselect of a[begin, end): quickselect with the pdqsort pivots and partitions, which     \
+     * switches to median of medians pivots once the partitions have scanned CARRAY_SELECT_WORK    \
+     * times the range, so the worst case stays O(n). Runs of elements equal to a lower bound are  \
+     * split off at once */                                                                        \
+    static inline void cArray_##T##_select(T* a, int begin, int end, const int nth)                \
+    {                                                                                              \
+        bool leftmost = true;                                                                      \
+        /* Elements left to partition before giving up on quickselect pivots */                    \
+        int64_t budget = (int64_t) CARRAY_SELECT_WORK * (end - begin);                             \
+        while (end - begin >= CARRAY_PDQ_INSERTION_THRESHOLD)                                      \
+        {                                                                                          \
+            budget -= end - begin;                                                                 \
+            if (budget >= 0)                                                                       \
+                cArray_##T##_pdq_choose_pivot(a, begin, end);                                      \
+            else                                                                                   \
+                cArray_##T##_median_of_medians(a, begin, end);                                     \
+                                                                                                   \
+            /* a[begin - 1] <= every element of the range: if the pivot equals it, so does         \
+             * everything partition_left puts on its left */                                       \
+            if (! leftmost && (CMP(&a[begin - 1], &a[begin]) >= 0))                                \
+            {                                                                                      \
+                const int last = cArray_##T##_pdq_partition_left(a, begin, end);                   \
+                if (nth <= last)                                                                   \
+                    return;                                                                        \
+                begin = last + 1;                                                                  \
+                continue;                                                                          \
+            }                                                                                      \
+            bool already_partitioned;                                                              \
+            const int pivot_pos =                                                                  \
+                cArray_##T##_pdq_partition_right(a, begin, end, &already_partitioned);             \
+            if (nth == pivot_pos)                                                                  \
+                return;                                                                            \
+            if (nth < pivot_pos)                                                                   \
+            {                                                                                      \
+                end = pivot_pos;                                                                   \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                begin = pivot_pos + 1;                                                             \
+                leftmost = false;                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        cArray_##T##_pdq_insertion(a, begin, end);                                                 \
+    }                                                                                              \
+                                                                                                   \
+    /**                                                                                            \
+     * Reorder the range [start, end] so that a[nth] is the element a full sort would put there,   \
+     * with no greater element before it and no smaller one after it. O(n) worst case, no heap     \
+     * allocation. nth is an index of the array, start <= nth <= end                               \
+     */                                                                                            \
+    static inline void cArray_##T##_nth_element(                                                   \
+        cArray_##T* vector, const int start, const int end, const int nth)                         \
+    {                                                                                              \
+        CSTATS_TIME_SCOPE(cArray_##T##_stats_data, sort);                                          \
+        if ((start < 0) || (end >= vector->size) || (nth < start) || (nth > end))                  \
+            return;                                                                                \
+        cArray_##T##_select(vector->array, start, end + 1, nth);                                   \
+    }                                                                                              \
+                                                                                                   \
+    /* Sift down in the min-heap a[begin, begin + size), the mirror of sift_down */                \
+    static inline void cArray_##T##_sift_down_min(T* a, const int begin, int root, const int size) \
+    {                                                                                              \
+        T value;                                                                                   \
+        CPY(&value, &a[begin + root]);                                                             \
+        int child;                                                                                 \
+        while ((child = (2 * root) + 1) < size)                                                    \
+        {                                                                                          \
+            if ((child + 1 < size) && (CMP(&a[begin + child], &a[begin + child + 1]) > 0))         \
+                child++;                                                                           \
+            if (CMP(&value, &a[begin + child]) <= 0)                                               \
+                break;                                                                             \
+            CPY(&a[begin + root], &a[begin + child]);                                              \
+            root = child;                                                                          \
+        }                                                                                          \
+        CPY(&a[begin + root], &value);                                                             \
+    }                                                                                              \
+                                                                                                   \
+    /**                                                                                            \
+     * Move the k smallest elements of [start, end] to [start, start + k), sorted in ascending     \
+     * order. The rest of the range is left in no particular order.                                \
+     * For k up to n >> CARRAY_PARTIAL_HEAP_SHIFT the first k elements become a max-heap and       \
+     * every other element is checked against its top in one pass: O(n log k). Larger k select     \
+     * then sort, O(n + k log k). No heap allocation                                               \
+     */                                                                                            \
+    static inline void cArray_##T##_partial_sort(                                                  \
+        cArray_##T* vector, const int start, const int end, const int k)                           \
+    {                                                                                              \
+        CSTATS_TIME_SCOPE(cArray_##T##_stats_data, sort);                                          \
+        if ((start < 0) || (end >= vector->size) || (k <= 0) || (k > end - start + 1))             \
+            return;                                                                                \
+        T* a = vector->array;                                                                      \
+        if (k > ((end - start + 1) >> CARRAY_PARTIAL_HEAP_SHIFT))                                  \
+        {                                                                                          \
+            cArray_##T##_select(a, start, end + 1, start + k - 1);                                 \
+            cArray_##T##_pdq_sort(vector, start, start + k - 2);                                   \
+            return;                                                                                \
+        }                                                                                          \
+        for (int i = (k / 2) - 1; i >= 0; i--)                                                     \
+            cArray_##T##_sift_down(a, start, i, k);                                                \
+        for (int i = start + k; i <= end; i++)                                                     \
+        {                                                                                          \
+            if (CMP(&a[i], &a[start]) < 0)                                                         \
+            {                                                                                      \
+                cArray_##T##_swap(&a[i], &a[start]);                                               \
+                cArray_##T##_sift_down(a, start, 0, k);                                            \
+            }                                                                                      \
+        }                                                                                          \
+        for (int n = k - 1; n > 0; n--)                                                            \
+        {                                                                                          \
+            cArray_##T##_swap(&a[start], &a[start + n]);                                           \
+            cArray_##T##_sift_down(a, start, 0, n);                                                \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /**                                                                                            \
+     * Move the k largest elements of [start, end] to [start, start + k), sorted in descending     \
+     * order (a top-k list). Like partial_sort with a min-heap for small k. For larger k the k     \
+     * largest are selected and sorted at the end of the range, which is then reversed             \
+     */                                                                                            \
+    static inline void cArray_##T##_top_k(                                                         \
+        cArray_##T* vector, const int start, const int end, const int k)                           \
+    {                                                                                              \
+        CSTATS_TIME_SCOPE(cArray_##T##_stats_data, sort);                                          \
+        if ((start < 0) || (end >= vector->size) || (k <= 0) || (k > end - start + 1))             \
+            return;                                                                                \
+        T* a = vector->array;                                                                      \
+        if (k > ((end - start + 1) >> CARRAY_PARTIAL_HEAP_SHIFT))                                  \
+        {                                                                                          \
+            cArray_##T##_select(a, start, end + 1, end - k + 1);                                   \
+            cArray_##T##_pdq_sort(vector, end - k + 2, end);                                       \
+            cArray_##T##_reverse(vector, start, end);                                              \
+            return;                                                                                \
+        }                                                                                          \
+        for (int i = (k / 2) - 1; i >= 0; i--)                                                     \
+            cArray_##T##_sift_down_min(a, start, i, k);                                            \
+        for (int i = start + k; i <= end; i++)                                                     \
+        {                                                                                          \
+            if (CMP(&a[i], &a[start]) > 0)                                                         \
+            {                                                                                      \
+                cArray_##T##_swap(&a[i], &a[start]);                                               \
+                cArray_##T##_sift_down_min(a, start, 0, k);                                        \
+            }                                                                                      \
+        }                                                                                          \
+        for (int n = k - 1; n > 0; n--)                                                            \
+        {                                                                                          \
+            cArray_##T##_swap(&a[start], &a[start + n]);                                           \
+            cArray_##T##_sift_down_min(a, start, 0, n);                                            \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /**                                                                                            \
+     * Smallest and largest element of the range [start, end] in one pass, copied to min and max   \
+     * (either may be NULL). Uses 3 CMP calls per 2 elements, or the cSimd minmax kernels when     \
+     * FLAGS has CARRAY_NATURAL_ORDER. Returns false if the range is invalid                       \
+     */                                                                                            \
+    static inline bool cArray_##T##_minmax(                                                        \
+        cArray_##T* vector, const int start, const int end, T* min, T* max)                        \
+    {                                                                                              \
+        if ((start < 0) || (end >= vector->size) || (start > end))                                 \
+            return false;                                                                          \
+        const T* a = vector->array;                                                                \
+        if (((FLAGS) & CARRAY_NATURAL_ORDER) && (CARRAY_SIMD_ELEM(T, FLAGS) >= 0))                 \
+        {                                                                                          \
+            T lo, hi;                                                                              \
+            cSimd_minmax(&a[start], (size_t) (end - start + 1), &lo, &hi,                          \
+                         (cSimd_elem) CARRAY_SIMD_ELEM(T, FLAGS), CARRAY_UNSIGNED(T));             \
+            if (min)                                                                               \
+                CPY(min, &lo);                                                                     \
+            if (max)                                                                               \
+                CPY(max, &hi);                                                                     \
+            return true;                                                                           \
+        }                                                                                          \
+        /* Order each pair first, then only its smaller element can be a new min and only its      \
+         * larger one a new max */                                                                 \
+        int lo = start, hi = start, i = start + 1;                                                 \
+        for (; i < end; i += 2)                                                                    \
+        {                                                                                          \
+            const bool ordered = CMP(&a[i], &a[i + 1]) <= 0;                                       \
+            const int small = ordered ? i : i + 1;                                                 \
+            const int large = ordered ? i + 1 : i;                                                 \
+            if (CMP(&a[small], &a[lo]) < 0)                                                        \
+                lo = small;                                                                        \
+            if (CMP(&a[large], &a[hi]) > 0)                                                        \
+                hi = large;                                                                        \
+        }                                                                                          \
+        if (i == end)                                                                              \
+        {                                                                                          \
+            if (CMP(&a[i], &a[lo]) < 0)                                                            \
+                lo = i;                                                                            \
+            else if (CMP(&a[i], &a[hi]) > 0)                                                       \
+                hi = i;                                                                            \
+        }                                                                                          \
+        if (min)                                                                                   \
+            CPY(min, &a[lo]);                                                                      \
+        if (max)                                                                                   \
+            CPY(max, &a[hi]);                                                                      \
+        return true;                                                                               \
+    }
+
+#ifdef CSTL_STATS
+
+/* What the cArray functions of one type did on the calling thread, see cArray_T_stats_get */
+typedef struct
+{
+    uint64_t comparisons;     // CMP calls
+    uint64_t copies;          // CPY calls
+    uint64_t shifts;          // elements moved by insert, delete and the other range functions
+    uint64_t failed_pushes;   // push, insert and their range variants refused for lack of room
+    uint64_t failed_enqueues; // enqueue calls on a full queue
+    uint64_t high_water;      // largest size reached
+    cStats_timer sort;        // sorts, nth_element, partial_sort and top_k
+} cArray_stats;
+
+/* Counters of cArray_T, per translation unit and per thread, and CPY / CMP wrappers counting
+ * their calls that CARRAY_GENERATE_BODY is generated with instead of CPY and CMP */
+#define CARRAY_GENERATE_STATS(T, CPY, CMP)                                                         \
+    static CSTL_THREAD_LOCAL cArray_stats cArray_##T##_stats_data;                                 \
+                                                                                                   \
+    static inline void cArray_##T##_counted_cpy(T* dest, const T* src)                             \
+    {                                                                                              \
+        cArray_##T##_stats_data.copies++;                                                          \
+        CPY(dest, src);                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    static inline int cArray_##T##_counted_cmp(const T* a, const T* b)                             \
+    {                                                                                              \
+        cArray_##T##_stats_data.comparisons++;                                                     \
+        return CMP(a, b);                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Snapshot of the counters of every cArray_T of the calling thread */                         \
+    static inline cArray_stats cArray_##T##_stats_get(void)                                        \
+    {                                                                                              \
+        return cArray_##T##_stats_data;                                                            \
+    }                                                                                              \
+                                                                                                   \
+    static inline void cArray_##T##_stats_reset(void)                                              \
+    {                                                                                              \
+        memset(&cArray_##T##_stats_data, 0, sizeof(cArray_stats));                                 \
+    }
+
+#define CARRAY_GENERATE_EX(T, CPY, CMP, FLAGS)                                                     \
+    CARRAY_GENERATE_STATS(T, CPY, CMP)                                                             \
+    CARRAY_GENERATE_BODY(T, cArray_##T##_counted_cpy, cArray_##T##_counted_cmp, FLAGS)
+
+#else
+
+#define CARRAY_GENERATE_EX(T, CPY, CMP, FLAGS) CARRAY_GENERATE_BODY(T, CPY, CMP, FLAGS)
+
+#endif // CSTL_STATS
+
+/* Generate the cArray for type T without FLAGS, see CARRAY_GENERATE_EX */
+#define CARRAY_GENERATE(T, CPY, CMP) CARRAY_GENERATE_EX(T, CPY, CMP, 0)
+
+#define CARRAY_PRIMITIVE_CPY(T)                                                                    \
+    static inline void T##_cpy(T* a, const T* b)                                                   \
+    {                                                                                              \
+        *a = *b;                                                                                   \
+    }
+
+#define CARRAY_PRIMITIVE_CMP(T)                                                                    \
+    static inline int T##_cmp(const T* a, const T* b)                                              \
+    {                                                                                              \
+        return ((*a > *b) - (*a < *b));                                                            \
+    }
+
+#define CARRAY_GENERATE_PRIMITIVE(T)                                                               \
+    CARRAY_PRIMITIVE_CPY(T)                                                                        \
+    CARRAY_PRIMITIVE_CMP(T)                                                                        \
+    CARRAY_GENERATE_EX(                                                                            \
+        T, T##_cpy, T##_cmp, CARRAY_KIND(T) | CARRAY_NATURAL_ORDER | CARRAY_TRIVIAL)
+
+/**
+ * Generate an LSD radix sort for a cArray of T (generated before with CARRAY_GENERATE)
+ * @param T type of the array
+ * @param CPY of signature void T_cpy(T* dest, const T* src)
+ * @param KEY of signature uint64_t T_key(const T* a), order preserving: a < b => key(a) <= key(b)
+ * @param KEY_BITS number of low bits of the key that can be non zero (at most 64)
+ * @param DIGIT_BITS bits sorted per pass, 8 / 11 / 16 are typical
+ *
+ * @note Histograms take (KEY_BITS / DIGIT_BITS) * 2^DIGIT_BITS * 4 bytes of stack, 16-bit digits
+ * (256KB per pass) are only worth it for narrow keys and very large arrays
+ */
+#define CARRAY_GENERATE_RADIX_DIGITS(T, CPY, KEY, KEY_BITS, DIGIT_BITS)                            \
+    /* Stable LSD radix sort of the array between start and end (inclusive), scratch must hold     \
+     * end - start + 1 elements and is used as the other half of a ping-pong buffer.               \
+     * O(n * passes), passes whose digit is the same for every key are skipped. Falls back to the  \
+     * in-place tim_sort if scratch is NULL */                                                     \
+    static inline void cArray_##T##_radix_sort(                                                    \
+        cArray_##T* vector, const int start, const int end, T* scratch)                            \
+    {                                                                                              \
+        enum                                                                                       \
+        {                                                                                          \
+            passes = ((KEY_BITS) + (DIGIT_BITS) - 1) / (DIGIT_BITS),                               \
+            radix = 1 << (DIGIT_BITS)                                                              \
+        };                                                                                         \
+        CSTATS_TIME_SCOPE(cArray_##T##_stats_data, sort);                                          \
+        if ((start < 0) || (end >= vector->size) || (start >= end))                                \
+            return;                                                                                \
+        if (! scratch)                                                                             \
+        {                                                                                          \
+            cArray_##T##_tim_sort(vector, start, end, NULL);                                       \
+            return;                                                                                \
+        }                                                                                          \
+        const int n = end - start + 1;                                                             \
+        T* src = &vector->array[start];                                                            \
+        T* dst = scratch;                                                                          \
+                                                                                                   \
+        /* Histograms of every digit in a single read of the keys */                               \
+        uint32_t count[passes][radix];                                                             \
+        memset(count, 0, sizeof(count));                                                           \
+        for (int i = 0; i < n; i++)                                                                \
+        {                                                                                          \
+            const uint64_t key = KEY(&src[i]);                                                     \
+            for (int p = 0; p < passes; p++)                                                       \
+                count[p][(key >> (p * (DIGIT_BITS))) & (radix - 1)]++;                             \
+        }                                                                                          \
+                                                                                                   \
+        const uint64_t first_key = KEY(&src[0]);                                                   \
+        for (int p = 0; p < passes; p++)                                                           \
+        {                                                                                          \
+            const int shift = p * (DIGIT_BITS);                                                    \
+            /* Every key has the same digit here, the pass would not move anything */              \
+            if (count[p][(first_key >> shift) & (radix - 1)] == (uint32_t) n)                      \
+                continue;                                                                          \
+                                                                                                   \
+            uint32_t offset = 0;                                                                   \
+            for (int d = 0; d < radix; d++)                                                        \
+            {                                                                                      \
+                const uint32_t c = count[p][d];                                                    \
+                count[p][d] = offset;                                                              \
+                offset += c;                                                                       \
+            }                                                                                      \
+            for (int i = 0; i < n; i++)                                                            \
+            {                                                                                      \
+                const int d = (int) ((KEY(&src[i]) >> shift) & (radix - 1));                       \
+                CPY(&dst[count[p][d]++], &src[i]);                                                 \
+            }                                                                                      \
+            T* temp = src;                                                                         \
+            src = dst;                                                                             \
+            dst = temp;                                                                            \
+        }                                                                                          \
+                                                                                                   \
+        /* An odd number of passes left the result in scratch */                                   \
+        if (src == scratch)                                                                        \
+        {                                                                                          \
+            for (int i = 0; i < n; i++)                                                            \
+                CPY(&vector->array[start + i], &scratch[i]);                                       \
+        }                                                                                          \
+    }
+
+/* Generate a radix sort with CARRAY_RADIX_DIGIT_BITS bits per pass */
+#define CARRAY_GENERATE_RADIX(T, CPY, KEY, KEY_BITS)                                               \
+    CARRAY_GENERATE_RADIX_DIGITS(T, CPY, KEY, KEY_BITS, CARRAY_RADIX_DIGIT_BITS)
+
+/* Generate uint64_t T_radix_key(const T* a) for a primitive integer or floating point type.
+ * Signed integers get their sign bit flipped, floats are mapped with the usual bit trick
+ * (negatives fully inverted) so the unsigned key order matches the numeric order.
+ * NOTE: -0.0 sorts before +0.0, NaNs with the sign bit go first and the others last */
+#define CARRAY_RADIX_KEY_PRIMITIVE(T)                                                              \
+    static inline uint64_t T##_radix_key(const T* value)                                           \
+    {                                                                                              \
+        const unsigned bits = (unsigned) (sizeof(T) * 8);                                          \
+        const uint64_t sign = 1ULL << (bits - 1);                                                  \
+        const uint64_t mask = (bits >= 64) ? ~0ULL : ((1ULL << (bits % 64)) - 1);                  \
+        if ((T) 0.5 != (T) 0)                                                                      \
+        {                                                                                          \
+            uint64_t key = 0;                                                                      \
+            if (sizeof(T) == sizeof(uint32_t))                                                     \
+            {                                                                                      \
+                uint32_t key32;                                                                    \
+                memcpy(&key32, value, sizeof(key32));                                              \
+                key = key32;                                                                       \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                memcpy(&key, value, (sizeof(T) < sizeof(key)) ? sizeof(T) : sizeof(key));          \
+            }                                                                                      \
+            return (key & sign) ? (~key & mask) : (key | sign);                                    \
+        }                                                                                          \
+        const uint64_t key = (uint64_t) *value & mask;                                             \
+        return ((T) -1 < (T) 1) ? (key ^ sign) : key;                                              \
+    }
+
+/* Radix sort for a cArray generated with CARRAY_GENERATE_PRIMITIVE(T), T an integer type (up to
+ * 64 bits), float or double */
+#define CARRAY_GENERATE_RADIX_PRIMITIVE(T)                                                         \
+    CARRAY_RADIX_KEY_PRIMITIVE(T)                                                                  \
+    CARRAY_GENERATE_RADIX(T, T##_cpy, T##_radix_key, sizeof(T) * 8)
+
+/**
+ * Generate cArray_<T>_map_<name>(vector), calling FN on every element in place
+ * @param FN of signature void FN(T* a), a function or function-like macro
+ *
+ * @note Unlike cArray_<T>_map, FN is expanded into the loop, so it is inlined (and the loop can be
+ * vectorized) instead of paying an indirect call per element
+ */
+#define CARRAY_GENERATE_MAP(T, name, FN)                                                           \
+    static inline void cArray_##T##_map_##name(cArray_##T* vector)                                 \
+    {                                                                                              \
+        T* array = vector->array;                                                                  \
+        const int size = vector->size;                                                             \
+        for (int i = 0; i < size; i++)                                                             \
+            FN(&array[i]);                                                                         \
+    }
+
+/**
+ * Generate cArray_<T>_transform_<name>(src, dst), writing FN of every element of src to a cArray
+ * of U (generated before). Returns false (and does nothing) if dst->capacity < src->size
+ * @param FN of signature void FN(U* out, const T* in)
+ */
+#define CARRAY_GENERATE_TRANSFORM(T, U, name, FN)                                                  \
+    static inline bool cArray_##T##_transform_##name(const cArray_##T* src, cArray_##U* dst)       \
+    {                                                                                              \
+        if (dst->capacity < src->size)                                                             \
+            return false;                                                                          \
+        const T* in = src->array;                                                                  \
+        U* out = dst->array;                                                                       \
+        const int size = src->size;                                                                \
+        for (int i = 0; i < size; i++)                                                             \
+            FN(&out[i], &in[i]);                                                                   \
+        dst->size = size;                                                                          \
+        return true;                                                                               \
+    }
+
+/**
+ * Generate R cArray_<T>_reduce_<name>(vector, init), folding the elements from the first to the
+ * last with acc = FN(acc, &element)
+ * @param R type of the accumulator
+ * @param FN of signature R FN(R acc, const T* a)
+ *
+ * @note Integer sums vectorize as is, floating point sums only with -ffast-math (or
+ * -fassociative-math) since reordering them changes the rounding
+ */
+#define CARRAY_GENERATE_REDUCE(T, R, name, FN)                                                     \
+    static inline R cArray_##T##_reduce_##name(const cArray_##T* vector, R init)                   \
+    {                                                                                              \
+        const T* array = vector->array;                                                            \
+        const int size = vector->size;                                                             \
+        R acc = init;                                                                              \
+        for (int i = 0; i < size; i++)                                                             \
+            acc = FN(acc, &array[i]);                                                              \
+        return acc;                                                                                \
+    }
+
+/**
+ * Generate cArray_<T>_filter_<name>(vector), keeping (in order) only the elements for which PRED
+ * is true
+ * @param CPY of signature void T_cpy(T* dest, const T* src)
+ * @param PRED of signature bool PRED(const T* a)
+ *
+ * @note Branchless: every element is copied to the write position and the position only advances
+ * when PRED holds, so unpredictable predicates cost no mispredictions
+ */
+#define CARRAY_GENERATE_FILTER(T, CPY, name, PRED)                                                 \
+    static inline void cArray_##T##_filter_##name(cArray_##T* vector)                              \
+    {                                                                                              \
+        T* array = vector->array;                                                                  \
+        const int size = vector->size;                                                             \
+        int j = 0;                                                                                 \
+        for (int i = 0; i < size; i++)                                                             \
+        {                                                                                          \
+            const bool keep = PRED(&array[i]);                                                     \
+            if (i != j)                                                                            \
+                CPY(&array[j], &array[i]);                                                         \
+            j += keep;                                                                             \
+        }                                                                                          \
+        vector->size = j;                                                                          \
+    }
+
+/**
+ * Generate cArray_<T>_count_if_<name>, cArray_<T>_any_of_<name> and cArray_<T>_all_of_<name>
+ * @param PRED of signature bool PRED(const T* a)
+ */
+#define CARRAY_GENERATE_PREDICATE(T, name, PRED)                                                   \
+    /* Number of elements for which PRED is true */                                                \
+    static inline int cArray_##T##_count_if_##name(const cArray_##T* vector)                       \
+    {                                                                                              \
+        const T* array = vector->array;                                                            \
+        const int size = vector->size;                                                             \
+        int count = 0;                                                                             \
+        for (int i = 0; i < size; i++)                                                             \
+            count += PRED(&array[i]) ? 1 : 0;                                                      \
+        return count;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    /* True if PRED is true for at least one element. Blocks of CARRAY_SCAN_BLOCK elements are     \
+     * checked without early exit (vectorizable), stopping after the first block with a match */   \
+    static inline bool cArray_##T##_any_of_##name(const cArray_##T* vector)                        \
+    {                                                                                              \
+        const T* array = vector->array;                                                            \
+        const int size = vector->size;                                                             \
+        for (int block = 0; block < size; block += CARRAY_SCAN_BLOCK)                              \
+        {                                                                                          \
+            const int end = (size - block > CARRAY_SCAN_BLOCK) ? block + CARRAY_SCAN_BLOCK : size; \
+            bool found = false;                                                                    \
+            for (int i = block; i < end; i++)                                                      \
+                found |= (bool) PRED(&array[i]);                                                   \
+            if (found)                                                                             \
+                return true;                                                                       \
+        }                                                                                          \
+        return false;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    /* True if PRED is true for every element (and for an empty array) */                          \
+    static inline bool cArray_##T##_all_of_##name(const cArray_##T* vector)                        \
+    {                                                                                              \
+        const T* array = vector->array;                                                            \
+        const int size = vector->size;                                                             \
+        for (int block = 0; block < size; block += CARRAY_SCAN_BLOCK)                              \
+        {                                                                                          \
+            const int end = (size - block > CARRAY_SCAN_BLOCK) ? block + CARRAY_SCAN_BLOCK : size; \
+            bool all = true;                                                                       \
+            for (int i = block; i < end; i++)                                                      \
+                all &= (bool) PRED(&array[i]);                                                     \
+            if (! all)                                                                             \
+                return false;                                                                      \
+        }                                                                                          \
+        return true;                                                                               \
+    }
 
 /* Create a cArray of type T and T buffer[capacity] statically, the user must CARRAY_GENERATE(T,
  * CPY, CMP) before creating the cArray */
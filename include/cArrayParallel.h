@@ -0,0 +1,296 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * cArrayParallel - multi-threaded sort for large cArrays.
+ *
+ * The range is cut into one chunk per thread, every chunk is sorted with pdqsort, then the sorted
+ * chunks are merged pairwise in log2(threads) rounds. Each round is split evenly between all the
+ * threads with merge-path co-ranking (a binary search for where an output slice starts in both
+ * inputs), so the last merges keep every thread busy instead of one. Work is handed to an
+ * executor: the default one starts pthreads, or pass your own thread pool. Link with -pthread.
+ */
+
+#pragma once
+
+#ifndef CSTL_ARRAY_PARALLEL_H
+#define CSTL_ARRAY_PARALLEL_H
+
+#include <pthread.h>
+#include <stdbool.h>
+
+#include "cArray.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Max threads used by a parallel sort */
+#define CPARALLEL_MAX_THREADS 256
+
+/* Ranges smaller than this are sorted on the calling thread */
+#ifndef CARRAY_PARALLEL_THRESHOLD
+#define CARRAY_PARALLEL_THRESHOLD (1 << 16)
+#endif
+
+/* Min elements per thread, fewer threads are used for smaller ranges */
+#ifndef CARRAY_PARALLEL_MIN_CHUNK
+#define CARRAY_PARALLEL_MIN_CHUNK (1 << 14)
+#endif
+
+/*
+ * Something that runs tasks concurrently. run must call task(arg, i) once for every i in
+ * [0, count) (count <= num_threads), possibly in parallel, and return once all of them finished.
+ * Plug a thread pool in with your own run, e.g. with OpenMP:
+ *   static void omp_run(void* ctx, void (*task)(void*, int), void* arg, int count)
+ *   { _Pragma("omp parallel for") for (int i = 0; i < count; i++) task(arg, i); }
+ */
+typedef struct
+{
+    void (*run)(void* context, void (*task)(void*, int), void* arg, int count);
+    void* context;   // passed back to run, e.g. the pool
+    int num_threads; // max tasks run concurrently
+} cParallel_executor;
+
+typedef struct
+{
+    pthread_t thread;
+    void (*task)(void*, int);
+    void* arg;
+    int index;
+} cParallel_thread;
+
+static inline void* cParallel_thread_main(void* arg)
+{
+    cParallel_thread* thread = (cParallel_thread*) arg;
+    thread->task(thread->arg, thread->index);
+    return NULL;
+}
+
+/* Default run: one pthread per task, task 0 runs on the calling thread. A task whose thread
+ * cannot be created runs on the calling thread instead */
+static inline void cParallel_run_pthreads(void* context,
+                                          void (*task)(void*, int),
+                                          void* arg,
+                                          int count)
+{
+    cParallel_thread threads[CPARALLEL_MAX_THREADS];
+    bool started[CPARALLEL_MAX_THREADS];
+    (void) context;
+    if (count > CPARALLEL_MAX_THREADS)
+        count = CPARALLEL_MAX_THREADS;
+    for (int i = 1; i < count; i++)
+    {
+        threads[i].task = task;
+        threads[i].arg = arg;
+        threads[i].index = i;
+        started[i] = (pthread_create(&threads[i].thread, NULL, cParallel_thread_main,
+                                     &threads[i]) == 0);
+        if (! started[i])
+            task(arg, i);
+    }
+    task(arg, 0);
+    for (int i = 1; i < count; i++)
+    {
+        if (started[i])
+            pthread_join(threads[i].thread, NULL);
+    }
+}
+
+/* Executor starting num_threads pthreads per parallel step */
+static inline cParallel_executor cParallel_pthread_executor(const int num_threads)
+{
+    cParallel_executor executor;
+    executor.run = cParallel_run_pthreads;
+    executor.context = NULL;
+    executor.num_threads = num_threads;
+    return executor;
+}
+
+/**
+ * Generate the parallel sort of a cArray of T, the user must CARRAY_GENERATE(T, CPY, CMP) first
+ * @param T type of the array
+ * @param CPY of signature void T_cpy(T* dest, const T* src)
+ * @param CMP of signature int T_cmp(const T* a, const T* b)
+ */
+#define CARRAY_GENERATE_PARALLEL(T, CPY, CMP)                                                      \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        cArray_##T* vector;                                                                        \
+        T* src;                                                                                    \
+        T* dst;                                                                                    \
+        int bounds[CPARALLEL_MAX_THREADS + 1]; /* sorted runs are src[bounds[i], bounds[i + 1]) */ \
+        int runs;                                                                                  \
+        int start;                                                                                 \
+        int n;                                                                                     \
+        int tasks;                                                                                 \
+    } cArray_##T##_parallel_job;                                                                   \
+                                                                                                   \
+    /* Phase 1: task i sorts chunk i in place */                                                   \
+    static inline void cArray_##T##_parallel_sort_chunk(void* arg, int i)                          \
+    {                                                                                              \
+        cArray_##T##_parallel_job* job = (cArray_##T##_parallel_job*) arg;                         \
+        const int first = job->start + job->bounds[i];                                             \
+        cArray_##T##_pdq_sort(job->vector, first, job->start + job->bounds[i + 1] - 1);            \
+    }                                                                                              \
+                                                                                                   \
+    /* Number of elements of a that are among the first k of the stable merge of a and b (merge    \
+     * path co-rank), so output slices can be merged independently */                              \
+    static inline int cArray_##T##_corank(const int k, const T* a, const int na, const T* b,       \
+                                          const int nb)                                            \
+    {                                                                                              \
+        int lo = (k > nb) ? k - nb : 0;                                                            \
+        int hi = (k < na) ? k : na;                                                                \
+        while (lo < hi)                                                                            \
+        {                                                                                          \
+            const int mid = lo + ((hi - lo) / 2);                                                  \
+            if (CMP(&a[mid], &b[k - mid - 1]) > 0)                                                 \
+                hi = mid;                                                                          \
+            else                                                                                   \
+                lo = mid + 1;                                                                      \
+        }                                                                                          \
+        return lo;                                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    /* Phase 2: task i writes output slice i of a merge round, each pair of runs is merged into    \
+     * dst (a leftover odd run is copied), ties are taken from the left run */                     \
+    static inline void cArray_##T##_parallel_merge_slice(void* arg, int i)                         \
+    {                                                                                              \
+        cArray_##T##_parallel_job* job = (cArray_##T##_parallel_job*) arg;                         \
+        const int out_lo = (int) (((long long) job->n * i) / job->tasks);                          \
+        const int out_hi = (int) (((long long) job->n * (i + 1)) / job->tasks);                    \
+        for (int r = 0; r < job->runs; r += 2)                                                     \
+        {                                                                                          \
+            const int base = job->bounds[r];                                                       \
+            const int mid = job->bounds[r + 1];                                                    \
+            const int end = job->bounds[(r + 2 <= job->runs) ? r + 2 : r + 1];                     \
+            const int lo = (out_lo > base) ? out_lo : base;                                        \
+            const int hi = (out_hi < end) ? out_hi : end;                                          \
+            if (lo >= hi)                                                                          \
+                continue;                                                                          \
+                                                                                                   \
+            const T* a = &job->src[base];                                                          \
+            const T* b = &job->src[mid];                                                           \
+            const int na = mid - base, nb = end - mid;                                             \
+            int ia = cArray_##T##_corank(lo - base, a, na, b, nb);                                 \
+            int ib = (lo - base) - ia;                                                             \
+            T* out = &job->dst[lo];                                                                \
+            for (int k = lo; k < hi; k++)                                                          \
+            {                                                                                      \
+                if ((ib >= nb) || ((ia < na) && (CMP(&b[ib], &a[ia]) >= 0)))                       \
+                    CPY(out++, &a[ia++]);                                                          \
+                else                                                                               \
+                    CPY(out++, &b[ib++]);                                                          \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Phase 3: task i copies slice i of the result back into the array */                         \
+    static inline void cArray_##T##_parallel_copy_slice(void* arg, int i)                          \
+    {                                                                                              \
+        cArray_##T##_parallel_job* job = (cArray_##T##_parallel_job*) arg;                         \
+        const int lo = (int) (((long long) job->n * i) / job->tasks);                              \
+        const int hi = (int) (((long long) job->n * (i + 1)) / job->tasks);                        \
+        for (int k = lo; k < hi; k++)                                                              \
+            CPY(&job->dst[k], &job->src[k]);                                                       \
+    }                                                                                              \
+                                                                                                   \
+    /*                                                                                             \
+     * Sort the array between start and end (inclusive) using the threads of executor. scratch     \
+     * must hold end - start + 1 elements. Falls back to the serial pdq_sort for ranges smaller    \
+     * than CARRAY_PARALLEL_THRESHOLD, a single thread or a NULL scratch. Not stable.              \
+     */                                                                                            \
+    static inline void cArray_##T##_parallel_sort_ex(cArray_##T* vector, const int start,          \
+                                                     const int end, T* scratch,                    \
+                                                     const cParallel_executor* executor)           \
+    {                                                                                              \
+        if ((start < 0) || (end >= vector->size) || (start >= end))                                \
+            return;                                                                                \
+        const int n = end - start + 1;                                                             \
+        int tasks = (executor->num_threads < CPARALLEL_MAX_THREADS) ? executor->num_threads        \
+                                                                    : CPARALLEL_MAX_THREADS;       \
+        if (tasks > n / CARRAY_PARALLEL_MIN_CHUNK)                                                 \
+            tasks = n / CARRAY_PARALLEL_MIN_CHUNK;                                                 \
+        if ((n < CARRAY_PARALLEL_THRESHOLD) || (tasks <= 1) || ! scratch)                          \
+        {                                                                                          \
+            cArray_##T##_pdq_sort(vector, start, end);                                             \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        cArray_##T##_parallel_job job;                                                             \
+        job.vector = vector;                                                                       \
+        job.src = &vector->array[start];                                                           \
+        job.dst = scratch;                                                                         \
+        job.start = start;                                                                         \
+        job.n = n;                                                                                 \
+        job.tasks = tasks;                                                                         \
+        job.runs = tasks;                                                                          \
+        for (int i = 0; i <= tasks; i++)                                                           \
+            job.bounds[i] = (int) (((long long) n * i) / tasks);                                   \
+        executor->run(executor->context, cArray_##T##_parallel_sort_chunk, &job, tasks);           \
+                                                                                                   \
+        /* Chunks that already follow each other in order (e.g. sorted input) need no merging */   \
+        bool in_order = true;                                                                      \
+        for (int i = 1; (i < tasks) && in_order; i++)                                              \
+            in_order = (CMP(&job.src[job.bounds[i] - 1], &job.src[job.bounds[i]]) <= 0);           \
+        if (in_order)                                                                              \
+            return;                                                                                \
+                                                                                                   \
+        /* Merge rounds ping-pong between the array and scratch, halving the number of runs */     \
+        while (job.runs > 1)                                                                       \
+        {                                                                                          \
+            executor->run(executor->context, cArray_##T##_parallel_merge_slice, &job, tasks);      \
+            int runs = 0;                                                                          \
+            for (int r = 0; r < job.runs; r += 2)                                                  \
+                job.bounds[runs++] = job.bounds[r];                                                \
+            job.bounds[runs] = n;                                                                  \
+            job.runs = runs;                                                                       \
+            T* temp = job.src;                                                                     \
+            job.src = job.dst;                                                                     \
+            job.dst = temp;                                                                        \
+        }                                                                                          \
+        if (job.src == scratch)                                                                    \
+        {                                                                                          \
+            job.dst = &vector->array[start];                                                       \
+            executor->run(executor->context, cArray_##T##_parallel_copy_slice, &job, tasks);       \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Sort the array between start and end (inclusive) with num_threads pthreads, see             \
+     * parallel_sort_ex */                                                                         \
+    static inline void cArray_##T##_parallel_sort(                                                 \
+        cArray_##T* vector, const int start, const int end, T* scratch, const int num_threads)     \
+    {                                                                                              \
+        const cParallel_executor executor = cParallel_pthread_executor(num_threads);               \
+        cArray_##T##_parallel_sort_ex(vector, start, end, scratch, &executor);                     \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_ARRAY_PARALLEL_H
@@ -0,0 +1,199 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * cAtomicBitset - a bitset that can be shared between threads without a lock.
+ *
+ * Bits are stored in C11 atomic 64-bit words and every update is a single atomic read-modify-write
+ * (fetch_or / fetch_and / fetch_xor / compare-exchange), so concurrent updates of bits in the same
+ * word never lose each other. Requires a C11 compiler with <stdatomic.h>.
+ */
+
+#pragma once
+
+#ifndef CSTL_ATOMIC_BITSET_H
+#define CSTL_ATOMIC_BITSET_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cBitset.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct
+{
+    _Atomic uint64_t* words; // pointer to user-provided memory
+    size_t size;             // number of bits
+} cAtomicBitset;
+
+#define CATOMIC_BITSET_CREATE(bitset, num_bits)                                                    \
+    _Atomic uint64_t bitset##_buf[CBITSET64_WORDS(num_bits)];                                      \
+    cAtomicBitset bitset;                                                                          \
+    cAtomicBitset_init_from_buffer(&bitset, bitset##_buf, num_bits);
+
+/* Initialize a cAtomicBitset with your buffer, the buffer is zeroed. This is not atomic, finish it
+before sharing the bitset with other threads.
+NOTE: The buffer must be large enough to accomodate num_bits, use CBITSET64_WORDS() to get the min
+required number of words */
+static inline void cAtomicBitset_init_from_buffer(cAtomicBitset* bits,
+                                                  _Atomic uint64_t* buffer,
+                                                  const size_t num_bits)
+{
+    bits->words = buffer;
+    bits->size = num_bits;
+    for (size_t i = 0; i < CBITSET64_WORDS(num_bits); i++)
+        atomic_init(&bits->words[i], 0);
+}
+
+/* Read the nth bit of the bitset (index starts from 0) */
+static inline bool cAtomicBitset_readbit(const cAtomicBitset* bits, const size_t n)
+{
+    if (n >= bits->size)
+        return false;
+    return (atomic_load_explicit(&bits->words[n / 64], memory_order_acquire) >> (n % 64)) & 1U;
+}
+
+/* Set the nth bit to 1 and return its previous value. Out of bounds returns true (nothing to
+ * claim there) */
+static inline bool cAtomicBitset_test_and_set(cAtomicBitset* bits, const size_t n)
+{
+    if (n >= bits->size)
+        return true;
+    const uint64_t mask = 1ULL << (n % 64);
+    const uint64_t old =
+        atomic_fetch_or_explicit(&bits->words[n / 64], mask, memory_order_acq_rel);
+    return (old & mask) != 0;
+}
+
+/* Set the nth bit to 0 and return its previous value. Out of bounds returns false */
+static inline bool cAtomicBitset_test_and_clear(cAtomicBitset* bits, const size_t n)
+{
+    if (n >= bits->size)
+        return false;
+    const uint64_t mask = 1ULL << (n % 64);
+    const uint64_t old =
+        atomic_fetch_and_explicit(&bits->words[n / 64], ~mask, memory_order_acq_rel);
+    return (old & mask) != 0;
+}
+
+/* Set the nth bit of the bitset to 1 (index starts from 0) */
+static inline void cAtomicBitset_setbit(cAtomicBitset* bits, const size_t n)
+{
+    (void) cAtomicBitset_test_and_set(bits, n);
+}
+
+/* Set the nth bit of the bitset to 0 (index starts from 0) */
+static inline void cAtomicBitset_clearbit(cAtomicBitset* bits, const size_t n)
+{
+    (void) cAtomicBitset_test_and_clear(bits, n);
+}
+
+/* Toggle the nth bit of the bitset (index starts from 0) */
+static inline void cAtomicBitset_togglebit(cAtomicBitset* bits, const size_t n)
+{
+    if (n >= bits->size)
+        return;
+    atomic_fetch_xor_explicit(&bits->words[n / 64], 1ULL << (n % 64), memory_order_acq_rel);
+}
+
+/* Mask of the valid bits of word i */
+static inline uint64_t cAtomicBitset_word_mask(const cAtomicBitset* bits, const size_t i)
+{
+    const unsigned rem = (unsigned) (bits->size % 64);
+    return ((i == (bits->size - 1) / 64) && rem) ? ((1ULL << rem) - 1) : ~0ULL;
+}
+
+/*
+ * Find a zero bit, set it to 1 and return its index, or CBITSET_NPOS if every bit is 1.
+ * The search starts at the word holding bit hint and wraps around, so threads that pass different
+ * hints (e.g. thread_id * size / num_threads, or their last claimed index) mostly work on
+ * different words and rarely contend. Lock-free: a failed compare-exchange means another thread
+ * made progress.
+ */
+static inline size_t cAtomicBitset_claim_first_zero(cAtomicBitset* bits, const size_t hint)
+{
+    if (bits->size == 0)
+        return CBITSET_NPOS;
+    const size_t num_words = CBITSET64_WORDS(bits->size);
+    const size_t start = (hint < bits->size) ? hint / 64 : 0;
+    for (size_t k = 0; k < num_words; k++)
+    {
+        const size_t i = (start + k < num_words) ? start + k : start + k - num_words;
+        const uint64_t valid = cAtomicBitset_word_mask(bits, i);
+        uint64_t word = atomic_load_explicit(&bits->words[i], memory_order_relaxed);
+        while (~word & valid)
+        {
+            const uint64_t bit = 1ULL << cSimd_ctz64(~word & valid);
+            /* On failure word is reloaded with the current value and we retry on that word */
+            if (atomic_compare_exchange_weak_explicit(&bits->words[i],
+                                                      &word,
+                                                      word | bit,
+                                                      memory_order_acq_rel,
+                                                      memory_order_relaxed))
+                return (i * 64) + cSimd_ctz64(bit);
+        }
+    }
+    return CBITSET_NPOS;
+}
+
+/* Number of bits set to 1. Words are read one at a time, so the result is only a snapshot when
+ * other threads are updating the bitset */
+static inline size_t cAtomicBitset_count(const cAtomicBitset* bits)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < CBITSET64_WORDS(bits->size); i++)
+        count += cSimd_popcount64(atomic_load_explicit(&bits->words[i], memory_order_relaxed));
+    return count;
+}
+
+/* Set all bits to 0, each word is cleared atomically but not the bitset as a whole */
+static inline void cAtomicBitset_clear_all(cAtomicBitset* bits)
+{
+    for (size_t i = 0; i < CBITSET64_WORDS(bits->size); i++)
+        atomic_store_explicit(&bits->words[i], 0, memory_order_release);
+}
+
+/* Set all bits to 1, each word is set atomically but not the bitset as a whole */
+static inline void cAtomicBitset_set_all(cAtomicBitset* bits)
+{
+    for (size_t i = 0; i < CBITSET64_WORDS(bits->size); i++)
+    {
+        const uint64_t mask = cAtomicBitset_word_mask(bits, i);
+        atomic_store_explicit(&bits->words[i], mask, memory_order_release);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_ATOMIC_BITSET_H
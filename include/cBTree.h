@@ -0,0 +1,473 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * cBTree - an ordered map (B+tree) with nodes taken from a cPool.
+ *
+ * Every node holds up to CBTREE_MAX_KEYS(K) sorted keys, enough to fill CBTREE_KEY_BYTES (two
+ * cache lines), so a search reads a couple of lines per level and the tree stays a few levels
+ * deep even for millions of keys. Values are only stored in the leaves, which are chained in key
+ * order for range scans. Insert splits full nodes on the way down, erase borrows from or merges
+ * with a sibling on the way back up, so both are O(log n) and never shift more than one node.
+ */
+
+#pragma once
+
+#ifndef CSTL_BTREE_H
+#define CSTL_BTREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "cPool.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Bytes of keys per node */
+#ifndef CBTREE_KEY_BYTES
+#define CBTREE_KEY_BYTES 128
+#endif
+
+/* Max keys per node, at least 4 */
+#define CBTREE_MAX_KEYS(K) ((CBTREE_KEY_BYTES / sizeof(K) < 4) ? 4 : (CBTREE_KEY_BYTES / sizeof(K)))
+
+/* Nodes of the pool needed for a tree of n keys, leaves are at least half full */
+#define CBTREE_NODES(K, n) ((2 * (n) / (CBTREE_MAX_KEYS(K) / 2)) + 32)
+
+/* Max depth of a tree, more than any pool with an int capacity can fill */
+#define CBTREE_MAX_HEIGHT 32
+
+/**
+ * Generate a B+tree map from K to V and its associated functions
+ * @param K type of the keys
+ * @param V type of the values
+ * @param CMP of signature int K_cmp(const K* a, const K* b), same contract as for cArray
+ *
+ * @note Keys and values are copied by assignment and moved with memmove
+ */
+#define CBTREE_GENERATE(K, V, CMP)                                                                 \
+    typedef struct cBTree_##K##_##V##_node cBTree_##K##_##V##_node;                                \
+    struct cBTree_##K##_##V##_node                                                                 \
+    {                                                                                              \
+        int count; /* number of keys */                                                            \
+        bool leaf;                                                                                 \
+        cBTree_##K##_##V##_node* next; /* next leaf in key order */                                \
+        K keys[CBTREE_MAX_KEYS(K)];                                                                \
+        union                                                                                      \
+        {                                                                                          \
+            cBTree_##K##_##V##_node* children[CBTREE_MAX_KEYS(K) + 1]; /* count + 1 */             \
+            V values[CBTREE_MAX_KEYS(K)];                                                          \
+        };                                                                                         \
+    };                                                                                             \
+                                                                                                   \
+    CPOOL_GENERATE_ALIGNED(cBTree_##K##_##V##_node, CPOOL_CACHE_LINE)                              \
+                                                                                                   \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        cBTree_##K##_##V##_node* root;                                                             \
+        cPool_cBTree_##K##_##V##_node* pool;                                                       \
+        size_t size;                                                                               \
+        int height; /* levels, 1 while the root is a leaf */                                       \
+    } cBTree_##K##_##V;                                                                            \
+                                                                                                   \
+    /* Position of an entry in a leaf, leaf is NULL past the last entry */                         \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        cBTree_##K##_##V##_node* leaf;                                                             \
+        int index;                                                                                 \
+    } cBTree_##K##_##V##_iter;                                                                     \
+                                                                                                   \
+    static inline cBTree_##K##_##V##_node* cBTree_##K##_##V##_alloc_node(                          \
+        cBTree_##K##_##V* tree, const bool leaf)                                                   \
+    {                                                                                              \
+        cBTree_##K##_##V##_node* node = cPool_cBTree_##K##_##V##_node_alloc(tree->pool);           \
+        if (node)                                                                                  \
+        {                                                                                          \
+            node->count = 0;                                                                       \
+            node->leaf = leaf;                                                                     \
+            node->next = NULL;                                                                     \
+        }                                                                                          \
+        return node;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Initialize an empty tree taking its nodes from pool (which may be shared by several trees   \
+     * of the same type). False if the pool has no node left for the root */                       \
+    static inline bool cBTree_##K##_##V##_init(                                                    \
+        cBTree_##K##_##V* tree, cPool_cBTree_##K##_##V##_node* pool)                               \
+    {                                                                                              \
+        tree->pool = pool;                                                                         \
+        tree->size = 0;                                                                            \
+        tree->height = 1;                                                                          \
+        tree->root = cBTree_##K##_##V##_alloc_node(tree, true);                                    \
+        return tree->root != NULL;                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    /* Number of keys of node less than key (or not greater than key if upper), branchless like    \
+     * cArray lower_bound */                                                                       \
+    static inline int cBTree_##K##_##V##_node_search(                                              \
+        const cBTree_##K##_##V##_node* node, const K* key, const bool upper)                       \
+    {                                                                                              \
+        if (node->count == 0)                                                                      \
+            return 0;                                                                              \
+        const int bound = upper ? 1 : 0;                                                           \
+        const K* base = node->keys;                                                                \
+        int len = node->count;                                                                     \
+        while (len > 1)                                                                            \
+        {                                                                                          \
+            const int half = len / 2;                                                              \
+            base = (CMP(&base[half - 1], key) < bound) ? base + half : base;                       \
+            len -= half;                                                                           \
+        }                                                                                          \
+        return (int) (base - node->keys) + (CMP(base, key) < bound);                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline cBTree_##K##_##V##_node* cBTree_##K##_##V##_find_leaf(                           \
+        const cBTree_##K##_##V* tree, const K* key)                                                \
+    {                                                                                              \
+        cBTree_##K##_##V##_node* node = tree->root;                                                \
+        while (! node->leaf)                                                                       \
+            node = node->children[cBTree_##K##_##V##_node_search(node, key, true)];                \
+        return node;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Value of key, or NULL if it is not present */                                               \
+    static inline V* cBTree_##K##_##V##_find(const cBTree_##K##_##V* tree, const K* key)           \
+    {                                                                                              \
+        cBTree_##K##_##V##_node* leaf = cBTree_##K##_##V##_find_leaf(tree, key);                   \
+        const int i = cBTree_##K##_##V##_node_search(leaf, key, false);                            \
+        if ((i < leaf->count) && (CMP(&leaf->keys[i], key) == 0))                                  \
+            return &leaf->values[i];                                                               \
+        return NULL;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Split the full child i of parent (which is not full) in two halves */                       \
+    static inline void cBTree_##K##_##V##_split_child(                                             \
+        cBTree_##K##_##V* tree, cBTree_##K##_##V##_node* parent, const int i)                      \
+    {                                                                                              \
+        cBTree_##K##_##V##_node* child = parent->children[i];                                      \
+        cBTree_##K##_##V##_node* right = cBTree_##K##_##V##_alloc_node(tree, child->leaf);         \
+        const int mid = (int) CBTREE_MAX_KEYS(K) / 2;                                              \
+        K separator;                                                                               \
+        if (child->leaf)                                                                           \
+        {                                                                                          \
+            /* the separator is copied up, the right leaf keeps it */                              \
+            right->count = child->count - mid;                                                     \
+            memcpy(right->keys, &child->keys[mid], (size_t) right->count * sizeof(K));             \
+            memcpy(right->values, &child->values[mid], (size_t) right->count * sizeof(V));         \
+            right->next = child->next;                                                             \
+            child->next = right;                                                                   \
+            separator = right->keys[0];                                                            \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            /* the separator moves up */                                                           \
+            right->count = child->count - mid - 1;                                                 \
+            memcpy(right->keys, &child->keys[mid + 1], (size_t) right->count * sizeof(K));         \
+            memcpy(right->children, &child->children[mid + 1],                                     \
+                   (size_t) (right->count + 1) * sizeof(right->children[0]));                      \
+            separator = child->keys[mid];                                                          \
+        }                                                                                          \
+        child->count = mid;                                                                        \
+        memmove(&parent->keys[i + 1], &parent->keys[i], (size_t) (parent->count - i) * sizeof(K)); \
+        memmove(&parent->children[i + 2], &parent->children[i + 1],                                \
+                (size_t) (parent->count - i) * sizeof(parent->children[0]));                       \
+        parent->keys[i] = separator;                                                               \
+        parent->children[i + 1] = right;                                                           \
+        parent->count++;                                                                           \
+    }                                                                                              \
+                                                                                                   \
+    /* Insert key with value, or overwrite the value if key is present. Returns false (and         \
+     * changes nothing) if the pool may run out of nodes for the splits, height + 1 are needed */  \
+    static inline bool cBTree_##K##_##V##_insert(                                                  \
+        cBTree_##K##_##V* tree, const K* key, const V* value)                                      \
+    {                                                                                              \
+        V* existing = cBTree_##K##_##V##_find(tree, key);                                          \
+        if (existing)                                                                              \
+        {                                                                                          \
+            *existing = *value;                                                                    \
+            return true;                                                                           \
+        }                                                                                          \
+        if (tree->pool->capacity - tree->pool->size < tree->height + 1)                            \
+            return false;                                                                          \
+        if (tree->root->count == (int) CBTREE_MAX_KEYS(K))                                         \
+        {                                                                                          \
+            cBTree_##K##_##V##_node* root = cBTree_##K##_##V##_alloc_node(tree, false);            \
+            root->children[0] = tree->root;                                                        \
+            cBTree_##K##_##V##_split_child(tree, root, 0);                                         \
+            tree->root = root;                                                                     \
+            tree->height++;                                                                        \
+        }                                                                                          \
+        cBTree_##K##_##V##_node* node = tree->root;                                                \
+        while (! node->leaf)                                                                       \
+        {                                                                                          \
+            int i = cBTree_##K##_##V##_node_search(node, key, true);                               \
+            if (node->children[i]->count == (int) CBTREE_MAX_KEYS(K))                              \
+            {                                                                                      \
+                cBTree_##K##_##V##_split_child(tree, node, i);                                     \
+                i += (CMP(key, &node->keys[i]) >= 0);                                              \
+            }                                                                                      \
+            node = node->children[i];                                                              \
+        }                                                                                          \
+        const int i = cBTree_##K##_##V##_node_search(node, key, false);                            \
+        memmove(&node->keys[i + 1], &node->keys[i], (size_t) (node->count - i) * sizeof(K));       \
+        memmove(&node->values[i + 1], &node->values[i], (size_t) (node->count - i) * sizeof(V));   \
+        node->keys[i] = *key;                                                                      \
+        node->values[i] = *value;                                                                  \
+        node->count++;                                                                             \
+        tree->size++;                                                                              \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Move the last entry of the left sibling of child i of parent to the front of child i */     \
+    static inline void cBTree_##K##_##V##_borrow_left(                                             \
+        cBTree_##K##_##V##_node* parent, const int i)                                              \
+    {                                                                                              \
+        cBTree_##K##_##V##_node* node = parent->children[i];                                       \
+        cBTree_##K##_##V##_node* left = parent->children[i - 1];                                   \
+        memmove(&node->keys[1], &node->keys[0], (size_t) node->count * sizeof(K));                 \
+        if (node->leaf)                                                                            \
+        {                                                                                          \
+            memmove(&node->values[1], &node->values[0], (size_t) node->count * sizeof(V));         \
+            node->keys[0] = left->keys[left->count - 1];                                           \
+            node->values[0] = left->values[left->count - 1];                                       \
+            parent->keys[i - 1] = node->keys[0];                                                   \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            memmove(&node->children[1], &node->children[0],                                        \
+                    (size_t) (node->count + 1) * sizeof(node->children[0]));                       \
+            node->keys[0] = parent->keys[i - 1];                                                   \
+            node->children[0] = left->children[left->count];                                       \
+            parent->keys[i - 1] = left->keys[left->count - 1];                                     \
+        }                                                                                          \
+        left->count--;                                                                             \
+        node->count++;                                                                             \
+    }                                                                                              \
+                                                                                                   \
+    /* Move the first entry of the right sibling of child i of parent to the end of child i */     \
+    static inline void cBTree_##K##_##V##_borrow_right(                                            \
+        cBTree_##K##_##V##_node* parent, const int i)                                              \
+    {                                                                                              \
+        cBTree_##K##_##V##_node* node = parent->children[i];                                       \
+        cBTree_##K##_##V##_node* right = parent->children[i + 1];                                  \
+        if (node->leaf)                                                                            \
+        {                                                                                          \
+            node->keys[node->count] = right->keys[0];                                              \
+            node->values[node->count] = right->values[0];                                          \
+            memmove(&right->values[0], &right->values[1],                                          \
+                    (size_t) (right->count - 1) * sizeof(V));                                      \
+            memmove(&right->keys[0], &right->keys[1], (size_t) (right->count - 1) * sizeof(K));    \
+            parent->keys[i] = right->keys[0];                                                      \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            node->keys[node->count] = parent->keys[i];                                             \
+            node->children[node->count + 1] = right->children[0];                                  \
+            parent->keys[i] = right->keys[0];                                                      \
+            memmove(&right->keys[0], &right->keys[1], (size_t) (right->count - 1) * sizeof(K));    \
+            memmove(&right->children[0], &right->children[1],                                      \
+                    (size_t) right->count * sizeof(right->children[0]));                           \
+        }                                                                                          \
+        right->count--;                                                                            \
+        node->count++;                                                                             \
+    }                                                                                              \
+                                                                                                   \
+    /* Merge child i + 1 of parent into child i and free it */                                     \
+    static inline void cBTree_##K##_##V##_merge(                                                   \
+        cBTree_##K##_##V* tree, cBTree_##K##_##V##_node* parent, const int i)                      \
+    {                                                                                              \
+        cBTree_##K##_##V##_node* left = parent->children[i];                                       \
+        cBTree_##K##_##V##_node* right = parent->children[i + 1];                                  \
+        if (left->leaf)                                                                            \
+        {                                                                                          \
+            memcpy(&left->keys[left->count], right->keys, (size_t) right->count * sizeof(K));      \
+            memcpy(&left->values[left->count], right->values, (size_t) right->count * sizeof(V));  \
+            left->count += right->count;                                                           \
+            left->next = right->next;                                                              \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            left->keys[left->count] = parent->keys[i];                                             \
+            memcpy(&left->keys[left->count + 1], right->keys, (size_t) right->count * sizeof(K));  \
+            memcpy(&left->children[left->count + 1], right->children,                              \
+                   (size_t) (right->count + 1) * sizeof(right->children[0]));                      \
+            left->count += right->count + 1;                                                       \
+        }                                                                                          \
+        memmove(&parent->keys[i], &parent->keys[i + 1],                                            \
+                (size_t) (parent->count - i - 1) * sizeof(K));                                     \
+        memmove(&parent->children[i + 1], &parent->children[i + 2],                                \
+                (size_t) (parent->count - i - 1) * sizeof(parent->children[0]));                   \
+        parent->count--;                                                                           \
+        cPool_cBTree_##K##_##V##_node_free(tree->pool, right);                                     \
+    }                                                                                              \
+                                                                                                   \
+    /* Remove key, false if it is not present. Nodes left less than half full borrow an entry      \
+     * from a sibling, or merge with it, up to the root */                                         \
+    static inline bool cBTree_##K##_##V##_erase(cBTree_##K##_##V* tree, const K* key)              \
+    {                                                                                              \
+        cBTree_##K##_##V##_node* path[CBTREE_MAX_HEIGHT];                                          \
+        int slot[CBTREE_MAX_HEIGHT];                                                               \
+        int depth = 0;                                                                             \
+        cBTree_##K##_##V##_node* node = tree->root;                                                \
+        while (! node->leaf)                                                                       \
+        {                                                                                          \
+            path[depth] = node;                                                                    \
+            slot[depth] = cBTree_##K##_##V##_node_search(node, key, true);                         \
+            node = node->children[slot[depth]];                                                    \
+            depth++;                                                                               \
+        }                                                                                          \
+        const int i = cBTree_##K##_##V##_node_search(node, key, false);                            \
+        if ((i == node->count) || (CMP(&node->keys[i], key) != 0))                                 \
+            return false;                                                                          \
+        memmove(&node->keys[i], &node->keys[i + 1], (size_t) (node->count - i - 1) * sizeof(K));   \
+        memmove(&node->values[i], &node->values[i + 1],                                            \
+                (size_t) (node->count - i - 1) * sizeof(V));                                       \
+        node->count--;                                                                             \
+        tree->size--;                                                                              \
+                                                                                                   \
+        const int min_keys = (int) CBTREE_MAX_KEYS(K) / 2;                                         \
+        while ((depth > 0) && (node->count < min_keys))                                            \
+        {                                                                                          \
+            cBTree_##K##_##V##_node* parent = path[depth - 1];                                     \
+            const int c = slot[depth - 1];                                                         \
+            if ((c > 0) && (parent->children[c - 1]->count > min_keys))                            \
+            {                                                                                      \
+                cBTree_##K##_##V##_borrow_left(parent, c);                                         \
+                break;                                                                             \
+            }                                                                                      \
+            if ((c < parent->count) && (parent->children[c + 1]->count > min_keys))                \
+            {                                                                                      \
+                cBTree_##K##_##V##_borrow_right(parent, c);                                        \
+                break;                                                                             \
+            }                                                                                      \
+            cBTree_##K##_##V##_merge(tree, parent, (c > 0) ? c - 1 : c);                           \
+            node = parent;                                                                         \
+            depth--;                                                                               \
+        }                                                                                          \
+        if (! tree->root->leaf && (tree->root->count == 0))                                        \
+        {                                                                                          \
+            cBTree_##K##_##V##_node* old_root = tree->root;                                        \
+            tree->root = old_root->children[0];                                                    \
+            cPool_cBTree_##K##_##V##_node_free(tree->pool, old_root);                              \
+            tree->height--;                                                                        \
+        }                                                                                          \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Iterator on the first entry of the leaf at index i or after it */                           \
+    static inline cBTree_##K##_##V##_iter cBTree_##K##_##V##_iter_at(                              \
+        cBTree_##K##_##V##_node* leaf, const int i)                                                \
+    {                                                                                              \
+        cBTree_##K##_##V##_iter it;                                                                \
+        it.leaf = (i < leaf->count) ? leaf : leaf->next;                                           \
+        it.index = (i < leaf->count) ? i : 0;                                                      \
+        return it;                                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    /* Iterator on the smallest key */                                                             \
+    static inline cBTree_##K##_##V##_iter cBTree_##K##_##V##_begin(const cBTree_##K##_##V* tree)   \
+    {                                                                                              \
+        cBTree_##K##_##V##_node* node = tree->root;                                                \
+        while (! node->leaf)                                                                       \
+            node = node->children[0];                                                              \
+        return cBTree_##K##_##V##_iter_at(node, 0);                                                \
+    }                                                                                              \
+                                                                                                   \
+    /* Iterator on the first key not less than key */                                              \
+    static inline cBTree_##K##_##V##_iter cBTree_##K##_##V##_lower_bound(                          \
+        const cBTree_##K##_##V* tree, const K* key)                                                \
+    {                                                                                              \
+        cBTree_##K##_##V##_node* leaf = cBTree_##K##_##V##_find_leaf(tree, key);                   \
+        return cBTree_##K##_##V##_iter_at(leaf, cBTree_##K##_##V##_node_search(leaf, key, false)); \
+    }                                                                                              \
+                                                                                                   \
+    /* Get the entry of it (key and value may be NULL) and advance it, in ascending key order.     \
+     * False once past the last entry. The tree must not be modified while iterating */            \
+    static inline bool cBTree_##K##_##V##_next(                                                    \
+        cBTree_##K##_##V##_iter* it, const K** key, V** value)                                     \
+    {                                                                                              \
+        if (! it->leaf)                                                                            \
+            return false;                                                                          \
+        if (key)                                                                                   \
+            *key = &it->leaf->keys[it->index];                                                     \
+        if (value)                                                                                 \
+            *value = &it->leaf->values[it->index];                                                 \
+        *it = cBTree_##K##_##V##_iter_at(it->leaf, it->index + 1);                                 \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline void cBTree_##K##_##V##_free_subtree(                                            \
+        cBTree_##K##_##V* tree, cBTree_##K##_##V##_node* node)                                     \
+    {                                                                                              \
+        if (! node->leaf)                                                                          \
+        {                                                                                          \
+            for (int i = 0; i <= node->count; i++)                                                 \
+                cBTree_##K##_##V##_free_subtree(tree, node->children[i]);                          \
+        }                                                                                          \
+        cPool_cBTree_##K##_##V##_node_free(tree->pool, node);                                      \
+    }                                                                                              \
+                                                                                                   \
+    /* Remove every entry and return all the nodes but the root to the pool */                     \
+    static inline void cBTree_##K##_##V##_clear(cBTree_##K##_##V* tree)                            \
+    {                                                                                              \
+        if (! tree->root->leaf)                                                                    \
+        {                                                                                          \
+            for (int i = 0; i <= tree->root->count; i++)                                           \
+                cBTree_##K##_##V##_free_subtree(tree, tree->root->children[i]);                    \
+        }                                                                                          \
+        tree->root->count = 0;                                                                     \
+        tree->root->leaf = true;                                                                   \
+        tree->root->next = NULL;                                                                   \
+        tree->size = 0;                                                                            \
+        tree->height = 1;                                                                          \
+    }
+
+/* Create a tree of K to V with a pool of num_nodes nodes statically (see CBTREE_NODES), the user
+ * must CBTREE_GENERATE(K, V, CMP) before creating the tree */
+#define CBTREE_CREATE(name, K, V, num_nodes)                                                       \
+    CPOOL_CREATE(name##_pool, cBTree_##K##_##V##_node, num_nodes)                                  \
+    cBTree_##K##_##V name;                                                                         \
+    cBTree_##K##_##V##_init(&name, &name##_pool);
+
+/* Loop over every entry of a tree in ascending key order, e.g.
+ * const int* key;
+ * float* value;
+ * CBTREE_FOREACH(int, float, &tree, key, value) { ... }
+ * The tree must not be modified inside the loop */
+#define CBTREE_FOREACH(K, V, tree, key, value)                                                     \
+    for (cBTree_##K##_##V##_iter key##_it = cBTree_##K##_##V##_begin(tree);                        \
+         cBTree_##K##_##V##_next(&key##_it, &(key), &(value));)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_BTREE_H
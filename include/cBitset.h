@@ -34,11 +34,60 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "cSimd.h"
+#include "cStats.h"
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+/* Count a whole bitset operation on operands of bytes bytes, refused if mismatch is true */
+#define CBITSET_COUNT_BULK(stats, bytes, mismatch)                                                 \
+    (CSTATS_ADD(stats, bulk_ops, 1), CSTATS_ADD(stats, bulk_bytes, bytes),                         \
+     CSTATS_ADD(stats, size_mismatches, mismatch))
+
+#ifdef CSTL_STATS
+
+/* What the cBitset (or cBitset64) functions did on the calling thread, see cBitset_stats_get */
+typedef struct
+{
+    uint64_t reads;           // readbit calls
+    uint64_t writes;          // setbit, clearbit and togglebit calls
+    uint64_t out_of_range;    // single bit calls ignored because the index is past the size
+    uint64_t bulk_ops;        // whole bitset and, or, xor, andnot, and_count and intersects
+    uint64_t bulk_bytes;      // bytes of each operand read by those
+    uint64_t size_mismatches; // whole bitset operations refused because the sizes differ
+} cBitset_stats;
+
+/* Counters of the cBitset / cBitset64 calls of this translation unit on the calling thread */
+static CSTL_THREAD_LOCAL cBitset_stats cBitset_stats_data;
+static CSTL_THREAD_LOCAL cBitset_stats cBitset64_stats_data;
+
+/* Snapshot of the counters of every cBitset used in this translation unit by the calling thread */
+static inline cBitset_stats cBitset_stats_get(void)
+{
+    return cBitset_stats_data;
+}
+
+static inline void cBitset_stats_reset(void)
+{
+    memset(&cBitset_stats_data, 0, sizeof(cBitset_stats));
+}
+
+/* Same for every cBitset64 */
+static inline cBitset_stats cBitset64_stats_get(void)
+{
+    return cBitset64_stats_data;
+}
+
+static inline void cBitset64_stats_reset(void)
+{
+    memset(&cBitset64_stats_data, 0, sizeof(cBitset_stats));
+}
+
+#endif // CSTL_STATS
+
 typedef struct
 {
     uint8_t* bitset; // pointer to user-provided memory
@@ -79,6 +128,8 @@ static inline void cBitset_set_all(cBitset* bits)
 /* Read the nth bit of the bitset (index starts from 0) */
 static inline bool cBitset_readbit(const cBitset* bits, const size_t n)
 {
+    CSTATS_ADD(cBitset_stats_data, reads, 1);
+    CSTATS_ADD(cBitset_stats_data, out_of_range, n >= bits->size);
     if (n >= bits->size)
         return false;
     return (bits->bitset[n / 8] >> (n % 8)) & 1U;
@@ -87,6 +138,8 @@ static inline bool cBitset_readbit(const cBitset* bits, const size_t n)
 /* Set the nth bit of the bitset to 1 (index starts from 0) */
 static inline void cBitset_setbit(cBitset* bits, const size_t n)
 {
+    CSTATS_ADD(cBitset_stats_data, writes, 1);
+    CSTATS_ADD(cBitset_stats_data, out_of_range, n >= bits->size);
     if (n >= bits->size)
         return;
     bits->bitset[n / 8] |= (uint8_t) (1U << (n % 8));
@@ -95,6 +148,8 @@ static inline void cBitset_setbit(cBitset* bits, const size_t n)
 /* Set the nth bit of the bitset to 0 (index starts from 0) */
 static inline void cBitset_clearbit(cBitset* bits, const size_t n)
 {
+    CSTATS_ADD(cBitset_stats_data, writes, 1);
+    CSTATS_ADD(cBitset_stats_data, out_of_range, n >= bits->size);
     if (n >= bits->size)
         return;
     bits->bitset[n / 8] &= (uint8_t) (~(1U << (n % 8)));
@@ -103,11 +158,544 @@ static inline void cBitset_clearbit(cBitset* bits, const size_t n)
 /* Toggle the nth bit of the bitset (index starts from 0) */
 static inline void cBitset_togglebit(cBitset* bits, const size_t n)
 {
+    CSTATS_ADD(cBitset_stats_data, writes, 1);
+    CSTATS_ADD(cBitset_stats_data, out_of_range, n >= bits->size);
     if (n >= bits->size)
         return;
     bits->bitset[n / 8] ^= (uint8_t) (1U << (n % 8));
 }
 
+/*
+ * Whole bitset operations. These run on SIMD kernels selected at runtime (see cSimd.h).
+ * Binary operations require all bitsets to have the same size and return false otherwise.
+ * dst may be the same bitset as a or b.
+ */
+
+/* Number of full bytes, and the mask of the valid bits in the trailing partial byte (0 if none) */
+static inline size_t cBitset_full_bytes(const cBitset* bits)
+{
+    return bits->size / 8;
+}
+
+static inline uint8_t cBitset_tail_mask(const cBitset* bits)
+{
+    return (uint8_t) ((1U << (bits->size % 8)) - 1);
+}
+
+/* dst = a & b */
+static inline bool cBitset_and(cBitset* dst, const cBitset* a, const cBitset* b)
+{
+    CBITSET_COUNT_BULK(cBitset_stats_data,
+                       CBITSET_SIZE(a->size),
+                       (dst->size != a->size) || (a->size != b->size));
+    if ((dst->size != a->size) || (a->size != b->size))
+        return false;
+    cSimd_bits_and(dst->bitset, a->bitset, b->bitset, CBITSET_SIZE(a->size));
+    return true;
+}
+
+/* dst = a | b */
+static inline bool cBitset_or(cBitset* dst, const cBitset* a, const cBitset* b)
+{
+    CBITSET_COUNT_BULK(cBitset_stats_data,
+                       CBITSET_SIZE(a->size),
+                       (dst->size != a->size) || (a->size != b->size));
+    if ((dst->size != a->size) || (a->size != b->size))
+        return false;
+    cSimd_bits_or(dst->bitset, a->bitset, b->bitset, CBITSET_SIZE(a->size));
+    return true;
+}
+
+/* dst = a ^ b */
+static inline bool cBitset_xor(cBitset* dst, const cBitset* a, const cBitset* b)
+{
+    CBITSET_COUNT_BULK(cBitset_stats_data,
+                       CBITSET_SIZE(a->size),
+                       (dst->size != a->size) || (a->size != b->size));
+    if ((dst->size != a->size) || (a->size != b->size))
+        return false;
+    cSimd_bits_xor(dst->bitset, a->bitset, b->bitset, CBITSET_SIZE(a->size));
+    return true;
+}
+
+/* dst = a & ~b, i.e. the bits of a that are not in b */
+static inline bool cBitset_andnot(cBitset* dst, const cBitset* a, const cBitset* b)
+{
+    CBITSET_COUNT_BULK(cBitset_stats_data,
+                       CBITSET_SIZE(a->size),
+                       (dst->size != a->size) || (a->size != b->size));
+    if ((dst->size != a->size) || (a->size != b->size))
+        return false;
+    cSimd_bits_andnot(dst->bitset, a->bitset, b->bitset, CBITSET_SIZE(a->size));
+    return true;
+}
+
+/* In-place variants, dst = dst <op> src */
+static inline bool cBitset_and_inplace(cBitset* dst, const cBitset* src)
+{
+    return cBitset_and(dst, dst, src);
+}
+
+static inline bool cBitset_or_inplace(cBitset* dst, const cBitset* src)
+{
+    return cBitset_or(dst, dst, src);
+}
+
+static inline bool cBitset_xor_inplace(cBitset* dst, const cBitset* src)
+{
+    return cBitset_xor(dst, dst, src);
+}
+
+static inline bool cBitset_andnot_inplace(cBitset* dst, const cBitset* src)
+{
+    return cBitset_andnot(dst, dst, src);
+}
+
+/* Number of bits set in both a and b, without writing a & b anywhere. 0 if the sizes differ */
+static inline size_t cBitset_and_count(const cBitset* a, const cBitset* b)
+{
+    CBITSET_COUNT_BULK(cBitset_stats_data, CBITSET_SIZE(a->size), a->size != b->size);
+    if (a->size != b->size)
+        return 0;
+    const size_t full = cBitset_full_bytes(a);
+    size_t count = cSimd_bits_and_count(a->bitset, b->bitset, full);
+    const uint8_t mask = cBitset_tail_mask(a);
+    if (mask)
+        count += cSimd_popcount64(a->bitset[full] & b->bitset[full] & mask);
+    return count;
+}
+
+/* Whether a and b have at least one set bit in common. false if the sizes differ */
+static inline bool cBitset_intersects(const cBitset* a, const cBitset* b)
+{
+    CBITSET_COUNT_BULK(cBitset_stats_data, CBITSET_SIZE(a->size), a->size != b->size);
+    if (a->size != b->size)
+        return false;
+    const size_t full = cBitset_full_bytes(a);
+    if (cSimd_bits_and_any(a->bitset, b->bitset, full))
+        return true;
+    const uint8_t mask = cBitset_tail_mask(a);
+    return (mask != 0) && ((a->bitset[full] & b->bitset[full] & mask) != 0);
+}
+
+/* Whether any bit is set */
+static inline bool cBitset_any(const cBitset* bits)
+{
+    return cBitset_intersects(bits, bits);
+}
+
+/* Whether no bit is set */
+static inline bool cBitset_none(const cBitset* bits)
+{
+    return ! cBitset_any(bits);
+}
+
+/* Whether every bit is set (true for an empty bitset) */
+static inline bool cBitset_all(const cBitset* bits)
+{
+    const size_t full = cBitset_full_bytes(bits);
+    if (! cSimd_bits_all_ones(bits->bitset, full))
+        return false;
+    const uint8_t mask = cBitset_tail_mask(bits);
+    return (mask == 0) || ((bits->bitset[full] & mask) == mask);
+}
+
+/* Whether a and b have the same size and bits */
+static inline bool cBitset_equal(const cBitset* a, const cBitset* b)
+{
+    if (a->size != b->size)
+        return false;
+    /* libc memcmp is already vectorized and dispatched at runtime */
+    const size_t full = cBitset_full_bytes(a);
+    if (memcmp(a->bitset, b->bitset, full) != 0)
+        return false;
+    const uint8_t mask = cBitset_tail_mask(a);
+    return (mask == 0) || (((a->bitset[full] ^ b->bitset[full]) & mask) == 0);
+}
+
+/*
+ * cBitset64 - the same bitset stored in uint64_t words. Scans (count, find, iteration) work a word
+ * at a time using ctz/popcount, so they cost about one instruction per 64 bits.
+ * NOTE: the unused bits of the last word are always kept at 0
+ */
+
+/* Returned by the find functions when no matching bit exists */
+#define CBITSET_NPOS ((size_t) -1)
+
+typedef struct
+{
+    uint64_t* words; // pointer to user-provided memory
+    size_t size;     // number of bits
+} cBitset64;
+
+/* Get the minimum required number of uint64_t words to store num_bits */
+#define CBITSET64_WORDS(num_bits) (((num_bits) + 63) / 64)
+
+#define CBITSET64_CREATE(bitset, num_bits)                                                         \
+    uint64_t bitset##_buf[CBITSET64_WORDS(num_bits)];                                              \
+    cBitset64 bitset;                                                                              \
+    cBitset64_init_from_buffer(&bitset, bitset##_buf, num_bits);
+
+/* Mask of the valid bits in the last word (all ones if the size is a multiple of 64) */
+static inline uint64_t cBitset64_tail_mask(const cBitset64* bits)
+{
+    const unsigned rem = (unsigned) (bits->size % 64);
+    return rem ? ((1ULL << rem) - 1) : ~0ULL;
+}
+
+/* Initialize a cBitset64 with your buffer, the buffer is zeroed
+NOTE: The buffer must be large enough to accomodate num_bits, use CBITSET64_WORDS() to get the min
+required number of words */
+static inline void cBitset64_init_from_buffer(cBitset64* bits,
+                                              uint64_t* buffer,
+                                              const size_t num_bits)
+{
+    bits->words = buffer;
+    bits->size = num_bits;
+    memset(bits->words, 0, CBITSET64_WORDS(bits->size) * sizeof(uint64_t));
+}
+
+/* Set all bits to 0 */
+static inline void cBitset64_clear_all(cBitset64* bits)
+{
+    memset(bits->words, 0, CBITSET64_WORDS(bits->size) * sizeof(uint64_t));
+}
+
+/* Set all bits to 1, the unused bits of the last word are kept at 0 */
+static inline void cBitset64_set_all(cBitset64* bits)
+{
+    const size_t num_words = CBITSET64_WORDS(bits->size);
+    if (num_words == 0)
+        return;
+    memset(bits->words, 0xFF, num_words * sizeof(uint64_t));
+    bits->words[num_words - 1] = cBitset64_tail_mask(bits);
+}
+
+/* Read the nth bit of the bitset (index starts from 0) */
+static inline bool cBitset64_readbit(const cBitset64* bits, const size_t n)
+{
+    CSTATS_ADD(cBitset64_stats_data, reads, 1);
+    CSTATS_ADD(cBitset64_stats_data, out_of_range, n >= bits->size);
+    if (n >= bits->size)
+        return false;
+    return (bits->words[n / 64] >> (n % 64)) & 1U;
+}
+
+/* Set the nth bit of the bitset to 1 (index starts from 0) */
+static inline void cBitset64_setbit(cBitset64* bits, const size_t n)
+{
+    CSTATS_ADD(cBitset64_stats_data, writes, 1);
+    CSTATS_ADD(cBitset64_stats_data, out_of_range, n >= bits->size);
+    if (n >= bits->size)
+        return;
+    bits->words[n / 64] |= (1ULL << (n % 64));
+}
+
+/* Set the nth bit of the bitset to 0 (index starts from 0) */
+static inline void cBitset64_clearbit(cBitset64* bits, const size_t n)
+{
+    CSTATS_ADD(cBitset64_stats_data, writes, 1);
+    CSTATS_ADD(cBitset64_stats_data, out_of_range, n >= bits->size);
+    if (n >= bits->size)
+        return;
+    bits->words[n / 64] &= ~(1ULL << (n % 64));
+}
+
+/* Toggle the nth bit of the bitset (index starts from 0) */
+static inline void cBitset64_togglebit(cBitset64* bits, const size_t n)
+{
+    CSTATS_ADD(cBitset64_stats_data, writes, 1);
+    CSTATS_ADD(cBitset64_stats_data, out_of_range, n >= bits->size);
+    if (n >= bits->size)
+        return;
+    bits->words[n / 64] ^= (1ULL << (n % 64));
+}
+
+/* Set (value = true) or clear (value = false) the bits in [start, end], end is clamped to the
+ * last bit. Whole words in between are written directly */
+static inline void cBitset64_assign_range(cBitset64* bits,
+                                          const size_t start,
+                                          size_t end,
+                                          const bool value)
+{
+    if (bits->size == 0)
+        return;
+    if (end >= bits->size)
+        end = bits->size - 1;
+    if (start > end)
+        return;
+
+    const size_t first = start / 64, last = end / 64;
+    const uint64_t first_mask = ~0ULL << (start % 64);
+    const uint64_t last_mask = ~0ULL >> (63 - (end % 64));
+    if (first == last)
+    {
+        const uint64_t mask = first_mask & last_mask;
+        bits->words[first] = value ? (bits->words[first] | mask) : (bits->words[first] & ~mask);
+        return;
+    }
+
+    bits->words[first] =
+        value ? (bits->words[first] | first_mask) : (bits->words[first] & ~first_mask);
+    if (last > first + 1)
+        memset(&bits->words[first + 1], value ? 0xFF : 0, (last - first - 1) * sizeof(uint64_t));
+    bits->words[last] = value ? (bits->words[last] | last_mask) : (bits->words[last] & ~last_mask);
+}
+
+/* Set the bits in [start, end] to 1 */
+static inline void cBitset64_set_range(cBitset64* bits, const size_t start, const size_t end)
+{
+    cBitset64_assign_range(bits, start, end, true);
+}
+
+/* Set the bits in [start, end] to 0 */
+static inline void cBitset64_clear_range(cBitset64* bits, const size_t start, const size_t end)
+{
+    cBitset64_assign_range(bits, start, end, false);
+}
+
+/* Number of bits set to 1 */
+static inline size_t cBitset64_count(const cBitset64* bits)
+{
+    /* Runs the dispatched popcount kernel, bits & bits = bits */
+    return cSimd_bits_and_count((const uint8_t*) bits->words,
+                                (const uint8_t*) bits->words,
+                                CBITSET64_WORDS(bits->size) * sizeof(uint64_t));
+}
+
+/* Index of the first set bit at or after from, or CBITSET_NPOS if there is none */
+static inline size_t cBitset64_find_next(const cBitset64* bits, const size_t from)
+{
+    if (from >= bits->size)
+        return CBITSET_NPOS;
+    const size_t num_words = CBITSET64_WORDS(bits->size);
+    size_t i = from / 64;
+    /* Drop the bits below from in the first word, then scan a word at a time */
+    uint64_t word = bits->words[i] & (~0ULL << (from % 64));
+    while (! word)
+    {
+        if (++i >= num_words)
+            return CBITSET_NPOS;
+        word = bits->words[i];
+    }
+    return (i * 64) + cSimd_ctz64(word);
+}
+
+/* Index of the first zero bit at or after from, or CBITSET_NPOS if there is none */
+static inline size_t cBitset64_find_next_zero(const cBitset64* bits, const size_t from)
+{
+    if (from >= bits->size)
+        return CBITSET_NPOS;
+    const size_t num_words = CBITSET64_WORDS(bits->size);
+    size_t i = from / 64;
+    uint64_t word = ~bits->words[i] & (~0ULL << (from % 64));
+    while (! word)
+    {
+        if (++i >= num_words)
+            return CBITSET_NPOS;
+        word = ~bits->words[i];
+    }
+    /* The unused bits of the last word read as zeros, so they must be rejected here */
+    const size_t index = (i * 64) + cSimd_ctz64(word);
+    return (index < bits->size) ? index : CBITSET_NPOS;
+}
+
+/* Index of the first set bit, or CBITSET_NPOS if all bits are 0 */
+static inline size_t cBitset64_find_first_set(const cBitset64* bits)
+{
+    return cBitset64_find_next(bits, 0);
+}
+
+/* Index of the first zero bit, or CBITSET_NPOS if all bits are 1 */
+static inline size_t cBitset64_find_first_zero(const cBitset64* bits)
+{
+    return cBitset64_find_next_zero(bits, 0);
+}
+
+/* Iterator over the set bits, in increasing order. The bitset must not be modified while an
+ * iterator is in use */
+typedef struct
+{
+    const uint64_t* words;
+    size_t num_words;
+    size_t index;     // index of the word being consumed
+    uint64_t current; // remaining set bits of that word
+} cBitset64_iter;
+
+static inline cBitset64_iter cBitset64_iter_begin(const cBitset64* bits)
+{
+    cBitset64_iter it;
+    it.words = bits->words;
+    it.num_words = CBITSET64_WORDS(bits->size);
+    it.index = 0;
+    it.current = it.num_words ? bits->words[0] : 0;
+    return it;
+}
+
+/* Write the next set bit to out and return true, or return false once all bits are visited */
+static inline bool cBitset64_iter_next(cBitset64_iter* it, size_t* out)
+{
+    while (! it->current)
+    {
+        if (++it->index >= it->num_words)
+        {
+            it->index = it->num_words;
+            return false;
+        }
+        it->current = it->words[it->index];
+    }
+    *out = (it->index * 64) + cSimd_ctz64(it->current);
+    it->current &= it->current - 1; // clear the lowest set bit
+    return true;
+}
+
+/* Loop over the index of every set bit, e.g.
+ * size_t i;
+ * CBITSET64_FOREACH(&bits, i) { ... } */
+#define CBITSET64_FOREACH(bits, n)                                                                 \
+    for (cBitset64_iter n##_it = cBitset64_iter_begin(bits); cBitset64_iter_next(&n##_it, &(n));)
+
+
+/* Whole bitset operations, same contract as the cBitset versions */
+
+/* dst = a & b */
+static inline bool cBitset64_and(cBitset64* dst, const cBitset64* a, const cBitset64* b)
+{
+    CBITSET_COUNT_BULK(cBitset64_stats_data,
+                       CBITSET64_WORDS(a->size) * sizeof(uint64_t),
+                       (dst->size != a->size) || (a->size != b->size));
+    if ((dst->size != a->size) || (a->size != b->size))
+        return false;
+    cSimd_bits_and((uint8_t*) dst->words,
+                   (const uint8_t*) a->words,
+                   (const uint8_t*) b->words,
+                   CBITSET64_WORDS(a->size) * sizeof(uint64_t));
+    return true;
+}
+
+/* dst = a | b */
+static inline bool cBitset64_or(cBitset64* dst, const cBitset64* a, const cBitset64* b)
+{
+    CBITSET_COUNT_BULK(cBitset64_stats_data,
+                       CBITSET64_WORDS(a->size) * sizeof(uint64_t),
+                       (dst->size != a->size) || (a->size != b->size));
+    if ((dst->size != a->size) || (a->size != b->size))
+        return false;
+    cSimd_bits_or((uint8_t*) dst->words,
+                  (const uint8_t*) a->words,
+                  (const uint8_t*) b->words,
+                  CBITSET64_WORDS(a->size) * sizeof(uint64_t));
+    return true;
+}
+
+/* dst = a ^ b */
+static inline bool cBitset64_xor(cBitset64* dst, const cBitset64* a, const cBitset64* b)
+{
+    CBITSET_COUNT_BULK(cBitset64_stats_data,
+                       CBITSET64_WORDS(a->size) * sizeof(uint64_t),
+                       (dst->size != a->size) || (a->size != b->size));
+    if ((dst->size != a->size) || (a->size != b->size))
+        return false;
+    cSimd_bits_xor((uint8_t*) dst->words,
+                   (const uint8_t*) a->words,
+                   (const uint8_t*) b->words,
+                   CBITSET64_WORDS(a->size) * sizeof(uint64_t));
+    return true;
+}
+
+/* dst = a & ~b, i.e. the bits of a that are not in b */
+static inline bool cBitset64_andnot(cBitset64* dst, const cBitset64* a, const cBitset64* b)
+{
+    CBITSET_COUNT_BULK(cBitset64_stats_data,
+                       CBITSET64_WORDS(a->size) * sizeof(uint64_t),
+                       (dst->size != a->size) || (a->size != b->size));
+    if ((dst->size != a->size) || (a->size != b->size))
+        return false;
+    cSimd_bits_andnot((uint8_t*) dst->words,
+                      (const uint8_t*) a->words,
+                      (const uint8_t*) b->words,
+                      CBITSET64_WORDS(a->size) * sizeof(uint64_t));
+    return true;
+}
+
+/* In-place variants, dst = dst <op> src */
+static inline bool cBitset64_and_inplace(cBitset64* dst, const cBitset64* src)
+{
+    return cBitset64_and(dst, dst, src);
+}
+
+static inline bool cBitset64_or_inplace(cBitset64* dst, const cBitset64* src)
+{
+    return cBitset64_or(dst, dst, src);
+}
+
+static inline bool cBitset64_xor_inplace(cBitset64* dst, const cBitset64* src)
+{
+    return cBitset64_xor(dst, dst, src);
+}
+
+static inline bool cBitset64_andnot_inplace(cBitset64* dst, const cBitset64* src)
+{
+    return cBitset64_andnot(dst, dst, src);
+}
+
+/* Number of bits set in both a and b, without writing a & b anywhere. 0 if the sizes differ */
+static inline size_t cBitset64_and_count(const cBitset64* a, const cBitset64* b)
+{
+    CBITSET_COUNT_BULK(cBitset64_stats_data,
+                       CBITSET64_WORDS(a->size) * sizeof(uint64_t),
+                       a->size != b->size);
+    if (a->size != b->size)
+        return 0;
+    return cSimd_bits_and_count((const uint8_t*) a->words,
+                                (const uint8_t*) b->words,
+                                CBITSET64_WORDS(a->size) * sizeof(uint64_t));
+}
+
+/* Whether a and b have at least one set bit in common. false if the sizes differ */
+static inline bool cBitset64_intersects(const cBitset64* a, const cBitset64* b)
+{
+    CBITSET_COUNT_BULK(cBitset64_stats_data,
+                       CBITSET64_WORDS(a->size) * sizeof(uint64_t),
+                       a->size != b->size);
+    if (a->size != b->size)
+        return false;
+    return cSimd_bits_and_any((const uint8_t*) a->words,
+                              (const uint8_t*) b->words,
+                              CBITSET64_WORDS(a->size) * sizeof(uint64_t));
+}
+
+/* Whether any bit is set */
+static inline bool cBitset64_any(const cBitset64* bits)
+{
+    return cBitset64_intersects(bits, bits);
+}
+
+/* Whether no bit is set */
+static inline bool cBitset64_none(const cBitset64* bits)
+{
+    return ! cBitset64_any(bits);
+}
+
+/* Whether every bit is set (true for an empty bitset) */
+static inline bool cBitset64_all(const cBitset64* bits)
+{
+    const size_t num_words = CBITSET64_WORDS(bits->size);
+    if (num_words == 0)
+        return true;
+    if (! cSimd_bits_all_ones((const uint8_t*) bits->words, (num_words - 1) * sizeof(uint64_t)))
+        return false;
+    return bits->words[num_words - 1] == cBitset64_tail_mask(bits);
+}
+
+/* Whether a and b have the same size and bits */
+static inline bool cBitset64_equal(const cBitset64* a, const cBitset64* b)
+{
+    if (a->size != b->size)
+        return false;
+    return memcmp(a->words, b->words, CBITSET64_WORDS(a->size) * sizeof(uint64_t)) == 0;
+}
+
 #ifdef __cplusplus
 }
 #endif
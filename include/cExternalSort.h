@@ -0,0 +1,454 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * cExternalSort - sort files of fixed-size records that do not fit in memory.
+ *
+ * The input file is read in chunks as large as the memory budget, every chunk is sorted in place
+ * with the cArray pdqsort and written to a temporary run file. The runs are then merged k at a
+ * time through an indexed heap holding the next record of every run, with one large sequential
+ * buffer per run, until a single merge writes the output. Run files can bypass the page cache
+ * with O_DIRECT (Linux, when _GNU_SOURCE is defined before any include). POSIX only.
+ */
+
+#pragma once
+
+#ifndef CSTL_EXTERNAL_SORT_H
+#define CSTL_EXTERNAL_SORT_H
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cArray.h"
+#include "cHeap.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Default memory budget for the records held in memory: the chunk sorted at once, then the
+ * buffers of a merge */
+#define CEXTSORT_DEFAULT_MEMORY ((size_t) 256 << 20)
+/* Default size of the buffer of every run read or written by a merge */
+#define CEXTSORT_DEFAULT_IO_BUFFER ((size_t) 1 << 20)
+/* Max runs merged at once (one open file each), more runs are merged in several passes */
+#define CEXTSORT_MAX_FAN_IN 256
+/* Buffer sizes and addresses are multiples of this, as O_DIRECT requires */
+#define CEXTSORT_ALIGN 4096
+/* Max bytes per read / write call, a multiple of CEXTSORT_ALIGN */
+#define CEXTSORT_MAX_IO ((size_t) 1 << 30)
+/* Max length of a run file path */
+#define CEXTSORT_PATH_MAX 4096
+
+typedef struct
+{
+    size_t memory;        // bytes of records held in memory at once
+    size_t io_buffer;     // bytes of the buffer of each run in a merge (rounded to whole records)
+    const char* temp_dir; // where the runs are written, needs room for the whole input
+    bool direct_io;       // open the runs and the output with O_DIRECT where supported
+} cExtSort_config;
+
+/* 256MB of memory, 1MB buffers, runs in /tmp, through the page cache */
+static inline cExtSort_config cExtSort_default_config(void)
+{
+    cExtSort_config config;
+    config.memory = CEXTSORT_DEFAULT_MEMORY;
+    config.io_buffer = CEXTSORT_DEFAULT_IO_BUFFER;
+    config.temp_dir = "/tmp";
+    config.direct_io = false;
+    return config;
+}
+
+/* A file read or written sequentially through one buffer of whole records */
+typedef struct
+{
+    int fd;
+    uint8_t* buffer;
+    size_t capacity; // bytes of buffer
+    size_t pos;      // next byte to read, or bytes waiting to be written
+    size_t len;      // bytes read in buffer
+    bool error;
+} cExtSort_stream;
+
+/* Open a file, with O_DIRECT if asked and possible (some file systems like tmpfs refuse it) */
+static inline int cExtSort_open(const char* path, const int flags, const bool direct)
+{
+#ifdef O_DIRECT
+    if (direct)
+    {
+        const int fd = open(path, flags | O_DIRECT, 0644);
+        if (fd >= 0)
+            return fd;
+    }
+#else
+    (void) direct;
+#endif
+    return open(path, flags, 0644);
+}
+
+/* Read up to bytes, stopping early only at the end of the file. -1 on error */
+static inline long long cExtSort_read_full(const int fd, uint8_t* buffer, const size_t bytes)
+{
+    size_t done = 0;
+    while (done < bytes)
+    {
+        const size_t left = bytes - done;
+        const ssize_t got =
+            read(fd, buffer + done, (left < CEXTSORT_MAX_IO) ? left : CEXTSORT_MAX_IO);
+        if (got < 0)
+            return -1;
+        if (got == 0)
+            break;
+        done += (size_t) got;
+    }
+    return (long long) done;
+}
+
+/* Write all the bytes. With O_DIRECT only the aligned part can go directly, the tail of the file
+ * is written through the page cache */
+static inline bool cExtSort_write_full(const int fd, const uint8_t* buffer, const size_t bytes)
+{
+    size_t done = 0;
+    while (done < bytes)
+    {
+        size_t step = ((bytes - done) < CEXTSORT_MAX_IO) ? (bytes - done) : CEXTSORT_MAX_IO;
+#ifdef O_DIRECT
+        const int flags = fcntl(fd, F_GETFL);
+        if ((flags & O_DIRECT) && (step % CEXTSORT_ALIGN))
+        {
+            if (step >= CEXTSORT_ALIGN)
+                step -= step % CEXTSORT_ALIGN;
+            else if (fcntl(fd, F_SETFL, flags & ~O_DIRECT) != 0)
+                return false;
+        }
+#endif
+        const ssize_t written = write(fd, buffer + done, step);
+        if (written <= 0)
+            return false;
+        done += (size_t) written;
+    }
+    return true;
+}
+
+/* Next record of size bytes, NULL at the end of the file or on error */
+static inline const void* cExtSort_next(cExtSort_stream* stream, const size_t size)
+{
+    if (stream->pos + size > stream->len)
+    {
+        const long long got = cExtSort_read_full(stream->fd, stream->buffer, stream->capacity);
+        stream->error |= (got < 0) || ((got % (long long) size) != 0);
+        stream->pos = 0;
+        stream->len = (got > 0) ? (size_t) got : 0;
+        if (stream->error || (stream->len == 0))
+            return NULL;
+    }
+    const void* record = stream->buffer + stream->pos;
+    stream->pos += size;
+    return record;
+}
+
+static inline bool cExtSort_flush(cExtSort_stream* stream)
+{
+    stream->error |= ! cExtSort_write_full(stream->fd, stream->buffer, stream->pos);
+    stream->pos = 0;
+    return ! stream->error;
+}
+
+static inline void cExtSort_put(cExtSort_stream* stream, const void* record, const size_t size)
+{
+    if ((stream->pos + size > stream->capacity) && ! cExtSort_flush(stream))
+        return;
+    memcpy(stream->buffer + stream->pos, record, size);
+    stream->pos += size;
+}
+
+/* Smallest multiple of both size and CEXTSORT_ALIGN, so buffers of this many bytes hold whole
+ * records and are valid O_DIRECT transfers */
+static inline size_t cExtSort_unit(const size_t size)
+{
+    size_t a = size, b = CEXTSORT_ALIGN;
+    while (b)
+    {
+        const size_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return size * (CEXTSORT_ALIGN / a);
+}
+
+/* Path of run id, unique to the sort identified by token */
+static inline bool cExtSort_run_path(char* path,
+                                     const cExtSort_config* config,
+                                     const void* token,
+                                     const int id)
+{
+    const int n = snprintf(path, CEXTSORT_PATH_MAX, "%s/cstl_sort_%ld_%p_%d.run",
+                           config->temp_dir, (long) getpid(), token, id);
+    return (n > 0) && (n < CEXTSORT_PATH_MAX);
+}
+
+/**
+ * Generate the external sort of files of T, the user must CARRAY_GENERATE(T, CPY, CMP) first
+ * @param T type of the records, read and written as raw bytes so it must not hold pointers
+ * @param CPY of signature void T_cpy(T* dest, const T* src)
+ * @param CMP of signature int T_cmp(const T* a, const T* b)
+ */
+#define CARRAY_GENERATE_EXTERNAL_SORT(T, CPY, CMP)                                                 \
+    typedef T cArray_##T##_run_head;                                                               \
+    CINDEXED_HEAP_GENERATE(cArray_##T##_run_head, CPY, CMP)                                        \
+                                                                                                   \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        const cExtSort_config* config;                                                             \
+        size_t io;         /* bytes of each merge buffer */                                        \
+        int fan_in;        /* runs merged at once */                                               \
+        int* runs;         /* ids of the runs waiting to be merged, runs[first, count) */          \
+        int first;                                                                                 \
+        int count;                                                                                 \
+        int capacity;                                                                              \
+        int next_id;                                                                               \
+    } cArray_##T##_external_job;                                                                   \
+                                                                                                   \
+    static inline bool cArray_##T##_external_add_run(cArray_##T##_external_job* job, const int id) \
+    {                                                                                              \
+        if (job->count == job->capacity)                                                           \
+        {                                                                                          \
+            const int capacity = job->capacity ? job->capacity * 2 : 64;                           \
+            int* runs = (int*) realloc(job->runs, (size_t) capacity * sizeof(int));                \
+            if (! runs)                                                                            \
+                return false;                                                                      \
+            job->runs = runs;                                                                      \
+            job->capacity = capacity;                                                              \
+        }                                                                                          \
+        job->runs[job->count++] = id;                                                              \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Merge the sorted streams in[0, k) into out: the heap holds the next record of every run,    \
+     * keyed by run, the smallest is written and replaced by the next record of its run */         \
+    static inline bool cArray_##T##_external_merge(                                                \
+        cExtSort_stream* in, const int k, cExtSort_stream* out, int* ids, int* pos, T* heads)      \
+    {                                                                                              \
+        cIndexedHeap_cArray_##T##_run_head heap;                                                   \
+        cIndexedHeap_cArray_##T##_run_head_init_from_buffer(&heap, ids, pos, heads, k);            \
+        for (int r = 0; r < k; r++)                                                                \
+        {                                                                                          \
+            const T* record = (const T*) cExtSort_next(&in[r], sizeof(T));                         \
+            if (record)                                                                            \
+                cIndexedHeap_cArray_##T##_run_head_push(&heap, r, record);                         \
+        }                                                                                          \
+        int r;                                                                                     \
+        while (cIndexedHeap_cArray_##T##_run_head_peek(&heap, &r, NULL) && ! out->error)           \
+        {                                                                                          \
+            cExtSort_put(out, &heads[r], sizeof(T));                                               \
+            const T* record = (const T*) cExtSort_next(&in[r], sizeof(T));                         \
+            if (! record)                                                                          \
+                cIndexedHeap_cArray_##T##_run_head_erase(&heap, r);                                \
+            else if (! cIndexedHeap_cArray_##T##_run_head_increase_key(&heap, r, record))          \
+                out->error = true; /* the run is not sorted, CMP is inconsistent */                \
+        }                                                                                          \
+        bool ok = cExtSort_flush(out);                                                             \
+        for (int i = 0; i < k; i++)                                                                \
+            ok = ok && ! in[i].error;                                                              \
+        return ok;                                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    /* Merge the k runs at job->runs[job->first] into the file fd, deleting them */                \
+    static inline bool cArray_##T##_external_merge_runs(cArray_##T##_external_job* job,            \
+                                                        const int k,                               \
+                                                        const int fd,                              \
+                                                        uint8_t* buffers,                          \
+                                                        cExtSort_stream* streams,                  \
+                                                        int* ids,                                  \
+                                                        int* pos,                                  \
+                                                        T* heads,                                  \
+                                                        const void* token)                         \
+    {                                                                                              \
+        char path[CEXTSORT_PATH_MAX];                                                              \
+        bool ok = true;                                                                            \
+        int opened = 0;                                                                            \
+        for (; ok && (opened < k); opened++)                                                       \
+        {                                                                                          \
+            cExtSort_stream* in = &streams[opened];                                                \
+            memset(in, 0, sizeof(cExtSort_stream));                                                \
+            in->buffer = buffers + ((size_t) opened * job->io);                                    \
+            in->capacity = job->io;                                                                \
+            ok = cExtSort_run_path(path, job->config, token, job->runs[job->first + opened]);      \
+            in->fd = ok ? cExtSort_open(path, O_RDONLY, job->config->direct_io) : -1;              \
+            ok = ok && (in->fd >= 0);                                                              \
+            if (ok)                                                                                \
+                unlink(path); /* the data stays readable until closed */                           \
+        }                                                                                          \
+        if (ok)                                                                                    \
+        {                                                                                          \
+            cExtSort_stream out;                                                                   \
+            memset(&out, 0, sizeof(cExtSort_stream));                                              \
+            out.fd = fd;                                                                           \
+            out.buffer = buffers + ((size_t) k * job->io);                                         \
+            out.capacity = job->io;                                                                \
+            ok = cArray_##T##_external_merge(streams, k, &out, ids, pos, heads);                   \
+        }                                                                                          \
+        for (int i = 0; i < opened; i++)                                                           \
+        {                                                                                          \
+            if (streams[i].fd >= 0)                                                                \
+                close(streams[i].fd);                                                              \
+        }                                                                                          \
+        if (ok)                                                                                    \
+            job->first += k; /* otherwise the caller deletes them */                               \
+        return ok;                                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    /* Phase 1: sort the input chunk by chunk into runs, or straight into the output if it fits    \
+     * in one chunk. Returns the number of runs, -1 on error */                                    \
+    static inline int cArray_##T##_external_make_runs(cArray_##T##_external_job* job,              \
+                                                      const char* input,                           \
+                                                      const char* output,                          \
+                                                      const void* token)                           \
+    {                                                                                              \
+        const size_t unit = cExtSort_unit(sizeof(T));                                              \
+        size_t bytes = (job->config->memory / unit) * unit;                                        \
+        const size_t max_bytes = ((size_t) INT_MAX / (unit / sizeof(T))) * unit;                   \
+        bytes = (bytes < unit) ? unit : (bytes > max_bytes) ? max_bytes : bytes;                   \
+        const int in = open(input, O_RDONLY);                                                      \
+        uint8_t* chunk = (in >= 0) ? (uint8_t*) aligned_alloc(CEXTSORT_ALIGN, bytes) : NULL;       \
+        bool ok = (chunk != NULL);                                                                 \
+        for (int runs = 0; ok; runs++)                                                             \
+        {                                                                                          \
+            const long long got = cExtSort_read_full(in, chunk, bytes);                            \
+            ok = (got >= 0) && ((got % (long long) sizeof(T)) == 0);                               \
+            if (! ok || ((got == 0) && (runs > 0)))                                                \
+                break;                                                                             \
+            cArray_##T sorted;                                                                     \
+            const int n = (int) (got / (long long) sizeof(T));                                     \
+            cArray_##T##_init_from_buffer(&sorted, (T*) chunk, n);                                 \
+            sorted.size = sorted.capacity;                                                         \
+            cArray_##T##_sort(&sorted);                                                            \
+            const bool last = (runs == 0) && ((size_t) got < bytes);                               \
+            char path[CEXTSORT_PATH_MAX];                                                          \
+            ok = last || cExtSort_run_path(path, job->config, token, job->next_id);                \
+            const int fd = ! ok ? -1                                                               \
+                           : last                                                                  \
+                               ? cExtSort_open(output, O_WRONLY | O_CREAT | O_TRUNC,               \
+                                               job->config->direct_io)                             \
+                               : cExtSort_open(path, O_WRONLY | O_CREAT | O_EXCL,                  \
+                                               job->config->direct_io);                            \
+            ok = (fd >= 0) && cExtSort_write_full(fd, chunk, (size_t) got);                        \
+            ok = (fd >= 0) && (close(fd) == 0) && ok;                                              \
+            ok = ok && (last || cArray_##T##_external_add_run(job, job->next_id++));               \
+            if (! ok && ! last && (fd >= 0))                                                       \
+                unlink(path); /* a partial run, not in job->runs yet */                            \
+            if (last)                                                                              \
+                break;                                                                             \
+        }                                                                                          \
+        free(chunk);                                                                               \
+        if (in >= 0)                                                                               \
+            close(in);                                                                             \
+        return ok ? job->count : -1;                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /**                                                                                            \
+     * Sort the records of the file input into the file output (which may be input), using at      \
+     * most config->memory bytes for records and temporary files in config->temp_dir (default      \
+     * config if NULL). Not stable. Returns false on any I/O error, or if the size of input is not \
+     * a multiple of sizeof(T), output is then incomplete                                          \
+     */                                                                                            \
+    static inline bool cArray_##T##_external_sort(                                                 \
+        const char* input, const char* output, const cExtSort_config* config)                      \
+    {                                                                                              \
+        const cExtSort_config defaults = cExtSort_default_config();                                \
+        cArray_##T##_external_job job;                                                             \
+        memset(&job, 0, sizeof(job));                                                              \
+        job.config = config ? config : &defaults;                                                  \
+        const void* token = &job;                                                                  \
+        const int runs = cArray_##T##_external_make_runs(&job, input, output, token);              \
+                                                                                                   \
+        /* Phase 2: merge fan_in runs at a time into a new run, until one merge writes output */   \
+        const size_t unit = cExtSort_unit(sizeof(T));                                              \
+        size_t io = (job.config->io_buffer / unit) * unit;                                         \
+        if (io * 3 > job.config->memory)                                                           \
+            io = (job.config->memory / 3 / unit) * unit;                                           \
+        job.io = (io < unit) ? unit : io;                                                          \
+        const size_t fan_in = (job.config->memory / job.io) - 1;                                   \
+        job.fan_in = (fan_in < 2) ? 2 : (fan_in > CEXTSORT_MAX_FAN_IN) ? CEXTSORT_MAX_FAN_IN       \
+                                                                        : (int) fan_in;            \
+        const int k = (runs <= 0) ? 1 : (runs < job.fan_in) ? runs : job.fan_in;                   \
+        uint8_t* buffers = (runs > 0) ? (uint8_t*) aligned_alloc(CEXTSORT_ALIGN,                   \
+                                                                 (size_t) (k + 1) * job.io)        \
+                                      : NULL;                                                      \
+        cExtSort_stream* streams = (cExtSort_stream*) malloc((size_t) k * sizeof(*streams));       \
+        int* ids = (int*) malloc((size_t) k * sizeof(int));                                        \
+        int* pos = (int*) malloc((size_t) k * sizeof(int));                                        \
+        T* heads = (T*) malloc((size_t) k * sizeof(T));                                            \
+        bool ok = (runs == 0) || (buffers && streams && ids && pos && heads);                      \
+        ok = ok && (runs >= 0);                                                                    \
+        while (ok && (job.count - job.first > 0))                                                  \
+        {                                                                                          \
+            const int waiting = job.count - job.first;                                             \
+            const bool last = (waiting <= job.fan_in);                                             \
+            const int merged = last ? waiting : job.fan_in;                                        \
+            char path[CEXTSORT_PATH_MAX];                                                          \
+            ok = last || cExtSort_run_path(path, job.config, token, job.next_id);                  \
+            const int fd = ! ok ? -1                                                               \
+                           : last ? cExtSort_open(output, O_WRONLY | O_CREAT | O_TRUNC,            \
+                                                   job.config->direct_io)                          \
+                                   : cExtSort_open(path, O_WRONLY | O_CREAT | O_EXCL,              \
+                                                   job.config->direct_io);                         \
+            ok = (fd >= 0) && cArray_##T##_external_merge_runs(                                    \
+                                  &job, merged, fd, buffers, streams, ids, pos, heads, token);     \
+            ok = (fd >= 0) && (close(fd) == 0) && ok;                                              \
+            ok = ok && (last || cArray_##T##_external_add_run(&job, job.next_id++));               \
+            if (! ok && ! last && (fd >= 0))                                                       \
+                unlink(path); /* a partial run, not in job.runs yet */                             \
+        }                                                                                          \
+                                                                                                   \
+        /* On error, delete the runs not merged yet */                                             \
+        for (int i = job.first; i < job.count; i++)                                                \
+        {                                                                                          \
+            char path[CEXTSORT_PATH_MAX];                                                          \
+            if (cExtSort_run_path(path, job.config, token, job.runs[i]))                           \
+                unlink(path);                                                                      \
+        }                                                                                          \
+        free(buffers);                                                                             \
+        free(streams);                                                                             \
+        free(ids);                                                                                 \
+        free(pos);                                                                                 \
+        free(heads);                                                                               \
+        free(job.runs);                                                                            \
+        return ok;                                                                                 \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_EXTERNAL_SORT_H
@@ -0,0 +1,427 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * cHashMap / cHashSet - open addressing hash tables over user-provided buffers.
+ *
+ * The layout follows Google's SwissTable: besides the array of entries there is one control byte
+ * per slot, either EMPTY, DELETED (a tombstone) or the low 7 bits of the key's hash (h2). A lookup
+ * loads 16 control bytes at once and compares them all with h2 in one SSE2 instruction, so EQ is
+ * only called on entries whose 7 hash bits already match, and the probe stops at the first group
+ * that has an EMPTY byte. Groups are probed quadratically from the slot picked by the other 57
+ * hash bits (h1). The capacity is fixed: a table accepts up to 7/8 of its slots, and when
+ * tombstones use up the remaining room they are purged in place instead of growing.
+ */
+
+#pragma once
+
+#ifndef CSTL_HASH_MAP_H
+#define CSTL_HASH_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cSimd.h"
+
+#if defined(__SSE2__) && ! defined(CSTL_SIMD_DISABLE)
+#define CHASH_SSE2 1
+#include <emmintrin.h>
+#else
+#define CHASH_SSE2 0
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Control bytes compared per probe step */
+#define CHASH_GROUP 16
+/* Control byte of a slot that was never used since the last clear */
+#define CHASH_EMPTY 0x80
+/* Control byte of a slot whose entry was erased */
+#define CHASH_DELETED 0xFE
+/* Index returned by the lookups when there is no such key */
+#define CHASH_NPOS ((size_t) -1)
+
+/* Control bytes needed for a table of capacity slots, the first group is mirrored at the end so
+ * a group starting near the end can be loaded without wrapping */
+#define CHASH_CTRL_BYTES(capacity) ((capacity) + CHASH_GROUP)
+/* Max number of entries of a table of capacity slots */
+#define CHASH_MAX_LOAD(capacity) ((capacity) - ((capacity) / 8))
+
+/* Spread the bits of a user hash so weak hashes (e.g. the identity for integers) still fill the
+ * table evenly, this is the finalizer of MurmurHash3 */
+static inline uint64_t cHash_mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/* Bit i is set if ctrl[i] == h2, for the 16 control bytes at ctrl */
+static inline uint32_t cHash_group_match(const uint8_t* ctrl, const uint8_t h2)
+{
+#if CHASH_SSE2
+    const __m128i group = _mm_loadu_si128((const __m128i*) ctrl);
+    return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char) h2)));
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < CHASH_GROUP; i++)
+        mask |= (uint32_t) (ctrl[i] == h2) << i;
+    return mask;
+#endif
+}
+
+/* Bit i is set if ctrl[i] is EMPTY */
+static inline uint32_t cHash_group_empty(const uint8_t* ctrl)
+{
+    return cHash_group_match(ctrl, CHASH_EMPTY);
+}
+
+/* Bit i is set if ctrl[i] is EMPTY or DELETED, the only control bytes with the high bit set */
+static inline uint32_t cHash_group_free(const uint8_t* ctrl)
+{
+#if CHASH_SSE2
+    return (uint32_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) ctrl));
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < CHASH_GROUP; i++)
+        mask |= (uint32_t) (ctrl[i] >> 7) << i;
+    return mask;
+#endif
+}
+
+/*
+ * Table core shared by the map and the set. Entry is a struct with a member key of type K.
+ * HASH is of signature uint64_t K_hash(const K* key) and EQ of signature bool K_eq(const K* a,
+ * const K* b). Keys and values are copied by assignment.
+ */
+#define CHASH_GENERATE_TABLE(Table, Entry, K, HASH, EQ)                                            \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        uint8_t* ctrl;      /* CHASH_CTRL_BYTES(capacity) control bytes */                         \
+        Entry* entries;     /* capacity entries, valid where ctrl is a hash byte */                \
+        size_t mask;        /* capacity - 1 */                                                     \
+        size_t size;        /* number of entries */                                                \
+        size_t growth_left; /* EMPTY slots that can still be filled before the max load */         \
+    } Table;                                                                                       \
+                                                                                                   \
+    static inline void Table##_set_ctrl(Table* table, const size_t i, const uint8_t ctrl)          \
+    {                                                                                              \
+        table->ctrl[i] = ctrl;                                                                     \
+        if (i < CHASH_GROUP)                                                                       \
+            table->ctrl[table->mask + 1 + i] = ctrl;                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Remove every entry, O(capacity / 16) */                                                     \
+    static inline void Table##_clear(Table* table)                                                 \
+    {                                                                                              \
+        memset(table->ctrl, CHASH_EMPTY, CHASH_CTRL_BYTES(table->mask + 1));                       \
+        table->size = 0;                                                                           \
+        table->growth_left = CHASH_MAX_LOAD(table->mask + 1);                                      \
+    }                                                                                              \
+                                                                                                   \
+    /* Initialize an empty table with CHASH_CTRL_BYTES(capacity) control bytes and capacity        \
+     * entries. The capacity must be a power of two of at least CHASH_GROUP (returns false         \
+     * otherwise), it holds up to CHASH_MAX_LOAD(capacity) entries */                              \
+    static inline bool Table##_init_from_buffer(                                                   \
+        Table* table, uint8_t* ctrl, Entry* entries, const size_t capacity)                        \
+    {                                                                                              \
+        if ((capacity < CHASH_GROUP) || (capacity & (capacity - 1)))                               \
+            return false;                                                                          \
+        table->ctrl = ctrl;                                                                        \
+        table->entries = entries;                                                                  \
+        table->mask = capacity - 1;                                                                \
+        Table##_clear(table);                                                                      \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Slot of key, or CHASH_NPOS */                                                               \
+    static inline size_t Table##_find_index(const Table* table, const K* key, const uint64_t hash) \
+    {                                                                                              \
+        const uint8_t h2 = (uint8_t) (hash & 0x7F);                                                \
+        size_t pos = (size_t) (hash >> 7) & table->mask;                                           \
+        for (size_t step = CHASH_GROUP; step <= table->mask + 1; step += CHASH_GROUP)              \
+        {                                                                                          \
+            const uint8_t* group = table->ctrl + pos;                                              \
+            for (uint32_t match = cHash_group_match(group, h2); match; match &= match - 1)         \
+            {                                                                                      \
+                const size_t i = (pos + cSimd_ctz64(match)) & table->mask;                         \
+                if (EQ(&table->entries[i].key, key))                                               \
+                    return i;                                                                      \
+            }                                                                                      \
+            if (cHash_group_empty(group))                                                          \
+                return CHASH_NPOS;                                                                 \
+            pos = (pos + step) & table->mask;                                                      \
+        }                                                                                          \
+        return CHASH_NPOS;                                                                         \
+    }                                                                                              \
+                                                                                                   \
+    /* First EMPTY or DELETED slot on the probe sequence of hash, there is always one */           \
+    static inline size_t Table##_find_free(const Table* table, const uint64_t hash)                \
+    {                                                                                              \
+        size_t pos = (size_t) (hash >> 7) & table->mask;                                           \
+        for (size_t step = CHASH_GROUP;; step += CHASH_GROUP)                                      \
+        {                                                                                          \
+            const uint32_t free_slots = cHash_group_free(table->ctrl + pos);                       \
+            if (free_slots)                                                                        \
+                return (pos + cSimd_ctz64(free_slots)) & table->mask;                              \
+            pos = (pos + step) & table->mask;                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Purge the tombstones without moving entries that are already in the first group of their    \
+     * probe sequence. Full slots are first marked DELETED and tombstones EMPTY, then every        \
+     * DELETED entry is moved to the first free slot of its probe sequence, swapping with a not    \
+     * yet placed entry if that slot holds one */                                                  \
+    static inline void Table##_drop_deleted(Table* table)                                          \
+    {                                                                                              \
+        const size_t capacity = table->mask + 1;                                                   \
+        for (size_t i = 0; i < capacity; i++)                                                      \
+            table->ctrl[i] = (table->ctrl[i] & 0x80) ? CHASH_EMPTY : CHASH_DELETED;                \
+        memcpy(table->ctrl + capacity, table->ctrl, CHASH_GROUP);                                  \
+        for (size_t i = 0; i < capacity; i++)                                                      \
+        {                                                                                          \
+            if (table->ctrl[i] != CHASH_DELETED)                                                   \
+                continue;                                                                          \
+            const uint64_t hash = cHash_mix((uint64_t) HASH(&table->entries[i].key));              \
+            const uint8_t h2 = (uint8_t) (hash & 0x7F);                                            \
+            const size_t start = (size_t) (hash >> 7) & table->mask;                               \
+            const size_t target = Table##_find_free(table, hash);                                  \
+            if ((((i - start) & table->mask) / CHASH_GROUP) ==                                     \
+                (((target - start) & table->mask) / CHASH_GROUP))                                  \
+            {                                                                                      \
+                Table##_set_ctrl(table, i, h2);                                                    \
+                continue;                                                                          \
+            }                                                                                      \
+            if (table->ctrl[target] == CHASH_EMPTY)                                                \
+            {                                                                                      \
+                table->entries[target] = table->entries[i];                                        \
+                Table##_set_ctrl(table, target, h2);                                               \
+                Table##_set_ctrl(table, i, CHASH_EMPTY);                                           \
+                continue;                                                                          \
+            }                                                                                      \
+            const Entry tmp = table->entries[target];                                              \
+            table->entries[target] = table->entries[i];                                            \
+            table->entries[i] = tmp;                                                               \
+            Table##_set_ctrl(table, target, h2);                                                   \
+            i--; /* place the entry swapped in */                                                  \
+        }                                                                                          \
+        table->growth_left = CHASH_MAX_LOAD(capacity) - table->size;                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Slot of key, claiming a free one if it is not present (*inserted is then true and the key   \
+     * is copied, the rest of the entry is left to the caller). CHASH_NPOS if the table is full */ \
+    static inline size_t Table##_find_or_insert(Table* table, const K* key, bool* inserted)        \
+    {                                                                                              \
+        const uint64_t hash = cHash_mix((uint64_t) HASH(key));                                     \
+        size_t i = Table##_find_index(table, key, hash);                                           \
+        *inserted = false;                                                                         \
+        if (i != CHASH_NPOS)                                                                       \
+            return i;                                                                              \
+        i = Table##_find_free(table, hash);                                                        \
+        if ((table->growth_left == 0) && (table->ctrl[i] == CHASH_EMPTY))                          \
+        {                                                                                          \
+            if (table->size >= CHASH_MAX_LOAD(table->mask + 1))                                    \
+                return CHASH_NPOS;                                                                 \
+            Table##_drop_deleted(table);                                                           \
+            i = Table##_find_free(table, hash);                                                    \
+        }                                                                                          \
+        table->growth_left -= (table->ctrl[i] == CHASH_EMPTY);                                     \
+        Table##_set_ctrl(table, i, (uint8_t) (hash & 0x7F));                                       \
+        table->entries[i].key = *key;                                                              \
+        table->size++;                                                                             \
+        *inserted = true;                                                                          \
+        return i;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool Table##_contains(const Table* table, const K* key)                          \
+    {                                                                                              \
+        return Table##_find_index(table, key, cHash_mix((uint64_t) HASH(key))) != CHASH_NPOS;      \
+    }                                                                                              \
+                                                                                                   \
+    /* Remove key, false if it is not present. The slot becomes EMPTY again when no probe          \
+     * sequence can have passed over it (a whole group around it was never full), otherwise it     \
+     * becomes a tombstone */                                                                      \
+    static inline bool Table##_erase(Table* table, const K* key)                                   \
+    {                                                                                              \
+        const size_t i = Table##_find_index(table, key, cHash_mix((uint64_t) HASH(key)));          \
+        if (i == CHASH_NPOS)                                                                       \
+            return false;                                                                          \
+        const uint32_t empty_before =                                                              \
+            cHash_group_empty(table->ctrl + ((i - CHASH_GROUP) & table->mask));                    \
+        const uint32_t empty_after = cHash_group_empty(table->ctrl + i);                           \
+        const bool reuse = empty_before && empty_after &&                                          \
+                           ((cSimd_ctz64(empty_after) + (cSimd_clz64(empty_before) - 48)) <        \
+                            CHASH_GROUP);                                                          \
+        Table##_set_ctrl(table, i, reuse ? CHASH_EMPTY : CHASH_DELETED);                           \
+        table->growth_left += reuse;                                                               \
+        table->size--;                                                                             \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Advance an iterator (a slot index starting at 0) to the next entry, in slot order. Returns  \
+     * false once every entry was visited */                                                       \
+    static inline bool Table##_next(Table* table, size_t* it, Entry** out)                         \
+    {                                                                                              \
+        for (size_t i = *it; i <= table->mask; i++)                                                \
+        {                                                                                          \
+            if (! (table->ctrl[i] & 0x80))                                                         \
+            {                                                                                      \
+                *out = &table->entries[i];                                                         \
+                *it = i + 1;                                                                       \
+                return true;                                                                       \
+            }                                                                                      \
+        }                                                                                          \
+        *it = table->mask + 1;                                                                     \
+        return false;                                                                              \
+    }
+
+/**
+ * Generate a hash map from K to V over user-provided buffers, and its associated functions
+ * @param K type of the keys
+ * @param V type of the values
+ * @param HASH of signature uint64_t K_hash(const K* key), it does not need to be well distributed
+ * @param EQ of signature bool K_eq(const K* a, const K* b)
+ *
+ * @note Equal keys must have equal hashes. Keys and values are copied by assignment
+ */
+#define CHASHMAP_GENERATE(K, V, HASH, EQ)                                                          \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        K key;                                                                                     \
+        V value;                                                                                   \
+    } cHashMap_##K##_##V##_entry;                                                                  \
+                                                                                                   \
+    CHASH_GENERATE_TABLE(cHashMap_##K##_##V, cHashMap_##K##_##V##_entry, K, HASH, EQ)              \
+                                                                                                   \
+    /* Value of key, or NULL if it is not present */                                               \
+    static inline V* cHashMap_##K##_##V##_find(cHashMap_##K##_##V* map, const K* key)              \
+    {                                                                                              \
+        const uint64_t hash = cHash_mix((uint64_t) HASH(key));                                     \
+        const size_t i = cHashMap_##K##_##V##_find_index(map, key, hash);                          \
+        return (i == CHASH_NPOS) ? NULL : &map->entries[i].value;                                  \
+    }                                                                                              \
+                                                                                                   \
+    /* Insert key with value, or overwrite the value if key is present. False if the map is full   \
+     * (CHASH_MAX_LOAD entries) */                                                                 \
+    static inline bool cHashMap_##K##_##V##_insert(                                                \
+        cHashMap_##K##_##V* map, const K* key, const V* value)                                     \
+    {                                                                                              \
+        bool inserted;                                                                             \
+        const size_t i = cHashMap_##K##_##V##_find_or_insert(map, key, &inserted);                 \
+        if (i == CHASH_NPOS)                                                                       \
+            return false;                                                                          \
+        map->entries[i].value = *value;                                                            \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Value of key, inserting key with a copy of init first if it is not present (e.g. for        \
+     * counters). NULL if the map is full */                                                       \
+    static inline V* cHashMap_##K##_##V##_get_or_insert(                                           \
+        cHashMap_##K##_##V* map, const K* key, const V* init)                                      \
+    {                                                                                              \
+        bool inserted;                                                                             \
+        const size_t i = cHashMap_##K##_##V##_find_or_insert(map, key, &inserted);                 \
+        if (i == CHASH_NPOS)                                                                       \
+            return NULL;                                                                           \
+        if (inserted)                                                                              \
+            map->entries[i].value = *init;                                                         \
+        return &map->entries[i].value;                                                             \
+    }
+
+/**
+ * Generate a hash set of K over user-provided buffers, and its associated functions
+ * @param K type of the keys
+ * @param HASH of signature uint64_t K_hash(const K* key), it does not need to be well distributed
+ * @param EQ of signature bool K_eq(const K* a, const K* b)
+ */
+#define CHASHSET_GENERATE(K, HASH, EQ)                                                             \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        K key;                                                                                     \
+    } cHashSet_##K##_entry;                                                                        \
+                                                                                                   \
+    CHASH_GENERATE_TABLE(cHashSet_##K, cHashSet_##K##_entry, K, HASH, EQ)                          \
+                                                                                                   \
+    /* Add key, returns false only if it is not present and the set is full */                     \
+    static inline bool cHashSet_##K##_insert(cHashSet_##K* set, const K* key)                      \
+    {                                                                                              \
+        bool inserted;                                                                             \
+        return cHashSet_##K##_find_or_insert(set, key, &inserted) != CHASH_NPOS;                   \
+    }
+
+/* Hash and equality for integer and pointer keys, generates T_hash and T_eq */
+#define CHASH_PRIMITIVE(T)                                                                         \
+    static inline uint64_t T##_hash(const T* key)                                                  \
+    {                                                                                              \
+        return (uint64_t) *key;                                                                    \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool T##_eq(const T* a, const T* b)                                              \
+    {                                                                                              \
+        return *a == *b;                                                                           \
+    }
+
+/* Create a map from K to V with capacity (a power of two) slots statically, the user must
+ * CHASHMAP_GENERATE(K, V, HASH, EQ) before creating the map */
+#define CHASHMAP_CREATE(name, K, V, capacity)                                                      \
+    uint8_t name##_ctrl[CHASH_CTRL_BYTES(capacity)];                                               \
+    cHashMap_##K##_##V##_entry name##_entries[capacity];                                           \
+    cHashMap_##K##_##V name;                                                                       \
+    cHashMap_##K##_##V##_init_from_buffer(&name, name##_ctrl, name##_entries, capacity);
+
+/* Create a set of K with capacity (a power of two) slots statically, the user must
+ * CHASHSET_GENERATE(K, HASH, EQ) before creating the set */
+#define CHASHSET_CREATE(name, K, capacity)                                                         \
+    uint8_t name##_ctrl[CHASH_CTRL_BYTES(capacity)];                                               \
+    cHashSet_##K##_entry name##_entries[capacity];                                                 \
+    cHashSet_##K name;                                                                             \
+    cHashSet_##K##_init_from_buffer(&name, name##_ctrl, name##_entries, capacity);
+
+/* Loop over every entry of a map, e.g.
+ * cHashMap_int_float_entry* entry;
+ * CHASHMAP_FOREACH(int, float, &map, entry) { entry->key ... entry->value ... }
+ * Erasing the current entry inside the loop is allowed, inserting is not */
+#define CHASHMAP_FOREACH(K, V, map, entry)                                                         \
+    for (size_t entry##_it = 0; cHashMap_##K##_##V##_next(map, &entry##_it, &(entry));)
+
+/* Loop over every entry of a set, entry is a cHashSet_<K>_entry* */
+#define CHASHSET_FOREACH(K, set, entry)                                                            \
+    for (size_t entry##_it = 0; cHashSet_##K##_next(set, &entry##_it, &(entry));)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_HASH_MAP_H
@@ -0,0 +1,408 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * cHeap - a d-ary heap (priority queue) over a user buffer, and an indexed variant with
+ * decrease-key.
+ *
+ * The heap is an implicit tree in the array: node i has its D children at D * i + 1 to
+ * D * i + D. The element that compares smallest with CMP is on top (pass a reversed CMP for a max
+ * heap). A wider heap is shallower, log_D(n) levels, so a push does fewer comparisons and a pop
+ * touches fewer levels, and the D children of a node are contiguous (4 ints or pointers share a
+ * cache line). Moves use a hole: the sifted element is copied once at the end instead of being
+ * swapped at every level.
+ *
+ * The indexed heap orders ids in [0, capacity) by a key per id and keeps the position of every id
+ * in the heap, so the key of a queued id can be changed (or the id removed) in O(log n), as needed
+ * by Dijkstra's algorithm or a timer queue.
+ */
+
+#pragma once
+
+#ifndef CSTL_HEAP_H
+#define CSTL_HEAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Children per node of CHEAP_GENERATE and CINDEXED_HEAP_GENERATE */
+#define CHEAP_DEFAULT_ARITY 4
+
+/**
+ * Generate a D-ary min-heap of T and its associated functions, named cHeap_<name>
+ * @param name suffix of the generated names, e.g. T itself or one name per arity of the same T
+ * @param T type of the elements
+ * @param CPY of signature void T_cpy(T* dest, const T* src)
+ * @param CMP of signature int T_cmp(const T* a, const T* b), the smallest element is on top
+ * @param D children per node, at least 2
+ */
+#define CHEAP_GENERATE_D(name, T, CPY, CMP, D)                                                     \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        T* array;                                                                                  \
+        int size;                                                                                  \
+        int capacity;                                                                              \
+    } cHeap_##name;                                                                                \
+                                                                                                   \
+    /* Initialize an empty heap with the buffer and its max capacity */                            \
+    static inline void cHeap_##name##_init_from_buffer(                                            \
+        cHeap_##name* heap, T* array, const int capacity)                                          \
+    {                                                                                              \
+        heap->array = array;                                                                       \
+        heap->size = 0;                                                                            \
+        heap->capacity = capacity;                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    /* Move the element at i up until its parent is not greater */                                 \
+    static inline void cHeap_##name##_sift_up(T* a, int i)                                         \
+    {                                                                                              \
+        T moving;                                                                                  \
+        CPY(&moving, &a[i]);                                                                       \
+        while (i > 0)                                                                              \
+        {                                                                                          \
+            const int parent = (i - 1) / (D);                                                      \
+            if (CMP(&moving, &a[parent]) >= 0)                                                     \
+                break;                                                                             \
+            CPY(&a[i], &a[parent]);                                                                \
+            i = parent;                                                                            \
+        }                                                                                          \
+        CPY(&a[i], &moving);                                                                       \
+    }                                                                                              \
+                                                                                                   \
+    /* Move the element at i down the heap a[0, n) until no child is smaller */                    \
+    static inline void cHeap_##name##_sift_down(T* a, int i, const int n)                          \
+    {                                                                                              \
+        T moving;                                                                                  \
+        CPY(&moving, &a[i]);                                                                       \
+        for (;;)                                                                                   \
+        {                                                                                          \
+            const int first = ((D) * i) + 1;                                                       \
+            if (first >= n)                                                                        \
+                break;                                                                             \
+            const int last = (n - first > (D)) ? first + (D) : n;                                  \
+            int best = first;                                                                      \
+            for (int c = first + 1; c < last; c++)                                                 \
+                best = (CMP(&a[c], &a[best]) < 0) ? c : best;                                      \
+            if (CMP(&a[best], &moving) >= 0)                                                       \
+                break;                                                                             \
+            CPY(&a[i], &a[best]);                                                                  \
+            i = best;                                                                              \
+        }                                                                                          \
+        CPY(&a[i], &moving);                                                                       \
+    }                                                                                              \
+                                                                                                   \
+    /* Restore the heap order of array[0, size) in O(size), e.g. after changing elements in        \
+     * place */                                                                                    \
+    static inline void cHeap_##name##_heapify(cHeap_##name* heap)                                  \
+    {                                                                                              \
+        for (int i = (heap->size - 2) / (D); (heap->size > 1) && (i >= 0); i--)                    \
+            cHeap_##name##_sift_down(heap->array, i, heap->size);                                  \
+    }                                                                                              \
+                                                                                                   \
+    /* Initialize a heap with a buffer already holding size elements (e.g. the array and size of a \
+     * cArray), which are reordered into a heap in O(size) */                                      \
+    static inline void cHeap_##name##_init_from_array(                                             \
+        cHeap_##name* heap, T* array, const int size, const int capacity)                          \
+    {                                                                                              \
+        cHeap_##name##_init_from_buffer(heap, array, capacity);                                    \
+        heap->size = size;                                                                         \
+        cHeap_##name##_heapify(heap);                                                              \
+    }                                                                                              \
+                                                                                                   \
+    /* Add an element, false if the heap is full. O(log_D n) */                                    \
+    static inline bool cHeap_##name##_push(cHeap_##name* heap, const T* element)                   \
+    {                                                                                              \
+        if (heap->size >= heap->capacity)                                                          \
+            return false;                                                                          \
+        CPY(&heap->array[heap->size], element);                                                    \
+        cHeap_##name##_sift_up(heap->array, heap->size);                                           \
+        heap->size++;                                                                              \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Copy the smallest element to out without removing it, false if the heap is empty */         \
+    static inline bool cHeap_##name##_peek(const cHeap_##name* heap, T* out)                       \
+    {                                                                                              \
+        if (heap->size <= 0)                                                                       \
+            return false;                                                                          \
+        CPY(out, &heap->array[0]);                                                                 \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Remove the smallest element and copy it to out (if not NULL), false if the heap is empty.   \
+     * O(D log_D n) */                                                                             \
+    static inline bool cHeap_##name##_pop(cHeap_##name* heap, T* out)                              \
+    {                                                                                              \
+        if (heap->size <= 0)                                                                       \
+            return false;                                                                          \
+        if (out)                                                                                   \
+            CPY(out, &heap->array[0]);                                                             \
+        heap->size--;                                                                              \
+        if (heap->size > 0)                                                                        \
+        {                                                                                          \
+            CPY(&heap->array[0], &heap->array[heap->size]);                                        \
+            cHeap_##name##_sift_down(heap->array, 0, heap->size);                                  \
+        }                                                                                          \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Heap sort: leave the elements in array[0, size) in ascending CMP order and empty the heap.  \
+     * O(n log n), in place and not stable */                                                      \
+    static inline void cHeap_##name##_sort(cHeap_##name* heap)                                     \
+    {                                                                                              \
+        T* a = heap->array;                                                                        \
+        const int n = heap->size;                                                                  \
+        T top;                                                                                     \
+        /* popping moves the smallest to the back, which leaves the array in descending order */   \
+        for (int end = n - 1; end > 0; end--)                                                      \
+        {                                                                                          \
+            CPY(&top, &a[0]);                                                                      \
+            CPY(&a[0], &a[end]);                                                                   \
+            CPY(&a[end], &top);                                                                    \
+            cHeap_##name##_sift_down(a, 0, end);                                                   \
+        }                                                                                          \
+        for (int lo = 0, hi = n - 1; lo < hi; lo++, hi--)                                          \
+        {                                                                                          \
+            CPY(&top, &a[lo]);                                                                     \
+            CPY(&a[lo], &a[hi]);                                                                   \
+            CPY(&a[hi], &top);                                                                     \
+        }                                                                                          \
+        heap->size = 0;                                                                            \
+    }
+
+/* Generate a 4-ary min-heap of T named cHeap_<T>, see CHEAP_GENERATE_D */
+#define CHEAP_GENERATE(T, CPY, CMP) CHEAP_GENERATE_D(T, T, CPY, CMP, CHEAP_DEFAULT_ARITY)
+
+/* Create an empty heap of type T with capacity elements statically, the user must
+ * CHEAP_GENERATE(T, CPY, CMP) before creating the heap */
+#define CHEAP_CREATE(name, T, capacity)                                                            \
+    T name##_buf[capacity];                                                                        \
+    cHeap_##T name;                                                                                \
+    cHeap_##T##_init_from_buffer(&name, name##_buf, capacity);
+
+/**
+ * Generate a D-ary min-heap of ids ordered by a key of type T per id, and its associated functions,
+ * named cIndexedHeap_<name>
+ * @param name suffix of the generated names, e.g. T itself or one name per arity of the same T
+ * @param T type of the keys
+ * @param CPY of signature void T_cpy(T* dest, const T* src)
+ * @param CMP of signature int T_cmp(const T* a, const T* b), the id with the smallest key is on top
+ * @param D children per node, at least 2
+ */
+#define CINDEXED_HEAP_GENERATE_D(name, T, CPY, CMP, D)                                             \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        int* heap; /* ids in heap order */                                                         \
+        int* pos;  /* index of every id in heap, -1 if the id is not queued */                     \
+        T* keys;   /* key of every id */                                                           \
+        int size;                                                                                  \
+        int capacity; /* ids are in [0, capacity) */                                               \
+    } cIndexedHeap_##name;                                                                         \
+                                                                                                   \
+    /* Initialize an empty heap for the ids [0, capacity) with three buffers of capacity elements  \
+     * each. O(capacity) */                                                                        \
+    static inline void cIndexedHeap_##name##_init_from_buffer(                                     \
+        cIndexedHeap_##name* heap, int* ids, int* pos, T* keys, const int capacity)                \
+    {                                                                                              \
+        heap->heap = ids;                                                                          \
+        heap->pos = pos;                                                                           \
+        heap->keys = keys;                                                                         \
+        heap->size = 0;                                                                            \
+        heap->capacity = capacity;                                                                 \
+        for (int i = 0; i < capacity; i++)                                                         \
+            pos[i] = -1;                                                                           \
+    }                                                                                              \
+                                                                                                   \
+    /* Whether id is queued */                                                                     \
+    static inline bool cIndexedHeap_##name##_contains(                                             \
+        const cIndexedHeap_##name* heap, const int id)                                             \
+    {                                                                                              \
+        return (id >= 0) && (id < heap->capacity) && (heap->pos[id] >= 0);                         \
+    }                                                                                              \
+                                                                                                   \
+    /* Key of a queued id, or NULL if id is not queued */                                          \
+    static inline const T* cIndexedHeap_##name##_key(                                              \
+        const cIndexedHeap_##name* heap, const int id)                                             \
+    {                                                                                              \
+        return cIndexedHeap_##name##_contains(heap, id) ? &heap->keys[id] : NULL;                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline void cIndexedHeap_##name##_place(                                                \
+        cIndexedHeap_##name* heap, const int i, const int id)                                      \
+    {                                                                                              \
+        heap->heap[i] = id;                                                                        \
+        heap->pos[id] = i;                                                                         \
+    }                                                                                              \
+                                                                                                   \
+    static inline void cIndexedHeap_##name##_sift_up(cIndexedHeap_##name* heap, int i)             \
+    {                                                                                              \
+        const int id = heap->heap[i];                                                              \
+        while (i > 0)                                                                              \
+        {                                                                                          \
+            const int parent = (i - 1) / (D);                                                      \
+            if (CMP(&heap->keys[id], &heap->keys[heap->heap[parent]]) >= 0)                        \
+                break;                                                                             \
+            cIndexedHeap_##name##_place(heap, i, heap->heap[parent]);                              \
+            i = parent;                                                                            \
+        }                                                                                          \
+        cIndexedHeap_##name##_place(heap, i, id);                                                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline void cIndexedHeap_##name##_sift_down(cIndexedHeap_##name* heap, int i)           \
+    {                                                                                              \
+        const int id = heap->heap[i];                                                              \
+        const int n = heap->size;                                                                  \
+        for (;;)                                                                                   \
+        {                                                                                          \
+            const int first = ((D) * i) + 1;                                                       \
+            if (first >= n)                                                                        \
+                break;                                                                             \
+            const int last = (n - first > (D)) ? first + (D) : n;                                  \
+            int best = first;                                                                      \
+            for (int c = first + 1; c < last; c++)                                                 \
+            {                                                                                      \
+                const T* key = &heap->keys[heap->heap[c]];                                         \
+                best = (CMP(key, &heap->keys[heap->heap[best]]) < 0) ? c : best;                   \
+            }                                                                                      \
+            if (CMP(&heap->keys[heap->heap[best]], &heap->keys[id]) >= 0)                          \
+                break;                                                                             \
+            cIndexedHeap_##name##_place(heap, i, heap->heap[best]);                                \
+            i = best;                                                                              \
+        }                                                                                          \
+        cIndexedHeap_##name##_place(heap, i, id);                                                  \
+    }                                                                                              \
+                                                                                                   \
+    /* Queue id with key, false if id is out of range or already queued. O(log_D n) */             \
+    static inline bool cIndexedHeap_##name##_push(                                                 \
+        cIndexedHeap_##name* heap, const int id, const T* key)                                     \
+    {                                                                                              \
+        if ((id < 0) || (id >= heap->capacity) || (heap->pos[id] >= 0))                            \
+            return false;                                                                          \
+        CPY(&heap->keys[id], key);                                                                 \
+        heap->heap[heap->size] = id;                                                               \
+        heap->size++;                                                                              \
+        cIndexedHeap_##name##_sift_up(heap, heap->size - 1);                                       \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Get the id with the smallest key (and copy the key if not NULL) without removing it, false  \
+     * if the heap is empty */                                                                     \
+    static inline bool cIndexedHeap_##name##_peek(                                                 \
+        const cIndexedHeap_##name* heap, int* id, T* key)                                          \
+    {                                                                                              \
+        if (heap->size <= 0)                                                                       \
+            return false;                                                                          \
+        if (id)                                                                                    \
+            *id = heap->heap[0];                                                                   \
+        if (key)                                                                                   \
+            CPY(key, &heap->keys[heap->heap[0]]);                                                  \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Remove id from the heap, false if it is not queued. O(D log_D n) */                         \
+    static inline bool cIndexedHeap_##name##_erase(cIndexedHeap_##name* heap, const int id)        \
+    {                                                                                              \
+        if (! cIndexedHeap_##name##_contains(heap, id))                                            \
+            return false;                                                                          \
+        const int i = heap->pos[id];                                                               \
+        heap->pos[id] = -1;                                                                        \
+        heap->size--;                                                                              \
+        if (i < heap->size)                                                                        \
+        {                                                                                          \
+            /* the last id fills the hole and moves whichever way its key requires */              \
+            const int moved = heap->heap[heap->size];                                              \
+            cIndexedHeap_##name##_place(heap, i, moved);                                           \
+            cIndexedHeap_##name##_sift_up(heap, i);                                                \
+            cIndexedHeap_##name##_sift_down(heap, heap->pos[moved]);                               \
+        }                                                                                          \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Remove the id with the smallest key, copying it and its key (if not NULL), false if the     \
+     * heap is empty. O(D log_D n) */                                                              \
+    static inline bool cIndexedHeap_##name##_pop(cIndexedHeap_##name* heap, int* id, T* key)       \
+    {                                                                                              \
+        if (! cIndexedHeap_##name##_peek(heap, id, key))                                           \
+            return false;                                                                          \
+        return cIndexedHeap_##name##_erase(heap, heap->heap[0]);                                   \
+    }                                                                                              \
+                                                                                                   \
+    /* Lower the key of a queued id (move it towards the top), false if id is not queued or key is \
+     * greater than its current key. O(log_D n) */                                                 \
+    static inline bool cIndexedHeap_##name##_decrease_key(                                         \
+        cIndexedHeap_##name* heap, const int id, const T* key)                                     \
+    {                                                                                              \
+        if (! cIndexedHeap_##name##_contains(heap, id) || (CMP(key, &heap->keys[id]) > 0))         \
+            return false;                                                                          \
+        CPY(&heap->keys[id], key);                                                                 \
+        cIndexedHeap_##name##_sift_up(heap, heap->pos[id]);                                        \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Raise the key of a queued id (move it towards the bottom), false if id is not queued or key \
+     * is less than its current key. O(D log_D n) */                                               \
+    static inline bool cIndexedHeap_##name##_increase_key(                                         \
+        cIndexedHeap_##name* heap, const int id, const T* key)                                     \
+    {                                                                                              \
+        if (! cIndexedHeap_##name##_contains(heap, id) || (CMP(key, &heap->keys[id]) < 0))         \
+            return false;                                                                          \
+        CPY(&heap->keys[id], key);                                                                 \
+        cIndexedHeap_##name##_sift_down(heap, heap->pos[id]);                                      \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Remove every id, O(size) */                                                                 \
+    static inline void cIndexedHeap_##name##_clear(cIndexedHeap_##name* heap)                      \
+    {                                                                                              \
+        for (int i = 0; i < heap->size; i++)                                                       \
+            heap->pos[heap->heap[i]] = -1;                                                         \
+        heap->size = 0;                                                                            \
+    }
+
+/* Generate a 4-ary indexed min-heap of T keys named cIndexedHeap_<T>, see
+ * CINDEXED_HEAP_GENERATE_D */
+#define CINDEXED_HEAP_GENERATE(T, CPY, CMP)                                                        \
+    CINDEXED_HEAP_GENERATE_D(T, T, CPY, CMP, CHEAP_DEFAULT_ARITY)
+
+/* Create an empty indexed heap for the ids [0, capacity) with keys of type T statically, the user
+ * must CINDEXED_HEAP_GENERATE(T, CPY, CMP) before creating the heap */
+#define CINDEXED_HEAP_CREATE(name, T, capacity)                                                    \
+    int name##_ids[capacity];                                                                      \
+    int name##_pos[capacity];                                                                      \
+    T name##_keys[capacity];                                                                       \
+    cIndexedHeap_##T name;                                                                         \
+    cIndexedHeap_##T##_init_from_buffer(&name, name##_ids, name##_pos, name##_keys, capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_HEAP_H
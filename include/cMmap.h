@@ -0,0 +1,412 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * cMmap - zero-copy persistence of cArray and cBitset in memory-mapped files.
+ *
+ * A file is a 64 byte header followed by the raw buffer of the container, exactly as it is in
+ * memory. Opening a file maps it and points the container at the mapped buffer: nothing is parsed
+ * or copied, pages are only read from disk when the container touches them. The header records
+ * the format version, the element size, count and capacity and a checksum of the data, which is
+ * only checked on request since it has to read the whole file. POSIX only (mmap / msync).
+ */
+
+#pragma once
+
+#ifndef CSTL_MMAP_H
+#define CSTL_MMAP_H
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "cArray.h"
+#include "cBitset.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* First 8 bytes of every file */
+#define CMMAP_MAGIC "cSTLmap"
+/* Format version written by save, open rejects any other */
+#define CMMAP_VERSION 1
+/* Written in the native byte order, reads back differently on a machine of the other endianness */
+#define CMMAP_BYTE_ORDER 0x01020304U
+/* Max length of the path passed to save, which writes path.tmp first */
+#define CMMAP_PATH_MAX 4096
+
+/* What a file holds */
+#define CMMAP_ARRAY 1    /* cArray: count elements of elem_size bytes */
+#define CMMAP_BITSET 2   /* cBitset: count bits in capacity bytes */
+#define CMMAP_BITSET64 3 /* cBitset64: count bits in capacity uint64_t words */
+
+/* On-disk header, the data starts right after it (64 byte aligned in the mapping) */
+typedef struct
+{
+    char magic[8];         // CMMAP_MAGIC
+    uint32_t version;      // CMMAP_VERSION
+    uint32_t byte_order;   // CMMAP_BYTE_ORDER
+    uint32_t kind;         // CMMAP_ARRAY, CMMAP_BITSET or CMMAP_BITSET64
+    uint32_t header_size;  // sizeof(cMmap_header)
+    uint64_t elem_size;    // bytes per element
+    uint64_t count;        // elements in use (bits for the bitsets)
+    uint64_t capacity;     // elements the file has room for
+    uint64_t checksum;     // cMmap_checksum of the data in use (all of it for the bitsets)
+    uint64_t reserved;     // 0
+} cMmap_header;
+
+typedef enum
+{
+    CMMAP_READ_ONLY,     // shared read-only mapping, writing to the container crashes
+    CMMAP_COPY_ON_WRITE, // private mapping, changes stay in memory and are never written back
+    CMMAP_READ_WRITE,    // shared mapping, changes reach the file, flush makes them durable
+} cMmap_mode;
+
+typedef struct
+{
+    void* base;      // the mapping, starting with the header
+    size_t length;   // bytes mapped, the whole file
+    cMmap_mode mode;
+} cMmap;
+
+static inline cMmap_header* cMmap_get_header(const cMmap* map)
+{
+    return (cMmap_header*) map->base;
+}
+
+static inline void* cMmap_data(const cMmap* map)
+{
+    return (uint8_t*) map->base + sizeof(cMmap_header);
+}
+
+static inline uint64_t cMmap_rotl(const uint64_t x, const int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+/* 64-bit checksum of n bytes, in the style of xxHash64 (but not compatible with it): 4 independent
+ * lanes of 8 byte words, several GB/s. Detects torn writes and corruption, not tampering */
+static inline uint64_t cMmap_checksum(const void* data, const size_t n)
+{
+    const uint64_t p1 = 0x9E3779B185EBCA87ULL, p2 = 0xC2B2AE3D27D4EB4FULL;
+    const uint64_t p3 = 0x165667B19E3779F9ULL, p4 = 0x85EBCA77C2B2AE63ULL;
+    const uint8_t* bytes = (const uint8_t*) data;
+    uint64_t lanes[4] = {p1 + p2, p2, 0, 0 - p1};
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        for (int l = 0; l < 4; l++)
+        {
+            uint64_t word;
+            memcpy(&word, &bytes[i + (size_t) l * 8], sizeof(word));
+            lanes[l] = cMmap_rotl(lanes[l] + (word * p2), 31) * p1;
+        }
+    }
+    uint64_t h = cMmap_rotl(lanes[0], 1) + cMmap_rotl(lanes[1], 7) + cMmap_rotl(lanes[2], 12) +
+                 cMmap_rotl(lanes[3], 18) + (uint64_t) n;
+    for (; i + 8 <= n; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, &bytes[i], sizeof(word));
+        h ^= cMmap_rotl(word * p2, 31) * p1;
+        h = (cMmap_rotl(h, 27) * p1) + p4;
+    }
+    for (; i < n; i++)
+        h = cMmap_rotl(h ^ (bytes[i] * p4), 11) * p1;
+    h ^= h >> 33;
+    h *= p2;
+    h ^= h >> 29;
+    h *= p3;
+    return h ^ (h >> 32);
+}
+
+/* Bytes covered by the checksum */
+static inline uint64_t cMmap_checked_bytes(const cMmap_header* header)
+{
+    const uint64_t used = (header->kind == CMMAP_ARRAY) ? header->count : header->capacity;
+    return used * header->elem_size;
+}
+
+/* Whether count fits the capacity of the header */
+static inline bool cMmap_count_fits(const cMmap_header* header, const uint64_t count)
+{
+    if (header->kind == CMMAP_ARRAY)
+        return count <= header->capacity;
+    return ((count + 7) / 8) <= (header->capacity * header->elem_size);
+}
+
+/* Unmap the file, the container must not be used anymore */
+static inline void cMmap_close(cMmap* map)
+{
+    if (map->base)
+        munmap(map->base, map->length);
+    map->base = NULL;
+    map->length = 0;
+}
+
+/* Whether the data matches the checksum of the header, reads the whole data */
+static inline bool cMmap_verify(const cMmap* map)
+{
+    const cMmap_header* header = cMmap_get_header(map);
+    return cMmap_checksum(cMmap_data(map), (size_t) cMmap_checked_bytes(header)) ==
+           header->checksum;
+}
+
+/**
+ * Map a file written by save, checking the header (but not the checksum unless verify is set)
+ * @param kind CMMAP_ARRAY, CMMAP_BITSET or CMMAP_BITSET64, must match the file
+ * @param elem_size must match the file
+ * @return false if the file cannot be opened or mapped, or is not a valid file of that kind
+ */
+static inline bool cMmap_open(cMmap* map,
+                              const char* path,
+                              const cMmap_mode mode,
+                              const uint32_t kind,
+                              const size_t elem_size,
+                              const bool verify)
+{
+    map->base = NULL;
+    map->length = 0;
+    map->mode = mode;
+    const int fd = open(path, (mode == CMMAP_READ_WRITE) ? O_RDWR : O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (st.st_size < (off_t) sizeof(cMmap_header)))
+    {
+        close(fd);
+        return false;
+    }
+    const int prot = (mode == CMMAP_READ_ONLY) ? PROT_READ : (PROT_READ | PROT_WRITE);
+    const int flags = (mode == CMMAP_COPY_ON_WRITE) ? MAP_PRIVATE : MAP_SHARED;
+    void* base = mmap(NULL, (size_t) st.st_size, prot, flags, fd, 0);
+    close(fd); /* the mapping keeps the file open */
+    if (base == MAP_FAILED)
+        return false;
+    map->base = base;
+    map->length = (size_t) st.st_size;
+
+    const cMmap_header* header = cMmap_get_header(map);
+    const uint64_t room = (uint64_t) map->length - sizeof(cMmap_header);
+    const bool valid = (memcmp(header->magic, CMMAP_MAGIC, sizeof(header->magic)) == 0) &&
+                       (header->version == CMMAP_VERSION) &&
+                       (header->byte_order == CMMAP_BYTE_ORDER) && (header->kind == kind) &&
+                       (header->header_size == sizeof(cMmap_header)) &&
+                       (header->elem_size == elem_size) && (elem_size > 0) &&
+                       (header->capacity <= room / elem_size) &&
+                       cMmap_count_fits(header, header->count);
+    if (! valid || (verify && ! cMmap_verify(map)))
+    {
+        cMmap_close(map);
+        return false;
+    }
+    return true;
+}
+
+/* Record count in the header with a new checksum and write every modified page back to the file,
+ * returns once they are on disk. false if the mapping is not CMMAP_READ_WRITE */
+static inline bool cMmap_flush(cMmap* map, const uint64_t count)
+{
+    cMmap_header* header = cMmap_get_header(map);
+    if ((map->mode != CMMAP_READ_WRITE) || ! cMmap_count_fits(header, count))
+        return false;
+    header->count = count;
+    header->checksum = cMmap_checksum(cMmap_data(map), (size_t) cMmap_checked_bytes(header));
+    return msync(map->base, map->length, MS_SYNC) == 0;
+}
+
+/**
+ * Write a file holding capacity elements, the first bytes copied from first then second (the
+ * two halves of a wrapped queue). The file is written as path.tmp then renamed over path, so a
+ * crash leaves either the old or the new file
+ */
+static inline bool cMmap_save(const char* path,
+                              const uint32_t kind,
+                              const size_t elem_size,
+                              const uint64_t count,
+                              const uint64_t capacity,
+                              const void* first,
+                              const size_t first_bytes,
+                              const void* second,
+                              const size_t second_bytes)
+{
+    char tmp[CMMAP_PATH_MAX];
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int) sizeof(tmp))
+        return false;
+    const int fd = open(tmp, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return false;
+    /* Extend the file by writing its last byte, the hole in between takes no disk space */
+    const uint64_t length = sizeof(cMmap_header) + (capacity * elem_size);
+    const uint8_t zero = 0;
+    cMmap map = {NULL, (size_t) length, CMMAP_READ_WRITE};
+    bool ok = (lseek(fd, (off_t) (length - 1), SEEK_SET) >= 0) && (write(fd, &zero, 1) == 1);
+    if (ok)
+    {
+        map.base = mmap(NULL, map.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ok = (map.base != MAP_FAILED);
+        if (! ok)
+            map.base = NULL;
+    }
+    close(fd);
+    if (ok)
+    {
+        cMmap_header* header = cMmap_get_header(&map);
+        memset(header, 0, sizeof(cMmap_header));
+        memcpy(header->magic, CMMAP_MAGIC, sizeof(header->magic));
+        header->version = CMMAP_VERSION;
+        header->byte_order = CMMAP_BYTE_ORDER;
+        header->kind = kind;
+        header->header_size = sizeof(cMmap_header);
+        header->elem_size = elem_size;
+        header->capacity = capacity;
+        uint8_t* data = (uint8_t*) cMmap_data(&map);
+        if (first_bytes)
+            memcpy(data, first, first_bytes);
+        if (second_bytes)
+            memcpy(data + first_bytes, second, second_bytes);
+        ok = cMmap_flush(&map, count);
+        cMmap_close(&map);
+    }
+    ok = ok && (rename(tmp, path) == 0);
+    if (! ok)
+        unlink(tmp);
+    return ok;
+}
+
+/* cBitset: count is the number of bits, capacity the number of bytes */
+static inline bool cBitset_save(const cBitset* bits, const char* path)
+{
+    return cMmap_save(path, CMMAP_BITSET, 1, bits->size, CBITSET_SIZE(bits->size), bits->bitset,
+                      CBITSET_SIZE(bits->size), NULL, 0);
+}
+
+/* Point bits at the mapped file, see cMmap_open */
+static inline bool cBitset_open_mmap(cBitset* bits,
+                                     cMmap* map,
+                                     const char* path,
+                                     const cMmap_mode mode,
+                                     const bool verify)
+{
+    if (! cMmap_open(map, path, mode, CMMAP_BITSET, 1, verify))
+        return false;
+    bits->bitset = (uint8_t*) cMmap_data(map);
+    bits->size = (size_t) cMmap_get_header(map)->count;
+    return true;
+}
+
+static inline bool cBitset_flush(const cBitset* bits, cMmap* map)
+{
+    return cMmap_flush(map, bits->size);
+}
+
+/* cBitset64: count is the number of bits, capacity the number of words */
+static inline bool cBitset64_save(const cBitset64* bits, const char* path)
+{
+    return cMmap_save(path, CMMAP_BITSET64, sizeof(uint64_t), bits->size,
+                      CBITSET64_WORDS(bits->size), bits->words,
+                      CBITSET64_WORDS(bits->size) * sizeof(uint64_t), NULL, 0);
+}
+
+static inline bool cBitset64_open_mmap(cBitset64* bits,
+                                       cMmap* map,
+                                       const char* path,
+                                       const cMmap_mode mode,
+                                       const bool verify)
+{
+    if (! cMmap_open(map, path, mode, CMMAP_BITSET64, sizeof(uint64_t), verify))
+        return false;
+    bits->words = (uint64_t*) cMmap_data(map);
+    bits->size = (size_t) cMmap_get_header(map)->count;
+    return true;
+}
+
+static inline bool cBitset64_flush(const cBitset64* bits, cMmap* map)
+{
+    return cMmap_flush(map, bits->size);
+}
+
+/**
+ * Generate save / open_mmap / flush for a cArray of T, the user must CARRAY_GENERATE(T, ...) first
+ * @param T type of the array, its bytes are written as they are so it must not hold pointers
+ */
+#define CARRAY_GENERATE_MMAP(T)                                                                    \
+    /* Write the elements to path, with room for capacity elements. A queue is saved in queue      \
+     * order (head 0) */                                                                           \
+    static inline bool cArray_##T##_save(const cArray_##T* vector, const char* path)               \
+    {                                                                                              \
+        const int first = (vector->head + vector->size <= vector->capacity)                        \
+                              ? vector->size                                                       \
+                              : vector->capacity - vector->head;                                   \
+        return cMmap_save(path, CMMAP_ARRAY, sizeof(T), (uint64_t) vector->size,                   \
+                          (uint64_t) vector->capacity, &vector->array[vector->head],               \
+                          (size_t) first * sizeof(T), vector->array,                               \
+                          (size_t) (vector->size - first) * sizeof(T));                            \
+    }                                                                                              \
+                                                                                                   \
+    /* Point vector at the mapped file, with the saved size and capacity, see cMmap_open. false    \
+     * if the capacity does not fit an int */                                                      \
+    static inline bool cArray_##T##_open_mmap(cArray_##T* vector,                                  \
+                                              cMmap* map,                                          \
+                                              const char* path,                                    \
+                                              const cMmap_mode mode,                               \
+                                              const bool verify)                                   \
+    {                                                                                              \
+        if (! cMmap_open(map, path, mode, CMMAP_ARRAY, sizeof(T), verify))                         \
+            return false;                                                                          \
+        const cMmap_header* header = cMmap_get_header(map);                                        \
+        if (header->capacity > INT_MAX)                                                            \
+        {                                                                                          \
+            cMmap_close(map);                                                                      \
+            return false;                                                                          \
+        }                                                                                          \
+        cArray_##T##_init_from_buffer(vector, (T*) cMmap_data(map), (int) header->capacity);       \
+        vector->size = (int) header->count;                                                        \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Make the content of a CMMAP_READ_WRITE mapping durable, false for a wrapped queue (save it  \
+     * instead) */                                                                                 \
+    static inline bool cArray_##T##_flush(const cArray_##T* vector, cMmap* map)                    \
+    {                                                                                              \
+        if (vector->head != 0)                                                                     \
+            return false;                                                                          \
+        return cMmap_flush(map, (uint64_t) vector->size);                                          \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_MMAP_H
@@ -0,0 +1,220 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * cMpmcQueue - a lock-free bounded queue for any number of producer and consumer threads.
+ *
+ * Dmitry Vyukov's design: every slot carries a sequence number telling whether it is ready to be
+ * written for lap k or read for lap k. A producer claims a position with one compare-exchange on
+ * the enqueue counter, copies the element, then publishes the slot by bumping its sequence with a
+ * release store. Consumers do the same on the dequeue counter. Producers and consumers only meet
+ * on the slots themselves, and a slow thread only delays its own slot. Requires a C11 compiler
+ * with <stdatomic.h>.
+ */
+
+#pragma once
+
+#ifndef CSTL_MPMC_QUEUE_H
+#define CSTL_MPMC_QUEUE_H
+
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef CSTL_ALIGNAS
+#ifdef __cplusplus
+#define CSTL_ALIGNAS(n) alignas(n)
+#else
+#define CSTL_ALIGNAS(n) _Alignas(n)
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Alignment of the enqueue and dequeue counters, so producers and consumers never share a line */
+#define CMPMC_CACHE_LINE 64
+
+/* Retries of a blocking call with a CPU pause before it starts yielding the thread */
+#ifndef CMPMC_SPIN_LIMIT
+#define CMPMC_SPIN_LIMIT 64
+#endif
+
+/* Wait a little before retrying a blocking call: pause first, then give the core away */
+static inline void cMpmcQueue_backoff(unsigned* spins)
+{
+    if (*spins < CMPMC_SPIN_LIMIT)
+    {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#endif
+        (*spins)++;
+        return;
+    }
+    sched_yield();
+}
+
+/**
+ * Generate a multi-producer/multi-consumer queue of T and its associated functions
+ * @param T type of the elements
+ * @param CPY of signature void T_cpy(T* dest, const T* src)
+ */
+#define CMPMC_QUEUE_GENERATE(T, CPY)                                                               \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        _Atomic size_t sequence; /* == position: free for it, == position + 1: holds its value */  \
+        T value;                                                                                   \
+    } cMpmcQueue_##T##_slot;                                                                       \
+                                                                                                   \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        CSTL_ALIGNAS(CMPMC_CACHE_LINE) _Atomic size_t enqueue_pos; /* next position to write */    \
+        CSTL_ALIGNAS(CMPMC_CACHE_LINE) _Atomic size_t dequeue_pos; /* next position to read */     \
+        CSTL_ALIGNAS(CMPMC_CACHE_LINE) cMpmcQueue_##T##_slot* slots;                               \
+        size_t mask; /* capacity - 1 */                                                            \
+    } cMpmcQueue_##T;                                                                              \
+                                                                                                   \
+    /* Initialize an empty queue over slots, capacity must be a power of two of at least 2         \
+     * (returns false otherwise). Not atomic, finish it before sharing the queue */                \
+    static inline bool cMpmcQueue_##T##_init_from_buffer(                                          \
+        cMpmcQueue_##T* queue, cMpmcQueue_##T##_slot* slots, const size_t capacity)                \
+    {                                                                                              \
+        if ((capacity < 2) || (capacity & (capacity - 1)))                                         \
+            return false;                                                                          \
+        for (size_t i = 0; i < capacity; i++)                                                      \
+            atomic_init(&slots[i].sequence, i);                                                    \
+        atomic_init(&queue->enqueue_pos, 0);                                                       \
+        atomic_init(&queue->dequeue_pos, 0);                                                       \
+        queue->slots = slots;                                                                      \
+        queue->mask = capacity - 1;                                                                \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Append a copy of element, false if the queue is full */                                     \
+    static inline bool cMpmcQueue_##T##_try_enqueue(cMpmcQueue_##T* queue, const T* element)       \
+    {                                                                                              \
+        cMpmcQueue_##T##_slot* slot;                                                               \
+        size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);              \
+        for (;;)                                                                                   \
+        {                                                                                          \
+            slot = &queue->slots[pos & queue->mask];                                               \
+            const size_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);        \
+            const intptr_t diff = (intptr_t) seq - (intptr_t) pos;                                 \
+            if (diff == 0)                                                                         \
+            {                                                                                      \
+                /* On failure pos is reloaded with the position another producer left */           \
+                if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1,      \
+                                                          memory_order_relaxed,                    \
+                                                          memory_order_relaxed))                   \
+                    break;                                                                         \
+            }                                                                                      \
+            else if (diff < 0)                                                                     \
+            {                                                                                      \
+                return false; /* the slot still holds the value of the previous lap */             \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);             \
+            }                                                                                      \
+        }                                                                                          \
+        CPY(&slot->value, element);                                                                \
+        atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);                     \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Remove the oldest element into out (if not NULL), false if the queue is empty */            \
+    static inline bool cMpmcQueue_##T##_try_dequeue(cMpmcQueue_##T* queue, T* out)                 \
+    {                                                                                              \
+        cMpmcQueue_##T##_slot* slot;                                                               \
+        size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);              \
+        for (;;)                                                                                   \
+        {                                                                                          \
+            slot = &queue->slots[pos & queue->mask];                                               \
+            const size_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);        \
+            const intptr_t diff = (intptr_t) seq - (intptr_t) (pos + 1);                           \
+            if (diff == 0)                                                                         \
+            {                                                                                      \
+                if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + 1,      \
+                                                          memory_order_relaxed,                    \
+                                                          memory_order_relaxed))                   \
+                    break;                                                                         \
+            }                                                                                      \
+            else if (diff < 0)                                                                     \
+            {                                                                                      \
+                return false; /* the slot was not written for this lap yet */                      \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);             \
+            }                                                                                      \
+        }                                                                                          \
+        if (out)                                                                                   \
+            CPY(out, &slot->value);                                                                \
+        atomic_store_explicit(&slot->sequence, pos + queue->mask + 1, memory_order_release);       \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Append a copy of element, waiting (spinning, then yielding) while the queue is full */      \
+    static inline void cMpmcQueue_##T##_enqueue(cMpmcQueue_##T* queue, const T* element)           \
+    {                                                                                              \
+        unsigned spins = 0;                                                                        \
+        while (! cMpmcQueue_##T##_try_enqueue(queue, element))                                     \
+            cMpmcQueue_backoff(&spins);                                                            \
+    }                                                                                              \
+                                                                                                   \
+    /* Remove the oldest element into out, waiting (spinning, then yielding) while it is empty */  \
+    static inline void cMpmcQueue_##T##_dequeue(cMpmcQueue_##T* queue, T* out)                     \
+    {                                                                                              \
+        unsigned spins = 0;                                                                        \
+        while (! cMpmcQueue_##T##_try_dequeue(queue, out))                                         \
+            cMpmcQueue_backoff(&spins);                                                            \
+    }                                                                                              \
+                                                                                                   \
+    /* Number of queued elements, only a snapshot while other threads are running */               \
+    static inline size_t cMpmcQueue_##T##_size(cMpmcQueue_##T* queue)                              \
+    {                                                                                              \
+        const size_t head = atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);       \
+        const size_t tail = atomic_load_explicit(&queue->enqueue_pos, memory_order_acquire);       \
+        return (tail >= head) ? tail - head : 0;                                                   \
+    }
+
+/* Create a queue of type T with capacity (a power of two) slots statically, the user must
+ * CMPMC_QUEUE_GENERATE(T, CPY) before creating the queue */
+#define CMPMC_QUEUE_CREATE(name, T, capacity)                                                      \
+    cMpmcQueue_##T##_slot name##_slots[capacity];                                                  \
+    cMpmcQueue_##T name;                                                                           \
+    cMpmcQueue_##T##_init_from_buffer(&name, name##_slots, capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_MPMC_QUEUE_H
@@ -0,0 +1,192 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+#pragma once
+
+#ifndef CSTL_POOL_H
+#define CSTL_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cBitset.h"
+
+#ifdef __cplusplus
+#define CSTL_ALIGNAS(n) alignas(n)
+#else
+#define CSTL_ALIGNAS(n) _Alignas(n)
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Default slot alignment, one cache line so two objects never share a line */
+#define CPOOL_CACHE_LINE 64
+
+/**
+ * Generate a fixed-block pool of T with slots aligned to ALIGN bytes, and its associated functions
+ * @param T type of the objects
+ * @param ALIGN slot alignment, a power of two at least as strict as the alignment of T
+ *
+ * @note Free slots are chained in an intrusive free-list and live slots are tracked in a
+ * cBitset64, so alloc and free are O(1) and iteration skips 64 free slots per word
+ */
+#define CPOOL_GENERATE_ALIGNED(T, ALIGN)                                                           \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        CSTL_ALIGNAS(ALIGN) union                                                                  \
+        {                                                                                          \
+            T value;                                                                               \
+            int next_free; /* index of the next free slot while the slot is free */                \
+        } cell;                                                                                    \
+    } cPool_##T##_slot;                                                                            \
+                                                                                                   \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        cPool_##T##_slot* slots;                                                                   \
+        cBitset64 live; /* bit i is set while slot i is allocated */                               \
+        int size;                                                                                  \
+        int capacity;                                                                              \
+        int free_head; /* first slot of the free-list, -1 if empty */                              \
+        int untouched; /* slots from here on were never handed out */                              \
+    } cPool_##T;                                                                                   \
+                                                                                                   \
+    /* Initialize a pool with its slot buffer and a live bitmap of CBITSET64_WORDS(capacity)       \
+     * words. O(capacity / 64), slots are handed out in order before reusing freed ones */         \
+    static inline void cPool_##T##_init_from_buffer(                                               \
+        cPool_##T* pool, cPool_##T##_slot* slots, uint64_t* live_words, const int capacity)        \
+    {                                                                                              \
+        pool->slots = slots;                                                                       \
+        pool->capacity = capacity;                                                                 \
+        pool->size = 0;                                                                            \
+        pool->free_head = -1;                                                                      \
+        pool->untouched = 0;                                                                       \
+        cBitset64_init_from_buffer(&pool->live, live_words, (size_t) capacity);                    \
+    }                                                                                              \
+                                                                                                   \
+    /* Free every object at once */                                                                \
+    static inline void cPool_##T##_clear(cPool_##T* pool)                                          \
+    {                                                                                              \
+        pool->size = 0;                                                                            \
+        pool->free_head = -1;                                                                      \
+        pool->untouched = 0;                                                                       \
+        cBitset64_clear_all(&pool->live);                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Get an uninitialized slot, or NULL if the pool is full */                                   \
+    static inline T* cPool_##T##_alloc(cPool_##T* pool)                                            \
+    {                                                                                              \
+        int index;                                                                                 \
+        if (pool->free_head >= 0)                                                                  \
+        {                                                                                          \
+            index = pool->free_head;                                                               \
+            pool->free_head = pool->slots[index].cell.next_free;                                   \
+        }                                                                                          \
+        else if (pool->untouched < pool->capacity)                                                 \
+        {                                                                                          \
+            index = pool->untouched++;                                                             \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            return NULL;                                                                           \
+        }                                                                                          \
+        cBitset64_setbit(&pool->live, (size_t) index);                                             \
+        pool->size++;                                                                              \
+        return &pool->slots[index].cell.value;                                                     \
+    }                                                                                              \
+                                                                                                   \
+    /* Slot index of an object of the pool, or -1 if the pointer is not a slot of this pool */     \
+    static inline int cPool_##T##_index(const cPool_##T* pool, const T* object)                    \
+    {                                                                                              \
+        const uintptr_t base = (uintptr_t) pool->slots;                                            \
+        const uintptr_t end = base + ((uintptr_t) pool->capacity * sizeof(*pool->slots));          \
+        const uintptr_t address = (uintptr_t) object;                                              \
+        if ((address < base) || (address >= end))                                                  \
+            return -1;                                                                             \
+        if ((address - base) % sizeof(*pool->slots) != 0)                                          \
+            return -1;                                                                             \
+        return (int) ((address - base) / sizeof(*pool->slots));                                    \
+    }                                                                                              \
+                                                                                                   \
+    /* Object in slot index, or NULL if that slot is not allocated */                              \
+    static inline T* cPool_##T##_at(cPool_##T* pool, const int index)                              \
+    {                                                                                              \
+        if ((index < 0) || ! cBitset64_readbit(&pool->live, (size_t) index))                       \
+            return NULL;                                                                           \
+        return &pool->slots[index].cell.value;                                                     \
+    }                                                                                              \
+                                                                                                   \
+    /* Return an object to the pool. Returns false (and does nothing) if the pointer is not a      \
+     * live object of this pool, which also catches double frees */                                \
+    static inline bool cPool_##T##_free(cPool_##T* pool, T* object)                                \
+    {                                                                                              \
+        const int index = cPool_##T##_index(pool, object);                                         \
+        if ((index < 0) || ! cBitset64_readbit(&pool->live, (size_t) index))                       \
+            return false;                                                                          \
+        cBitset64_clearbit(&pool->live, (size_t) index);                                           \
+        pool->slots[index].cell.next_free = pool->free_head;                                       \
+        pool->free_head = index;                                                                   \
+        pool->size--;                                                                              \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Advance an iterator over the live objects (in slot order), false once all are visited */    \
+    static inline bool cPool_##T##_iter_next(cPool_##T* pool, cBitset64_iter* it, T** out)         \
+    {                                                                                              \
+        size_t index;                                                                              \
+        if (! cBitset64_iter_next(it, &index))                                                     \
+            return false;                                                                          \
+        *out = &pool->slots[index].cell.value;                                                     \
+        return true;                                                                               \
+    }
+
+/* Generate a pool of T with cache-line aligned slots */
+#define CPOOL_GENERATE(T) CPOOL_GENERATE_ALIGNED(T, CPOOL_CACHE_LINE)
+
+/* Create a pool of type T with capacity slots statically, the user must CPOOL_GENERATE(T) before
+ * creating the pool */
+#define CPOOL_CREATE(name, T, capacity)                                                            \
+    cPool_##T##_slot name##_slots[capacity];                                                       \
+    uint64_t name##_live[CBITSET64_WORDS(capacity)];                                               \
+    cPool_##T name;                                                                                \
+    cPool_##T##_init_from_buffer(&name, name##_slots, name##_live, capacity);
+
+/* Loop over every live object of a pool, e.g.
+ * MyStruct* obj;
+ * CPOOL_FOREACH(MyStruct, &pool, obj) { ... }
+ * Freeing the current object inside the loop is allowed */
+#define CPOOL_FOREACH(T, pool, obj)                                                                \
+    for (cBitset64_iter obj##_it = cBitset64_iter_begin(&(pool)->live);                            \
+         cPool_##T##_iter_next(pool, &obj##_it, &(obj));)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_POOL_H
@@ -0,0 +1,1066 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * cRoaring - compressed bitset over the full uint32_t universe.
+ *
+ * The universe is split into 2^16 chunks keyed by the high 16 bits of each value. Only non-empty
+ * chunks are stored, each one as whichever of these is smallest:
+ *  - array:  sorted uint16_t low bits, 2 bytes per value (up to 4096 values)
+ *  - bitmap: 65536 bits, 8 KB
+ *  - runs:   sorted (start, length - 1) uint16_t pairs, 4 bytes per run of consecutive values
+ *
+ * Both the chunk table and the chunk contents live in user-provided buffers (no malloc). The
+ * contents are packed in key order in the data buffer, each chunk keeping some slack to grow.
+ * When the data buffer is full, the slack is reclaimed before giving up.
+ */
+
+#pragma once
+
+#ifndef CSTL_ROARING_H
+#define CSTL_ROARING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cBitset.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define CROARING_ARRAY 0
+#define CROARING_BITMAP 1
+#define CROARING_RUN 2
+
+/* Largest array chunk, past this a bitmap is smaller */
+#define CROARING_ARRAY_MAX 4096
+/* Words (uint64_t) of a bitmap chunk, no chunk ever needs more */
+#define CROARING_BITMAP_WORDS 1024
+
+typedef struct
+{
+    uint32_t offset;      // start of the chunk contents in the data buffer, in words
+    uint32_t capacity;    // words reserved for the chunk contents
+    uint32_t cardinality; // number of values in the chunk (up to 65536)
+    uint32_t runs;        // number of runs, for run chunks
+    uint16_t key;         // high 16 bits shared by every value of the chunk
+    uint16_t type;        // CROARING_ARRAY, CROARING_BITMAP or CROARING_RUN
+} cRoaring_chunk;
+
+typedef struct
+{
+    cRoaring_chunk* chunks; // user-provided chunk table, sorted by key
+    uint64_t* data;         // user-provided storage for the chunk contents
+    int num_chunks;
+    int max_chunks;
+    size_t used;     // words of data in use (including slack)
+    size_t capacity; // words of data available
+} cRoaring;
+
+/* Create a cRoaring with a chunk table of max_chunks entries and data_words words of storage */
+#define CROARING_CREATE(name, max_chunks, data_words)                                              \
+    cRoaring_chunk name##_chunks[max_chunks];                                                      \
+    uint64_t name##_data[data_words];                                                              \
+    cRoaring name;                                                                                 \
+    cRoaring_init_from_buffer(&name, name##_chunks, max_chunks, name##_data, data_words);
+
+/* Initialize an empty cRoaring with your buffers. At most max_chunks distinct chunks (values with
+ * different high 16 bits) can be stored, and their contents must fit in data_words words */
+static inline void cRoaring_init_from_buffer(cRoaring* r,
+                                             cRoaring_chunk* chunks,
+                                             const int max_chunks,
+                                             uint64_t* data,
+                                             const size_t data_words)
+{
+    r->chunks = chunks;
+    r->max_chunks = max_chunks;
+    r->num_chunks = 0;
+    r->data = data;
+    r->capacity = data_words;
+    r->used = 0;
+}
+
+/* Remove all values */
+static inline void cRoaring_clear_all(cRoaring* r)
+{
+    r->num_chunks = 0;
+    r->used = 0;
+}
+
+/* Contents of a chunk, viewed as uint16_t values (arrays, runs) or 64-bit words (bitmaps) */
+static inline uint16_t* cRoaring_values(const cRoaring* r, const cRoaring_chunk* c)
+{
+    return (uint16_t*) (r->data + c->offset);
+}
+
+static inline uint64_t* cRoaring_words(const cRoaring* r, const cRoaring_chunk* c)
+{
+    return r->data + c->offset;
+}
+
+/* Words needed to store a chunk of the given type */
+static inline uint32_t cRoaring_words_needed(const uint16_t type,
+                                             const uint32_t cardinality,
+                                             const uint32_t runs)
+{
+    if (type == CROARING_ARRAY)
+        return (cardinality + 3) / 4;
+    if (type == CROARING_RUN)
+        return (runs + 1) / 2;
+    return CROARING_BITMAP_WORDS;
+}
+
+/* Index of the chunk with this key, or -(insertion point + 1) if there is none */
+static inline int cRoaring_find_chunk(const cRoaring* r, const uint16_t key)
+{
+    int head = 0, tail = r->num_chunks - 1;
+    while (head <= tail)
+    {
+        int mid = head + (tail - head) / 2;
+        if (r->chunks[mid].key < key)
+            head = mid + 1;
+        else if (r->chunks[mid].key > key)
+            tail = mid - 1;
+        else
+            return mid;
+    }
+    return -(head + 1);
+}
+
+/* First index in values[0, n) whose value is >= x */
+static inline uint32_t cRoaring_lower_bound16(const uint16_t* values, uint32_t n, const uint16_t x)
+{
+    uint32_t base = 0;
+    while (n > 1)
+    {
+        const uint32_t half = n / 2;
+        base = (values[base + half - 1] < x) ? base + half : base;
+        n -= half;
+    }
+    return base + ((n == 1) && (values[base] < x));
+}
+
+/* Index of the last run starting at or before x, or -1 */
+static inline int cRoaring_run_find(const uint16_t* runs, const uint32_t num_runs, const uint16_t x)
+{
+    int head = 0, tail = (int) num_runs - 1, found = -1;
+    while (head <= tail)
+    {
+        int mid = head + (tail - head) / 2;
+        if (runs[2 * mid] <= x)
+        {
+            found = mid;
+            head = mid + 1;
+        }
+        else
+        {
+            tail = mid - 1;
+        }
+    }
+    return found;
+}
+
+/* Shrink the capacity of every chunk to what it needs, so the free space is at the end */
+static inline void cRoaring_compact(cRoaring* r)
+{
+    uint32_t offset = 0;
+    for (int i = 0; i < r->num_chunks; i++)
+    {
+        cRoaring_chunk* c = &r->chunks[i];
+        const uint32_t needed = cRoaring_words_needed(c->type, c->cardinality, c->runs);
+        /* Offsets only move down, so moving the chunks in order never overwrites one */
+        if (c->offset != offset)
+            memmove(r->data + offset, r->data + c->offset, needed * sizeof(uint64_t));
+        c->offset = offset;
+        c->capacity = needed;
+        offset += needed;
+    }
+    r->used = offset;
+}
+
+/* Move the contents of chunks [from, num_chunks) by delta words (the space must be available) */
+static inline void cRoaring_shift_chunks(cRoaring* r, const int from, const ptrdiff_t delta)
+{
+    if (from >= r->num_chunks)
+        return;
+    const size_t start = r->chunks[from].offset;
+    memmove(r->data + start + delta, r->data + start, (r->used - start) * sizeof(uint64_t));
+    for (int i = from; i < r->num_chunks; i++)
+        r->chunks[i].offset = (uint32_t) ((ptrdiff_t) r->chunks[i].offset + delta);
+}
+
+/* Make sure chunk idx can hold at least words words. Grows geometrically, and reclaims the slack
+ * of every chunk if the data buffer is full. Pointers into the data are invalidated */
+static inline bool cRoaring_reserve(cRoaring* r, const int idx, const uint32_t words)
+{
+    if (r->chunks[idx].capacity >= words)
+        return true;
+
+    uint32_t grown = r->chunks[idx].capacity * 2;
+    if (grown < words)
+        grown = words;
+    if (grown > CROARING_BITMAP_WORDS)
+        grown = (words > CROARING_BITMAP_WORDS) ? words : CROARING_BITMAP_WORDS;
+
+    uint32_t new_capacity = grown;
+    if (r->used + (new_capacity - r->chunks[idx].capacity) > r->capacity)
+    {
+        cRoaring_compact(r);
+        if (r->chunks[idx].capacity >= words)
+            return true;
+        new_capacity = (r->used + (grown - r->chunks[idx].capacity) <= r->capacity) ? grown : words;
+        if (r->used + (new_capacity - r->chunks[idx].capacity) > r->capacity)
+            return false;
+    }
+
+    const ptrdiff_t delta = (ptrdiff_t) new_capacity - (ptrdiff_t) r->chunks[idx].capacity;
+    cRoaring_shift_chunks(r, idx + 1, delta);
+    r->chunks[idx].capacity = new_capacity;
+    r->used += (size_t) delta;
+    return true;
+}
+
+/* Insert an empty array chunk for key at index pos */
+static inline bool cRoaring_insert_chunk(cRoaring* r, const int pos, const uint16_t key)
+{
+    if (r->num_chunks >= r->max_chunks)
+        return false;
+    const uint32_t offset = (pos < r->num_chunks) ? r->chunks[pos].offset : (uint32_t) r->used;
+    memmove(&r->chunks[pos + 1], &r->chunks[pos], (r->num_chunks - pos) * sizeof(cRoaring_chunk));
+    r->num_chunks++;
+
+    cRoaring_chunk* c = &r->chunks[pos];
+    c->offset = offset;
+    c->capacity = 0;
+    c->cardinality = 0;
+    c->runs = 0;
+    c->key = key;
+    c->type = CROARING_ARRAY;
+    return true;
+}
+
+/* Remove chunk idx and release its storage */
+static inline void cRoaring_remove_chunk(cRoaring* r, const int idx)
+{
+    const ptrdiff_t capacity = (ptrdiff_t) r->chunks[idx].capacity;
+    cRoaring_shift_chunks(r, idx + 1, -capacity);
+    r->used -= (size_t) capacity;
+    memmove(&r->chunks[idx],
+            &r->chunks[idx + 1],
+            (r->num_chunks - idx - 1) * sizeof(cRoaring_chunk));
+    r->num_chunks--;
+}
+
+/* Expand a chunk into a 65536-bit bitmap */
+static inline void cRoaring_chunk_to_bitmap(const cRoaring* r,
+                                            const cRoaring_chunk* c,
+                                            uint64_t* bitmap)
+{
+    if (c->type == CROARING_BITMAP)
+    {
+        memcpy(bitmap, cRoaring_words(r, c), CROARING_BITMAP_WORDS * sizeof(uint64_t));
+        return;
+    }
+    memset(bitmap, 0, CROARING_BITMAP_WORDS * sizeof(uint64_t));
+    const uint16_t* values = cRoaring_values(r, c);
+    if (c->type == CROARING_ARRAY)
+    {
+        for (uint32_t i = 0; i < c->cardinality; i++)
+            bitmap[values[i] / 64] |= 1ULL << (values[i] % 64);
+        return;
+    }
+    cBitset64 view = {bitmap, 65536};
+    for (uint32_t i = 0; i < c->runs; i++)
+        cBitset64_set_range(&view, values[2 * i], (size_t) values[2 * i] + values[2 * i + 1]);
+}
+
+/* Number of runs of consecutive set bits in a bitmap */
+static inline uint32_t cRoaring_bitmap_runs(const uint64_t* bitmap)
+{
+    uint32_t runs = 0;
+    uint64_t carry = 0;
+    for (uint32_t i = 0; i < CROARING_BITMAP_WORDS; i++)
+    {
+        const uint64_t w = bitmap[i];
+        /* A run starts on every set bit whose lower neighbour is clear */
+        runs += cSimd_popcount64(w & ~((w << 1) | carry));
+        carry = w >> 63;
+    }
+    return runs;
+}
+
+/* Store a bitmap into chunk idx as the smallest of array, bitmap or runs. An empty bitmap removes
+ * the chunk. Returns false if the data buffer is full */
+static inline bool cRoaring_store_bitmap(cRoaring* r, const int idx, const uint64_t* bitmap)
+{
+    cBitset64 view = {(uint64_t*) bitmap, 65536};
+    const uint32_t cardinality = (uint32_t) cBitset64_count(&view);
+    if (cardinality == 0)
+    {
+        cRoaring_remove_chunk(r, idx);
+        return true;
+    }
+
+    const uint32_t runs = cRoaring_bitmap_runs(bitmap);
+    uint16_t type = CROARING_BITMAP;
+    size_t bytes = CROARING_BITMAP_WORDS * sizeof(uint64_t);
+    if ((cardinality <= CROARING_ARRAY_MAX) && ((size_t) cardinality * 2 <= bytes))
+    {
+        type = CROARING_ARRAY;
+        bytes = (size_t) cardinality * 2;
+    }
+    if ((size_t) runs * 4 < bytes)
+        type = CROARING_RUN;
+
+    if (! cRoaring_reserve(r, idx, cRoaring_words_needed(type, cardinality, runs)))
+        return false;
+    cRoaring_chunk* c = &r->chunks[idx];
+    c->type = type;
+    c->cardinality = cardinality;
+    c->runs = (type == CROARING_RUN) ? runs : 0;
+
+    if (type == CROARING_BITMAP)
+    {
+        memcpy(cRoaring_words(r, c), bitmap, CROARING_BITMAP_WORDS * sizeof(uint64_t));
+        return true;
+    }
+    uint16_t* values = cRoaring_values(r, c);
+    size_t n, k = 0;
+    if (type == CROARING_ARRAY)
+    {
+        CBITSET64_FOREACH(&view, n)
+        {
+            values[k++] = (uint16_t) n;
+        }
+        return true;
+    }
+    n = cBitset64_find_next(&view, 0);
+    while (n != CBITSET_NPOS)
+    {
+        size_t end = cBitset64_find_next_zero(&view, n);
+        end = (end == CBITSET_NPOS) ? 65536 : end;
+        values[k++] = (uint16_t) n;
+        values[k++] = (uint16_t) (end - n - 1);
+        n = (end < 65536) ? cBitset64_find_next(&view, end) : CBITSET_NPOS;
+    }
+    return true;
+}
+
+/* Store sorted, distinct values (at most CROARING_ARRAY_MAX) into chunk idx as an array or runs,
+ * whichever is smaller. No values removes the chunk */
+static inline bool cRoaring_store_array(cRoaring* r,
+                                        const int idx,
+                                        const uint16_t* values,
+                                        const uint32_t n)
+{
+    if (n == 0)
+    {
+        cRoaring_remove_chunk(r, idx);
+        return true;
+    }
+    uint32_t runs = 1;
+    for (uint32_t i = 1; i < n; i++)
+        runs += (values[i] != (uint16_t) (values[i - 1] + 1));
+
+    const uint16_t type = ((size_t) runs * 4 < (size_t) n * 2) ? CROARING_RUN : CROARING_ARRAY;
+    if (! cRoaring_reserve(r, idx, cRoaring_words_needed(type, n, runs)))
+        return false;
+    cRoaring_chunk* c = &r->chunks[idx];
+    c->type = type;
+    c->cardinality = n;
+    c->runs = (type == CROARING_RUN) ? runs : 0;
+
+    uint16_t* out = cRoaring_values(r, c);
+    if (type == CROARING_ARRAY)
+    {
+        memcpy(out, values, n * sizeof(uint16_t));
+        return true;
+    }
+    uint32_t k = 0, start = 0;
+    for (uint32_t i = 1; i <= n; i++)
+    {
+        if ((i == n) || (values[i] != (uint16_t) (values[i - 1] + 1)))
+        {
+            out[k++] = values[start];
+            out[k++] = (uint16_t) (i - start - 1);
+            start = i;
+        }
+    }
+    return true;
+}
+
+/* Re-pack chunk idx in its smallest form */
+static inline bool cRoaring_repack_chunk(cRoaring* r, const int idx)
+{
+    uint64_t bitmap[CROARING_BITMAP_WORDS];
+    cRoaring_chunk_to_bitmap(r, &r->chunks[idx], bitmap);
+    return cRoaring_store_bitmap(r, idx, bitmap);
+}
+
+/* Whether a run chunk is no longer the smallest representation */
+static inline bool cRoaring_runs_too_big(const cRoaring_chunk* c)
+{
+    const size_t run_bytes = (size_t) c->runs * 4;
+    if ((c->cardinality <= CROARING_ARRAY_MAX) && (run_bytes > (size_t) c->cardinality * 2))
+        return true;
+    return run_bytes > CROARING_BITMAP_WORDS * sizeof(uint64_t);
+}
+
+/* Whether the low 16 bits x are in chunk c */
+static inline bool cRoaring_chunk_contains(const cRoaring* r,
+                                           const cRoaring_chunk* c,
+                                           const uint16_t x)
+{
+    if (c->type == CROARING_BITMAP)
+        return (cRoaring_words(r, c)[x / 64] >> (x % 64)) & 1U;
+    const uint16_t* values = cRoaring_values(r, c);
+    if (c->type == CROARING_ARRAY)
+    {
+        const uint32_t pos = cRoaring_lower_bound16(values, c->cardinality, x);
+        return (pos < c->cardinality) && (values[pos] == x);
+    }
+    const int run = cRoaring_run_find(values, c->runs, x);
+    return (run >= 0) && ((uint32_t) x - values[2 * run] <= values[2 * run + 1]);
+}
+
+/* Remove the low 16 bits x from chunk idx, removing the chunk once it is empty */
+static inline bool cRoaring_chunk_remove(cRoaring* r, const int idx, const uint16_t x)
+{
+    cRoaring_chunk* c = &r->chunks[idx];
+    if (c->type == CROARING_BITMAP)
+    {
+        uint64_t* words = cRoaring_words(r, c);
+        const uint64_t bit = 1ULL << (x % 64);
+        if (! (words[x / 64] & bit))
+            return true;
+        words[x / 64] &= ~bit;
+        c->cardinality--;
+        return (c->cardinality <= CROARING_ARRAY_MAX) ? cRoaring_repack_chunk(r, idx) : true;
+    }
+
+    if (c->type == CROARING_ARRAY)
+    {
+        uint16_t* values = cRoaring_values(r, c);
+        const uint32_t pos = cRoaring_lower_bound16(values, c->cardinality, x);
+        if ((pos >= c->cardinality) || (values[pos] != x))
+            return true;
+        memmove(&values[pos], &values[pos + 1], (c->cardinality - pos - 1) * sizeof(uint16_t));
+        c->cardinality--;
+        if (c->cardinality == 0)
+            cRoaring_remove_chunk(r, idx);
+        return true;
+    }
+
+    uint16_t* runs = cRoaring_values(r, c);
+    const int run = cRoaring_run_find(runs, c->runs, x);
+    if ((run < 0) || ((uint32_t) x - runs[2 * run] > runs[2 * run + 1]))
+        return true;
+    const uint32_t start = runs[2 * run], end = start + runs[2 * run + 1];
+
+    if (start == end)
+    {
+        memmove(&runs[2 * run], &runs[2 * run + 2], (c->runs - run - 1) * 2 * sizeof(uint16_t));
+        c->runs--;
+    }
+    else if (x == start)
+    {
+        runs[2 * run]++;
+        runs[2 * run + 1]--;
+    }
+    else if (x == end)
+    {
+        runs[2 * run + 1]--;
+    }
+    else
+    {
+        /* x splits the run in two */
+        if (! cRoaring_reserve(r, idx, cRoaring_words_needed(CROARING_RUN, 0, c->runs + 1)))
+            return false;
+        c = &r->chunks[idx];
+        runs = cRoaring_values(r, c);
+        memmove(&runs[2 * run + 2], &runs[2 * run], (c->runs - run) * 2 * sizeof(uint16_t));
+        runs[2 * run + 1] = (uint16_t) (x - start - 1);
+        runs[2 * run + 2] = (uint16_t) (x + 1);
+        runs[2 * run + 3] = (uint16_t) (end - x - 1);
+        c->runs++;
+    }
+    c->cardinality--;
+    if (c->cardinality == 0)
+    {
+        cRoaring_remove_chunk(r, idx);
+        return true;
+    }
+    return cRoaring_runs_too_big(c) ? cRoaring_repack_chunk(r, idx) : true;
+}
+
+/* Add the low 16 bits x to chunk idx, leaving the chunk unchanged if there is no room */
+static inline bool cRoaring_chunk_add(cRoaring* r, const int idx, const uint16_t x)
+{
+    cRoaring_chunk* c = &r->chunks[idx];
+    if (c->type == CROARING_BITMAP)
+    {
+        uint64_t* words = cRoaring_words(r, c);
+        const uint64_t bit = 1ULL << (x % 64);
+        c->cardinality += (words[x / 64] & bit) ? 0 : 1;
+        words[x / 64] |= bit;
+        return true;
+    }
+
+    if (c->type == CROARING_ARRAY)
+    {
+        const uint32_t pos = cRoaring_lower_bound16(cRoaring_values(r, c), c->cardinality, x);
+        if ((pos < c->cardinality) && (cRoaring_values(r, c)[pos] == x))
+            return true;
+        if (c->cardinality >= CROARING_ARRAY_MAX)
+        {
+            uint64_t bitmap[CROARING_BITMAP_WORDS];
+            cRoaring_chunk_to_bitmap(r, c, bitmap);
+            bitmap[x / 64] |= 1ULL << (x % 64);
+            return cRoaring_store_bitmap(r, idx, bitmap);
+        }
+        const uint32_t words = cRoaring_words_needed(CROARING_ARRAY, c->cardinality + 1, 0);
+        if (! cRoaring_reserve(r, idx, words))
+            return false;
+        c = &r->chunks[idx];
+        uint16_t* values = cRoaring_values(r, c);
+        memmove(&values[pos + 1], &values[pos], (c->cardinality - pos) * sizeof(uint16_t));
+        values[pos] = x;
+        c->cardinality++;
+        return true;
+    }
+
+    uint16_t* runs = cRoaring_values(r, c);
+    const int prev = cRoaring_run_find(runs, c->runs, x);
+    const uint32_t prev_end = (prev >= 0) ? (uint32_t) runs[2 * prev] + runs[2 * prev + 1] : 0;
+    if ((prev >= 0) && (x <= prev_end))
+        return true;
+    const int next = prev + 1;
+    const bool joins_prev = (prev >= 0) && (prev_end + 1 == x);
+    const bool joins_next = ((uint32_t) next < c->runs) && ((uint32_t) x + 1 == runs[2 * next]);
+
+    if (joins_prev && joins_next)
+    {
+        /* x fills the gap between two runs, merge them */
+        runs[2 * prev + 1] = (uint16_t) (runs[2 * prev + 1] + runs[2 * next + 1] + 2);
+        memmove(&runs[2 * next],
+                &runs[2 * next + 2],
+                (c->runs - next - 1) * 2 * sizeof(uint16_t));
+        c->runs--;
+    }
+    else if (joins_prev)
+    {
+        runs[2 * prev + 1]++;
+    }
+    else if (joins_next)
+    {
+        runs[2 * next]--;
+        runs[2 * next + 1]++;
+    }
+    else
+    {
+        if (! cRoaring_reserve(r, idx, cRoaring_words_needed(CROARING_RUN, 0, c->runs + 1)))
+            return false;
+        c = &r->chunks[idx];
+        runs = cRoaring_values(r, c);
+        memmove(&runs[2 * next + 2], &runs[2 * next], (c->runs - next) * 2 * sizeof(uint16_t));
+        runs[2 * next] = x;
+        runs[2 * next + 1] = 0;
+        c->runs++;
+    }
+    c->cardinality++;
+    if (! cRoaring_runs_too_big(c) || cRoaring_repack_chunk(r, idx))
+        return true;
+    /* No room to re-pack: take x back out, which reuses the space it was added in */
+    cRoaring_chunk_remove(r, idx, x);
+    return false;
+}
+
+/* Read bit n */
+static inline bool cRoaring_readbit(const cRoaring* r, const uint32_t n)
+{
+    const int idx = cRoaring_find_chunk(r, (uint16_t) (n >> 16));
+    if (idx < 0)
+        return false;
+    return cRoaring_chunk_contains(r, &r->chunks[idx], (uint16_t) n);
+}
+
+/* Set bit n to 1. Returns false if the buffers are full (the bitset is left unchanged) */
+static inline bool cRoaring_setbit(cRoaring* r, const uint32_t n)
+{
+    const uint16_t key = (uint16_t) (n >> 16);
+    int idx = cRoaring_find_chunk(r, key);
+    if (idx < 0)
+    {
+        idx = -idx - 1;
+        if (! cRoaring_insert_chunk(r, idx, key))
+            return false;
+    }
+    if (cRoaring_chunk_add(r, idx, (uint16_t) n))
+        return true;
+    if (r->chunks[idx].cardinality == 0)
+        cRoaring_remove_chunk(r, idx);
+    return false;
+}
+
+/* Set bit n to 0. Returns false if splitting or re-packing a run needed more space than is left
+ * (the bit may already be cleared) */
+static inline bool cRoaring_clearbit(cRoaring* r, const uint32_t n)
+{
+    const int idx = cRoaring_find_chunk(r, (uint16_t) (n >> 16));
+    if (idx < 0)
+        return true;
+    return cRoaring_chunk_remove(r, idx, (uint16_t) n);
+}
+
+/* Toggle bit n. Returns false if the buffers are full */
+static inline bool cRoaring_togglebit(cRoaring* r, const uint32_t n)
+{
+    return cRoaring_readbit(r, n) ? cRoaring_clearbit(r, n) : cRoaring_setbit(r, n);
+}
+
+/* Set (value = true) or clear (value = false) every bit in [start, end] */
+static inline bool cRoaring_assign_range(cRoaring* r,
+                                         const uint32_t start,
+                                         const uint32_t end,
+                                         const bool value)
+{
+    if (start > end)
+        return true;
+    uint64_t bitmap[CROARING_BITMAP_WORDS];
+    cBitset64 view = {bitmap, 65536};
+    for (uint32_t key = start >> 16; key <= (end >> 16); key++)
+    {
+        const uint32_t lo = (key == (start >> 16)) ? (start & 0xFFFF) : 0;
+        const uint32_t hi = (key == (end >> 16)) ? (end & 0xFFFF) : 0xFFFF;
+        int idx = cRoaring_find_chunk(r, (uint16_t) key);
+        if (idx < 0)
+        {
+            if (! value)
+                continue;
+            idx = -idx - 1;
+            if (! cRoaring_insert_chunk(r, idx, (uint16_t) key))
+                return false;
+            memset(bitmap, 0, sizeof(bitmap));
+        }
+        else
+        {
+            cRoaring_chunk_to_bitmap(r, &r->chunks[idx], bitmap);
+        }
+        cBitset64_assign_range(&view, lo, hi, value);
+        if (! cRoaring_store_bitmap(r, idx, bitmap))
+        {
+            if (r->chunks[idx].cardinality == 0)
+                cRoaring_remove_chunk(r, idx);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Set every bit in [start, end] to 1 */
+static inline bool cRoaring_set_range(cRoaring* r, const uint32_t start, const uint32_t end)
+{
+    return cRoaring_assign_range(r, start, end, true);
+}
+
+/* Set every bit in [start, end] to 0 */
+static inline bool cRoaring_clear_range(cRoaring* r, const uint32_t start, const uint32_t end)
+{
+    return cRoaring_assign_range(r, start, end, false);
+}
+
+/* Number of set bits */
+static inline uint64_t cRoaring_count(const cRoaring* r)
+{
+    uint64_t count = 0;
+    for (int i = 0; i < r->num_chunks; i++)
+        count += r->chunks[i].cardinality;
+    return count;
+}
+
+/* Convert every chunk to its smallest form (including runs, which setbit alone never creates from
+ * an array or bitmap) and reclaim the slack */
+static inline void cRoaring_optimize(cRoaring* r)
+{
+    for (int i = 0; i < r->num_chunks; i++)
+    {
+        /* Never grows the chunk, the current form is one of the candidates */
+        cRoaring_repack_chunk(r, i);
+    }
+    cRoaring_compact(r);
+}
+
+/* Append a copy of chunk src of a to r, r must not have a chunk with a larger key */
+static inline bool cRoaring_append_copy(cRoaring* r, const cRoaring* a, const cRoaring_chunk* src)
+{
+    const int idx = r->num_chunks;
+    if (! cRoaring_insert_chunk(r, idx, src->key))
+        return false;
+    const uint32_t words = cRoaring_words_needed(src->type, src->cardinality, src->runs);
+    if (! cRoaring_reserve(r, idx, words))
+    {
+        cRoaring_remove_chunk(r, idx);
+        return false;
+    }
+    cRoaring_chunk* c = &r->chunks[idx];
+    memcpy(cRoaring_words(r, c), cRoaring_words(a, src), words * sizeof(uint64_t));
+    c->type = src->type;
+    c->cardinality = src->cardinality;
+    c->runs = src->runs;
+    return true;
+}
+
+/* dst = a | b. dst must be a different cRoaring than a and b, its previous contents are dropped.
+ * Returns false if dst runs out of space */
+static inline bool cRoaring_or(cRoaring* dst, const cRoaring* a, const cRoaring* b)
+{
+    cRoaring_clear_all(dst);
+    uint64_t bitmap[CROARING_BITMAP_WORDS], other[CROARING_BITMAP_WORDS];
+    uint16_t merged[2 * CROARING_ARRAY_MAX];
+    int i = 0, j = 0;
+    while ((i < a->num_chunks) || (j < b->num_chunks))
+    {
+        const cRoaring_chunk* ca = (i < a->num_chunks) ? &a->chunks[i] : NULL;
+        const cRoaring_chunk* cb = (j < b->num_chunks) ? &b->chunks[j] : NULL;
+        if (! cb || (ca && (ca->key < cb->key)))
+        {
+            if (! cRoaring_append_copy(dst, a, ca))
+                return false;
+            i++;
+            continue;
+        }
+        if (! ca || (cb->key < ca->key))
+        {
+            if (! cRoaring_append_copy(dst, b, cb))
+                return false;
+            j++;
+            continue;
+        }
+
+        const int idx = dst->num_chunks;
+        if (! cRoaring_insert_chunk(dst, idx, ca->key))
+            return false;
+        bool stored;
+        if ((ca->type == CROARING_ARRAY) && (cb->type == CROARING_ARRAY))
+        {
+            /* Merge the two sorted arrays */
+            const uint16_t* va = cRoaring_values(a, ca);
+            const uint16_t* vb = cRoaring_values(b, cb);
+            uint32_t x = 0, y = 0, n = 0;
+            while ((x < ca->cardinality) && (y < cb->cardinality))
+            {
+                const uint16_t lo = (va[x] <= vb[y]) ? va[x] : vb[y];
+                x += (va[x] == lo);
+                y += (vb[y] == lo);
+                merged[n++] = lo;
+            }
+            while (x < ca->cardinality)
+                merged[n++] = va[x++];
+            while (y < cb->cardinality)
+                merged[n++] = vb[y++];
+
+            if (n <= CROARING_ARRAY_MAX)
+            {
+                stored = cRoaring_store_array(dst, idx, merged, n);
+            }
+            else
+            {
+                memset(bitmap, 0, sizeof(bitmap));
+                for (uint32_t k = 0; k < n; k++)
+                    bitmap[merged[k] / 64] |= 1ULL << (merged[k] % 64);
+                stored = cRoaring_store_bitmap(dst, idx, bitmap);
+            }
+        }
+        else
+        {
+            cRoaring_chunk_to_bitmap(a, ca, bitmap);
+            if (cb->type == CROARING_ARRAY)
+            {
+                const uint16_t* vb = cRoaring_values(b, cb);
+                for (uint32_t k = 0; k < cb->cardinality; k++)
+                    bitmap[vb[k] / 64] |= 1ULL << (vb[k] % 64);
+            }
+            else
+            {
+                cRoaring_chunk_to_bitmap(b, cb, other);
+                cSimd_bits_or((uint8_t*) bitmap,
+                              (const uint8_t*) bitmap,
+                              (const uint8_t*) other,
+                              sizeof(bitmap));
+            }
+            stored = cRoaring_store_bitmap(dst, idx, bitmap);
+        }
+        if (! stored)
+        {
+            cRoaring_remove_chunk(dst, idx);
+            return false;
+        }
+        i++;
+        j++;
+    }
+    return true;
+}
+
+/* Keep the values of array chunk ca that are also in chunk cb, returns how many were kept */
+static inline uint32_t cRoaring_filter_array(const cRoaring* a,
+                                             const cRoaring_chunk* ca,
+                                             const cRoaring* b,
+                                             const cRoaring_chunk* cb,
+                                             uint16_t* out)
+{
+    const uint16_t* va = cRoaring_values(a, ca);
+    uint32_t n = 0;
+    if (cb->type == CROARING_ARRAY)
+    {
+        const uint16_t* vb = cRoaring_values(b, cb);
+        uint32_t x = 0, y = 0;
+        while ((x < ca->cardinality) && (y < cb->cardinality))
+        {
+            if (va[x] < vb[y])
+            {
+                x++;
+            }
+            else if (va[x] > vb[y])
+            {
+                y++;
+            }
+            else
+            {
+                if (out)
+                    out[n] = va[x];
+                n++;
+                x++;
+                y++;
+            }
+        }
+        return n;
+    }
+    for (uint32_t x = 0; x < ca->cardinality; x++)
+    {
+        if (cRoaring_chunk_contains(b, cb, va[x]))
+        {
+            if (out)
+                out[n] = va[x];
+            n++;
+        }
+    }
+    return n;
+}
+
+/* dst = a & b. dst must be a different cRoaring than a and b, its previous contents are dropped.
+ * Returns false if dst runs out of space */
+static inline bool cRoaring_and(cRoaring* dst, const cRoaring* a, const cRoaring* b)
+{
+    cRoaring_clear_all(dst);
+    uint64_t bitmap[CROARING_BITMAP_WORDS], other[CROARING_BITMAP_WORDS];
+    uint16_t values[CROARING_ARRAY_MAX];
+    int i = 0, j = 0;
+    while ((i < a->num_chunks) && (j < b->num_chunks))
+    {
+        const cRoaring_chunk* ca = &a->chunks[i];
+        const cRoaring_chunk* cb = &b->chunks[j];
+        if (ca->key != cb->key)
+        {
+            i += (ca->key < cb->key);
+            j += (cb->key < ca->key);
+            continue;
+        }
+
+        const int idx = dst->num_chunks;
+        if (! cRoaring_insert_chunk(dst, idx, ca->key))
+            return false;
+        bool stored;
+        if (ca->type == CROARING_ARRAY)
+        {
+            const uint32_t n = cRoaring_filter_array(a, ca, b, cb, values);
+            stored = cRoaring_store_array(dst, idx, values, n);
+        }
+        else if (cb->type == CROARING_ARRAY)
+        {
+            const uint32_t n = cRoaring_filter_array(b, cb, a, ca, values);
+            stored = cRoaring_store_array(dst, idx, values, n);
+        }
+        else
+        {
+            cRoaring_chunk_to_bitmap(a, ca, bitmap);
+            cRoaring_chunk_to_bitmap(b, cb, other);
+            cSimd_bits_and((uint8_t*) bitmap,
+                           (const uint8_t*) bitmap,
+                           (const uint8_t*) other,
+                           sizeof(bitmap));
+            stored = cRoaring_store_bitmap(dst, idx, bitmap);
+        }
+        /* An empty intersection already removed the chunk */
+        if (! stored)
+        {
+            cRoaring_remove_chunk(dst, idx);
+            return false;
+        }
+        i++;
+        j++;
+    }
+    return true;
+}
+
+/* Number of values in both a and b, without building a & b */
+static inline uint64_t cRoaring_and_count(const cRoaring* a, const cRoaring* b)
+{
+    uint64_t bitmap[CROARING_BITMAP_WORDS], other[CROARING_BITMAP_WORDS];
+    uint64_t count = 0;
+    int i = 0, j = 0;
+    while ((i < a->num_chunks) && (j < b->num_chunks))
+    {
+        const cRoaring_chunk* ca = &a->chunks[i];
+        const cRoaring_chunk* cb = &b->chunks[j];
+        if (ca->key != cb->key)
+        {
+            i += (ca->key < cb->key);
+            j += (cb->key < ca->key);
+            continue;
+        }
+        if (ca->type == CROARING_ARRAY)
+        {
+            count += cRoaring_filter_array(a, ca, b, cb, NULL);
+        }
+        else if (cb->type == CROARING_ARRAY)
+        {
+            count += cRoaring_filter_array(b, cb, a, ca, NULL);
+        }
+        else
+        {
+            const uint64_t* wa = cRoaring_words(a, ca);
+            const uint64_t* wb = cRoaring_words(b, cb);
+            if (ca->type == CROARING_RUN)
+            {
+                cRoaring_chunk_to_bitmap(a, ca, bitmap);
+                wa = bitmap;
+            }
+            if (cb->type == CROARING_RUN)
+            {
+                cRoaring_chunk_to_bitmap(b, cb, other);
+                wb = other;
+            }
+            count += cSimd_bits_and_count(
+                (const uint8_t*) wa, (const uint8_t*) wb, sizeof(bitmap));
+        }
+        i++;
+        j++;
+    }
+    return count;
+}
+
+/* Iterator over the set bits, in increasing order. The bitset must not be modified while an
+ * iterator is in use */
+typedef struct
+{
+    const cRoaring* r;
+    int chunk;     // index of the chunk being consumed
+    uint32_t pos;  // array index, bitmap word or run index inside that chunk
+    uint32_t next; // next value of the current run
+    uint64_t word; // remaining set bits of the current bitmap word
+} cRoaring_iter;
+
+static inline void cRoaring_iter_load(cRoaring_iter* it)
+{
+    if (it->chunk >= it->r->num_chunks)
+        return;
+    const cRoaring_chunk* c = &it->r->chunks[it->chunk];
+    it->pos = 0;
+    if (c->type == CROARING_BITMAP)
+        it->word = cRoaring_words(it->r, c)[0];
+    else if (c->type == CROARING_RUN)
+        it->next = cRoaring_values(it->r, c)[0];
+}
+
+static inline cRoaring_iter cRoaring_iter_begin(const cRoaring* r)
+{
+    cRoaring_iter it = {r, 0, 0, 0, 0};
+    cRoaring_iter_load(&it);
+    return it;
+}
+
+/* Write the next set bit to out and return true, or return false once all bits are visited */
+static inline bool cRoaring_iter_next(cRoaring_iter* it, uint32_t* out)
+{
+    while (it->chunk < it->r->num_chunks)
+    {
+        const cRoaring_chunk* c = &it->r->chunks[it->chunk];
+        const uint32_t high = (uint32_t) c->key << 16;
+        if (c->type == CROARING_ARRAY)
+        {
+            if (it->pos < c->cardinality)
+            {
+                *out = high | cRoaring_values(it->r, c)[it->pos++];
+                return true;
+            }
+        }
+        else if (c->type == CROARING_BITMAP)
+        {
+            while (! it->word && (++it->pos < CROARING_BITMAP_WORDS))
+                it->word = cRoaring_words(it->r, c)[it->pos];
+            if (it->word)
+            {
+                *out = high | ((it->pos * 64) + cSimd_ctz64(it->word));
+                it->word &= it->word - 1;
+                return true;
+            }
+        }
+        else if (it->pos < c->runs)
+        {
+            const uint16_t* runs = cRoaring_values(it->r, c);
+            *out = high | it->next;
+            if (it->next == (uint32_t) runs[2 * it->pos] + runs[2 * it->pos + 1])
+            {
+                if (++it->pos < c->runs)
+                    it->next = runs[2 * it->pos];
+            }
+            else
+            {
+                it->next++;
+            }
+            return true;
+        }
+        it->chunk++;
+        cRoaring_iter_load(it);
+    }
+    return false;
+}
+
+/* Loop over every set bit, e.g.
+ * uint32_t v;
+ * CROARING_FOREACH(&r, v) { ... } */
+#define CROARING_FOREACH(r, n)                                                                     \
+    for (cRoaring_iter n##_it = cRoaring_iter_begin(r); cRoaring_iter_next(&n##_it, &(n));)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_ROARING_H
@@ -0,0 +1,1185 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * Bit manipulation helpers and SIMD kernels shared by the cSTL containers.
+ *
+ * Every kernel has a portable scalar version and, on x86 with GCC/Clang, SSE2/AVX2/AVX-512
+ * versions compiled with per-function target attributes. The version to run is picked at runtime
+ * from the CPU features, so no special compiler flags are needed.
+ * Define CSTL_SIMD_DISABLE to always use the scalar kernels.
+ */
+
+#pragma once
+
+#ifndef CSTL_SIMD_H
+#define CSTL_SIMD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if ! defined(CSTL_SIMD_DISABLE) && (defined(__GNUC__) || defined(__clang__)) &&                   \
+    (defined(__x86_64__) || defined(__i386__))
+#define CSTL_SIMD_X86 1
+#include <immintrin.h>
+#define CSTL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CSTL_SIMD_X86 0
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Count trailing zeros of a non-zero 64-bit word */
+static inline unsigned cSimd_ctz64(const uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned) __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (unsigned) index;
+#else
+    unsigned n = 0;
+    uint64_t w = word;
+    while (! (w & 1U))
+    {
+        w >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/* Count leading zeros of a non-zero 64-bit word */
+static inline unsigned cSimd_clz64(const uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned) __builtin_clzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return 63U - (unsigned) index;
+#else
+    unsigned n = 0;
+    uint64_t w = word;
+    while (! (w & (1ULL << 63)))
+    {
+        w <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/* Count the set bits of a 64-bit word */
+static inline unsigned cSimd_popcount64(const uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned) __builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return (unsigned) __popcnt64(word);
+#else
+    uint64_t w = word - ((word >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (unsigned) ((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/* Instruction set levels, in increasing order */
+typedef enum
+{
+    CSIMD_SCALAR = 0,
+    CSIMD_SSE2,
+    CSIMD_AVX2,
+    CSIMD_AVX512, // AVX-512 F + BW
+} cSimd_isa;
+
+/* Relaxed atomic accesses to the lazily detected levels below, so concurrent first calls are not
+ * a data race. Aligned int accesses are already atomic on the MSVC targets */
+#if defined(__GNUC__) || defined(__clang__)
+#define CSIMD_LOAD(var) __atomic_load_n(&(var), __ATOMIC_RELAXED)
+#define CSIMD_STORE(var, value) __atomic_store_n(&(var), (value), __ATOMIC_RELAXED)
+#else
+#define CSIMD_LOAD(var) (*(volatile int*) &(var))
+#define CSIMD_STORE(var, value) (*(volatile int*) &(var) = (value))
+#endif
+
+/* Level in use, -1 until the first call to cSimd_isa_get(). It is per translation unit: each
+ * .c file including cSimd.h has its own copy */
+static int cSimd_isa_current = -1;
+
+/* Best level supported by this CPU */
+static inline cSimd_isa cSimd_detect(void)
+{
+#if CSTL_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+        return CSIMD_AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return CSIMD_AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return CSIMD_SSE2;
+#endif
+    return CSIMD_SCALAR;
+}
+
+/* Level used by the kernels, detected once. Racing first calls store the same value */
+static inline cSimd_isa cSimd_isa_get(void)
+{
+    int isa = CSIMD_LOAD(cSimd_isa_current);
+    if (isa < 0)
+    {
+        isa = (int) cSimd_detect();
+        CSIMD_STORE(cSimd_isa_current, isa);
+    }
+    return (cSimd_isa) isa;
+}
+
+/* Force a lower level (e.g. to benchmark or test the other kernels), clamped to what the CPU
+ * supports. Returns the level actually set. Only the kernels called from the calling translation
+ * unit are affected */
+static inline cSimd_isa cSimd_isa_set(const cSimd_isa isa)
+{
+    const cSimd_isa best = cSimd_detect();
+    const cSimd_isa level = (isa < best) ? isa : best;
+    CSIMD_STORE(cSimd_isa_current, (int) level);
+    return level;
+}
+
+/* Whether the AVX-512 VPOPCNTDQ extension is available, detected once */
+static inline bool cSimd_has_vpopcntdq(void)
+{
+#if CSTL_SIMD_X86
+    static int has = -1;
+    int value = CSIMD_LOAD(has);
+    if (value < 0)
+    {
+        value = __builtin_cpu_supports("avx512vpopcntdq") ? 1 : 0;
+        CSIMD_STORE(has, value);
+    }
+    return value == 1;
+#else
+    return false;
+#endif
+}
+
+/* Whether the POPCNT instruction is available, detected once */
+static inline bool cSimd_has_popcnt(void)
+{
+#if CSTL_SIMD_X86
+    static int has = -1;
+    int value = CSIMD_LOAD(has);
+    if (value < 0)
+    {
+        value = __builtin_cpu_supports("popcnt") ? 1 : 0;
+        CSIMD_STORE(has, value);
+    }
+    return value == 1;
+#else
+    return false;
+#endif
+}
+
+/*
+ * Bulk bit kernels over byte spans of n bytes. Loads and stores are unaligned, and dst may alias
+ * a or b. cSimd_bits_<op>(dst, a, b, n) computes dst = a <op> b byte by byte.
+ */
+
+#define CSIMD_OP_AND(x, y) ((x) & (y))
+#define CSIMD_OP_OR(x, y) ((x) | (y))
+#define CSIMD_OP_XOR(x, y) ((x) ^ (y))
+#define CSIMD_OP_ANDNOT(x, y) ((x) & ~(y))
+
+#define CSIMD_GENERATE_BITS_SCALAR(name, OP)                                                       \
+    static inline void cSimd_bits_##name##_scalar(                                                 \
+        uint8_t* dst, const uint8_t* a, const uint8_t* b, const size_t n)                          \
+    {                                                                                              \
+        size_t i = 0;                                                                              \
+        for (; i + 8 <= n; i += 8)                                                                 \
+        {                                                                                          \
+            uint64_t x, y;                                                                         \
+            memcpy(&x, a + i, 8);                                                                  \
+            memcpy(&y, b + i, 8);                                                                  \
+            x = OP(x, y);                                                                          \
+            memcpy(dst + i, &x, 8);                                                                \
+        }                                                                                          \
+        for (; i < n; i++)                                                                         \
+            dst[i] = (uint8_t) OP(a[i], b[i]);                                                     \
+    }
+
+CSIMD_GENERATE_BITS_SCALAR(and, CSIMD_OP_AND)
+CSIMD_GENERATE_BITS_SCALAR(or, CSIMD_OP_OR)
+CSIMD_GENERATE_BITS_SCALAR(xor, CSIMD_OP_XOR)
+CSIMD_GENERATE_BITS_SCALAR(andnot, CSIMD_OP_ANDNOT)
+
+static inline size_t cSimd_bits_and_count_scalar(const uint8_t* a, const uint8_t* b, const size_t n)
+{
+    size_t count = 0, i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        uint64_t x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        count += cSimd_popcount64(x & y);
+    }
+    for (; i < n; i++)
+        count += cSimd_popcount64(a[i] & b[i]);
+    return count;
+}
+
+/* Whether any byte of a & b is non zero (pass b = a to test a alone) */
+static inline bool cSimd_bits_and_any_scalar(const uint8_t* a, const uint8_t* b, const size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        uint64_t x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        if (x & y)
+            return true;
+    }
+    for (; i < n; i++)
+    {
+        if (a[i] & b[i])
+            return true;
+    }
+    return false;
+}
+
+/* Whether every byte of a is 0xFF */
+static inline bool cSimd_bits_all_ones_scalar(const uint8_t* a, const size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        uint64_t x;
+        memcpy(&x, a + i, 8);
+        if (~x)
+            return false;
+    }
+    for (; i < n; i++)
+    {
+        if (a[i] != 0xFF)
+            return false;
+    }
+    return true;
+}
+
+#if CSTL_SIMD_X86
+
+#define CSIMD_SSE2_AND(x, y) _mm_and_si128(x, y)
+#define CSIMD_SSE2_OR(x, y) _mm_or_si128(x, y)
+#define CSIMD_SSE2_XOR(x, y) _mm_xor_si128(x, y)
+#define CSIMD_SSE2_ANDNOT(x, y) _mm_andnot_si128(y, x)
+#define CSIMD_AVX2_AND(x, y) _mm256_and_si256(x, y)
+#define CSIMD_AVX2_OR(x, y) _mm256_or_si256(x, y)
+#define CSIMD_AVX2_XOR(x, y) _mm256_xor_si256(x, y)
+#define CSIMD_AVX2_ANDNOT(x, y) _mm256_andnot_si256(y, x)
+#define CSIMD_AVX512_AND(x, y) _mm512_and_si512(x, y)
+#define CSIMD_AVX512_OR(x, y) _mm512_or_si512(x, y)
+#define CSIMD_AVX512_XOR(x, y) _mm512_xor_si512(x, y)
+#define CSIMD_AVX512_ANDNOT(x, y) _mm512_maskz_andnot_epi64((__mmask8) 0xFF, y, x)
+
+#define CSIMD_GENERATE_BITS_X86(name, SSE2_OP, AVX2_OP, AVX512_OP)                                 \
+    CSTL_TARGET("sse2")                                                                            \
+    static inline void cSimd_bits_##name##_sse2(                                                   \
+        uint8_t* dst, const uint8_t* a, const uint8_t* b, const size_t n)                          \
+    {                                                                                              \
+        size_t i = 0;                                                                              \
+        for (; i + 16 <= n; i += 16)                                                               \
+        {                                                                                          \
+            const __m128i x = _mm_loadu_si128((const __m128i*) (a + i));                           \
+            const __m128i y = _mm_loadu_si128((const __m128i*) (b + i));                           \
+            _mm_storeu_si128((__m128i*) (dst + i), SSE2_OP(x, y));                                 \
+        }                                                                                          \
+        cSimd_bits_##name##_scalar(dst + i, a + i, b + i, n - i);                                  \
+    }                                                                                              \
+                                                                                                   \
+    CSTL_TARGET("avx2")                                                                            \
+    static inline void cSimd_bits_##name##_avx2(                                                   \
+        uint8_t* dst, const uint8_t* a, const uint8_t* b, const size_t n)                          \
+    {                                                                                              \
+        size_t i = 0;                                                                              \
+        for (; i + 32 <= n; i += 32)                                                               \
+        {                                                                                          \
+            const __m256i x = _mm256_loadu_si256((const __m256i*) (a + i));                        \
+            const __m256i y = _mm256_loadu_si256((const __m256i*) (b + i));                        \
+            _mm256_storeu_si256((__m256i*) (dst + i), AVX2_OP(x, y));                              \
+        }                                                                                          \
+        cSimd_bits_##name##_scalar(dst + i, a + i, b + i, n - i);                                  \
+    }                                                                                              \
+                                                                                                   \
+    CSTL_TARGET("avx512f,avx512bw")                                                                \
+    static inline void cSimd_bits_##name##_avx512(                                                 \
+        uint8_t* dst, const uint8_t* a, const uint8_t* b, const size_t n)                          \
+    {                                                                                              \
+        size_t i = 0;                                                                              \
+        for (; i + 64 <= n; i += 64)                                                               \
+        {                                                                                          \
+            const __m512i x = _mm512_loadu_si512((const void*) (a + i));                           \
+            const __m512i y = _mm512_loadu_si512((const void*) (b + i));                           \
+            _mm512_storeu_si512((void*) (dst + i), AVX512_OP(x, y));                               \
+        }                                                                                          \
+        /* Masked load/store for the tail, no scalar loop needed */                                \
+        if (i < n)                                                                                 \
+        {                                                                                          \
+            const __mmask64 mask = _cvtu64_mask64(~0ULL >> (64 - (n - i)));                        \
+            const __m512i x = _mm512_maskz_loadu_epi8(mask, (const void*) (a + i));                \
+            const __m512i y = _mm512_maskz_loadu_epi8(mask, (const void*) (b + i));                \
+            _mm512_mask_storeu_epi8((void*) (dst + i), mask, AVX512_OP(x, y));                     \
+        }                                                                                          \
+    }
+
+CSIMD_GENERATE_BITS_X86(and, CSIMD_SSE2_AND, CSIMD_AVX2_AND, CSIMD_AVX512_AND)
+CSIMD_GENERATE_BITS_X86(or, CSIMD_SSE2_OR, CSIMD_AVX2_OR, CSIMD_AVX512_OR)
+CSIMD_GENERATE_BITS_X86(xor, CSIMD_SSE2_XOR, CSIMD_AVX2_XOR, CSIMD_AVX512_XOR)
+CSIMD_GENERATE_BITS_X86(andnot, CSIMD_SSE2_ANDNOT, CSIMD_AVX2_ANDNOT, CSIMD_AVX512_ANDNOT)
+
+/* Same as the scalar kernel, but with the hardware POPCNT instruction */
+CSTL_TARGET("popcnt")
+static inline size_t cSimd_bits_and_count_popcnt(const uint8_t* a, const uint8_t* b, const size_t n)
+{
+    size_t count = 0, i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        uint64_t x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        count += (size_t) __builtin_popcountll(x & y);
+    }
+    for (; i < n; i++)
+        count += (size_t) __builtin_popcount(a[i] & b[i]);
+    return count;
+}
+
+/* Popcount of 32 bytes using the nibble lookup method, as 4 x 64-bit partial sums */
+CSTL_TARGET("avx2")
+static inline __m256i cSimd_popcount_avx2(const __m256i v)
+{
+    const __m256i lookup =
+        _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+    const __m256i lo = _mm256_and_si256(v, low_mask);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    const __m256i counts =
+        _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+}
+
+CSTL_TARGET("avx2")
+static inline size_t cSimd_bits_and_count_avx2(const uint8_t* a, const uint8_t* b, const size_t n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*) (a + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*) (b + i));
+        acc = _mm256_add_epi64(acc, cSimd_popcount_avx2(_mm256_and_si256(x, y)));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*) lanes, acc);
+    return (size_t) (lanes[0] + lanes[1] + lanes[2] + lanes[3]) +
+           cSimd_bits_and_count_scalar(a + i, b + i, n - i);
+}
+
+CSTL_TARGET("avx512f,avx512bw,avx512vpopcntdq")
+static inline size_t cSimd_bits_and_count_avx512(const uint8_t* a,
+                                                 const uint8_t* b,
+                                                 const size_t n)
+{
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64)
+    {
+        const __m512i x = _mm512_loadu_si512((const void*) (a + i));
+        const __m512i y = _mm512_loadu_si512((const void*) (b + i));
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_and_si512(x, y)));
+    }
+    if (i < n)
+    {
+        const __mmask64 mask = _cvtu64_mask64(~0ULL >> (64 - (n - i)));
+        const __m512i x = _mm512_maskz_loadu_epi8(mask, (const void*) (a + i));
+        const __m512i y = _mm512_maskz_loadu_epi8(mask, (const void*) (b + i));
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_and_si512(x, y)));
+    }
+    uint64_t lanes[8];
+    _mm512_storeu_si512((void*) lanes, acc);
+    return (size_t) (lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] +
+                     lanes[7]);
+}
+
+CSTL_TARGET("sse2")
+static inline bool cSimd_bits_and_any_sse2(const uint8_t* a, const uint8_t* b, const size_t n)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*) (a + i));
+        const __m128i y = _mm_loadu_si128((const __m128i*) (b + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(x, y), zero)) != 0xFFFF)
+            return true;
+    }
+    return cSimd_bits_and_any_scalar(a + i, b + i, n - i);
+}
+
+CSTL_TARGET("avx2")
+static inline bool cSimd_bits_and_any_avx2(const uint8_t* a, const uint8_t* b, const size_t n)
+{
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*) (a + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*) (b + i));
+        if (! _mm256_testz_si256(x, y))
+            return true;
+    }
+    return cSimd_bits_and_any_scalar(a + i, b + i, n - i);
+}
+
+CSTL_TARGET("avx512f,avx512bw")
+static inline bool cSimd_bits_and_any_avx512(const uint8_t* a, const uint8_t* b, const size_t n)
+{
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64)
+    {
+        const __m512i x = _mm512_loadu_si512((const void*) (a + i));
+        const __m512i y = _mm512_loadu_si512((const void*) (b + i));
+        if (_mm512_test_epi64_mask(x, y))
+            return true;
+    }
+    return cSimd_bits_and_any_scalar(a + i, b + i, n - i);
+}
+
+CSTL_TARGET("sse2")
+static inline bool cSimd_bits_all_ones_sse2(const uint8_t* a, const size_t n)
+{
+    const __m128i ones = _mm_set1_epi8((char) 0xFF);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*) (a + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, ones)) != 0xFFFF)
+            return false;
+    }
+    return cSimd_bits_all_ones_scalar(a + i, n - i);
+}
+
+CSTL_TARGET("avx2")
+static inline bool cSimd_bits_all_ones_avx2(const uint8_t* a, const size_t n)
+{
+    const __m256i ones = _mm256_set1_epi8((char) 0xFF);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*) (a + i));
+        if (! _mm256_testc_si256(x, ones))
+            return false;
+    }
+    return cSimd_bits_all_ones_scalar(a + i, n - i);
+}
+
+CSTL_TARGET("avx512f,avx512bw")
+static inline bool cSimd_bits_all_ones_avx512(const uint8_t* a, const size_t n)
+{
+    const __m512i ones = _mm512_set1_epi8((char) 0xFF);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64)
+    {
+        const __m512i x = _mm512_loadu_si512((const void*) (a + i));
+        if (_mm512_cmpneq_epi64_mask(x, ones))
+            return false;
+    }
+    return cSimd_bits_all_ones_scalar(a + i, n - i);
+}
+
+#endif // CSTL_SIMD_X86
+
+/* Dispatchers, these pick the kernel for the current cSimd_isa_get() level */
+
+#if CSTL_SIMD_X86
+#define CSIMD_DISPATCH_BITS(name)                                                                  \
+    static inline void cSimd_bits_##name(                                                          \
+        uint8_t* dst, const uint8_t* a, const uint8_t* b, const size_t n)                          \
+    {                                                                                              \
+        switch (cSimd_isa_get())                                                                   \
+        {                                                                                          \
+            case CSIMD_AVX512:                                                                     \
+                cSimd_bits_##name##_avx512(dst, a, b, n);                                          \
+                return;                                                                            \
+            case CSIMD_AVX2:                                                                       \
+                cSimd_bits_##name##_avx2(dst, a, b, n);                                            \
+                return;                                                                            \
+            case CSIMD_SSE2:                                                                       \
+                cSimd_bits_##name##_sse2(dst, a, b, n);                                            \
+                return;                                                                            \
+            default:                                                                               \
+                cSimd_bits_##name##_scalar(dst, a, b, n);                                          \
+                return;                                                                            \
+        }                                                                                          \
+    }
+#else
+#define CSIMD_DISPATCH_BITS(name)                                                                  \
+    static inline void cSimd_bits_##name(                                                          \
+        uint8_t* dst, const uint8_t* a, const uint8_t* b, const size_t n)                          \
+    {                                                                                              \
+        cSimd_bits_##name##_scalar(dst, a, b, n);                                                  \
+    }
+#endif
+
+CSIMD_DISPATCH_BITS(and)
+CSIMD_DISPATCH_BITS(or)
+CSIMD_DISPATCH_BITS(xor)
+CSIMD_DISPATCH_BITS(andnot)
+
+/* Number of set bits in a & b */
+static inline size_t cSimd_bits_and_count(const uint8_t* a, const uint8_t* b, const size_t n)
+{
+#if CSTL_SIMD_X86
+    switch (cSimd_isa_get())
+    {
+        case CSIMD_AVX512:
+            if (cSimd_has_vpopcntdq())
+                return cSimd_bits_and_count_avx512(a, b, n);
+            return cSimd_bits_and_count_avx2(a, b, n);
+        case CSIMD_AVX2:
+            return cSimd_bits_and_count_avx2(a, b, n);
+        default:
+            /* SSE2 has no byte shuffle, POPCNT on 64-bit words is as fast */
+            if (cSimd_has_popcnt())
+                return cSimd_bits_and_count_popcnt(a, b, n);
+            return cSimd_bits_and_count_scalar(a, b, n);
+    }
+#else
+    return cSimd_bits_and_count_scalar(a, b, n);
+#endif
+}
+
+/* Whether a & b has any bit set */
+static inline bool cSimd_bits_and_any(const uint8_t* a, const uint8_t* b, const size_t n)
+{
+#if CSTL_SIMD_X86
+    switch (cSimd_isa_get())
+    {
+        case CSIMD_AVX512:
+            return cSimd_bits_and_any_avx512(a, b, n);
+        case CSIMD_AVX2:
+            return cSimd_bits_and_any_avx2(a, b, n);
+        case CSIMD_SSE2:
+            return cSimd_bits_and_any_sse2(a, b, n);
+        default:
+            return cSimd_bits_and_any_scalar(a, b, n);
+    }
+#else
+    return cSimd_bits_and_any_scalar(a, b, n);
+#endif
+}
+
+/* Whether every byte of a is 0xFF */
+static inline bool cSimd_bits_all_ones(const uint8_t* a, const size_t n)
+{
+#if CSTL_SIMD_X86
+    switch (cSimd_isa_get())
+    {
+        case CSIMD_AVX512:
+            return cSimd_bits_all_ones_avx512(a, n);
+        case CSIMD_AVX2:
+            return cSimd_bits_all_ones_avx2(a, n);
+        case CSIMD_SSE2:
+            return cSimd_bits_all_ones_sse2(a, n);
+        default:
+            return cSimd_bits_all_ones_scalar(a, n);
+    }
+#else
+    return cSimd_bits_all_ones_scalar(a, n);
+#endif
+}
+
+/*
+ * Search kernels over n elements of a primitive type: index of the first / last element equal to
+ * key (CSIMD_NPOS if none) and number of elements equal to key. The data does not need to be
+ * aligned. Integers are compared bit for bit, floats and doubles as !(x < key) && !(x > key) like
+ * the cArray primitive compare, so -0.0 equals 0.0 and NaN equals everything.
+ * cSimd_<op>_<name>(data, n, key) takes a typed key, cSimd_<op>(data, n, &key, type) the type at
+ * runtime.
+ */
+
+#define CSIMD_NPOS ((size_t) -1)
+
+/* Element types of the search kernels */
+typedef enum
+{
+    CSIMD_INT8,
+    CSIMD_INT16,
+    CSIMD_INT32,
+    CSIMD_INT64,
+    CSIMD_FLOAT,
+    CSIMD_DOUBLE,
+} cSimd_elem;
+
+#define CSIMD_EQ_INT(x, y) ((x) == (y))
+#define CSIMD_EQ_FLOAT(x, y) (! (((x) < (y)) || ((x) > (y))))
+
+#define CSIMD_GENERATE_SEARCH_SCALAR(name, T, EQ)                                                  \
+    static inline size_t cSimd_find_##name##_scalar(                                               \
+        const uint8_t* data, const size_t n, const T key)                                          \
+    {                                                                                              \
+        for (size_t i = 0; i < n; i++)                                                             \
+        {                                                                                          \
+            T x;                                                                                   \
+            memcpy(&x, data + (i * sizeof(T)), sizeof(T));                                         \
+            if (EQ(x, key))                                                                        \
+                return i;                                                                          \
+        }                                                                                          \
+        return CSIMD_NPOS;                                                                         \
+    }                                                                                              \
+                                                                                                   \
+    static inline size_t cSimd_find_last_##name##_scalar(                                          \
+        const uint8_t* data, const size_t n, const T key)                                          \
+    {                                                                                              \
+        for (size_t i = n; i-- > 0;)                                                               \
+        {                                                                                          \
+            T x;                                                                                   \
+            memcpy(&x, data + (i * sizeof(T)), sizeof(T));                                         \
+            if (EQ(x, key))                                                                        \
+                return i;                                                                          \
+        }                                                                                          \
+        return CSIMD_NPOS;                                                                         \
+    }                                                                                              \
+                                                                                                   \
+    static inline size_t cSimd_count_##name##_scalar(                                              \
+        const uint8_t* data, const size_t n, const T key)                                          \
+    {                                                                                              \
+        size_t count = 0;                                                                          \
+        for (size_t i = 0; i < n; i++)                                                             \
+        {                                                                                          \
+            T x;                                                                                   \
+            memcpy(&x, data + (i * sizeof(T)), sizeof(T));                                         \
+            count += EQ(x, key) ? 1 : 0;                                                           \
+        }                                                                                          \
+        return count;                                                                              \
+    }
+
+CSIMD_GENERATE_SEARCH_SCALAR(int8, int8_t, CSIMD_EQ_INT)
+CSIMD_GENERATE_SEARCH_SCALAR(int16, int16_t, CSIMD_EQ_INT)
+CSIMD_GENERATE_SEARCH_SCALAR(int32, int32_t, CSIMD_EQ_INT)
+CSIMD_GENERATE_SEARCH_SCALAR(int64, int64_t, CSIMD_EQ_INT)
+CSIMD_GENERATE_SEARCH_SCALAR(float, float, CSIMD_EQ_FLOAT)
+CSIMD_GENERATE_SEARCH_SCALAR(double, double, CSIMD_EQ_FLOAT)
+
+#if CSTL_SIMD_X86
+
+/*
+ * cSimd_eq_<name>_<isa>(p, key): compare one vector loaded from p with key, as a byte mask with
+ * the sizeof(T) bits of every equal element set
+ */
+
+CSTL_TARGET("sse2")
+static inline uint64_t cSimd_eq_int8_sse2(const uint8_t* p, const int8_t key)
+{
+    const __m128i v = _mm_loadu_si128((const __m128i*) p);
+    return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(key)));
+}
+
+CSTL_TARGET("sse2")
+static inline uint64_t cSimd_eq_int16_sse2(const uint8_t* p, const int16_t key)
+{
+    const __m128i v = _mm_loadu_si128((const __m128i*) p);
+    return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi16(v, _mm_set1_epi16(key)));
+}
+
+CSTL_TARGET("sse2")
+static inline uint64_t cSimd_eq_int32_sse2(const uint8_t* p, const int32_t key)
+{
+    const __m128i v = _mm_loadu_si128((const __m128i*) p);
+    return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi32(v, _mm_set1_epi32(key)));
+}
+
+/* SSE2 has no 64-bit compare, both 32-bit halves must be equal */
+CSTL_TARGET("sse2")
+static inline uint64_t cSimd_eq_int64_sse2(const uint8_t* p, const int64_t key)
+{
+    const __m128i v = _mm_loadu_si128((const __m128i*) p);
+    const __m128i eq = _mm_cmpeq_epi32(v, _mm_set1_epi64x(key));
+    const __m128i both = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (uint32_t) _mm_movemask_epi8(both);
+}
+
+CSTL_TARGET("sse2")
+static inline uint64_t cSimd_eq_float_sse2(const uint8_t* p, const float key)
+{
+    const __m128 v = _mm_loadu_ps((const float*) p);
+    const __m128 k = _mm_set1_ps(key);
+    const __m128 eq = _mm_or_ps(_mm_cmpeq_ps(v, k), _mm_cmpunord_ps(v, k));
+    return (uint32_t) _mm_movemask_epi8(_mm_castps_si128(eq));
+}
+
+CSTL_TARGET("sse2")
+static inline uint64_t cSimd_eq_double_sse2(const uint8_t* p, const double key)
+{
+    const __m128d v = _mm_loadu_pd((const double*) p);
+    const __m128d k = _mm_set1_pd(key);
+    const __m128d eq = _mm_or_pd(_mm_cmpeq_pd(v, k), _mm_cmpunord_pd(v, k));
+    return (uint32_t) _mm_movemask_epi8(_mm_castpd_si128(eq));
+}
+
+CSTL_TARGET("avx2")
+static inline uint64_t cSimd_eq_int8_avx2(const uint8_t* p, const int8_t key)
+{
+    const __m256i v = _mm256_loadu_si256((const __m256i*) p);
+    return (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(key)));
+}
+
+CSTL_TARGET("avx2")
+static inline uint64_t cSimd_eq_int16_avx2(const uint8_t* p, const int16_t key)
+{
+    const __m256i v = _mm256_loadu_si256((const __m256i*) p);
+    return (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi16(v, _mm256_set1_epi16(key)));
+}
+
+CSTL_TARGET("avx2")
+static inline uint64_t cSimd_eq_int32_avx2(const uint8_t* p, const int32_t key)
+{
+    const __m256i v = _mm256_loadu_si256((const __m256i*) p);
+    return (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi32(v, _mm256_set1_epi32(key)));
+}
+
+CSTL_TARGET("avx2")
+static inline uint64_t cSimd_eq_int64_avx2(const uint8_t* p, const int64_t key)
+{
+    const __m256i v = _mm256_loadu_si256((const __m256i*) p);
+    return (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi64(v, _mm256_set1_epi64x(key)));
+}
+
+CSTL_TARGET("avx2")
+static inline uint64_t cSimd_eq_float_avx2(const uint8_t* p, const float key)
+{
+    const __m256 v = _mm256_loadu_ps((const float*) p);
+    const __m256 eq = _mm256_cmp_ps(v, _mm256_set1_ps(key), _CMP_EQ_UQ);
+    return (uint32_t) _mm256_movemask_epi8(_mm256_castps_si256(eq));
+}
+
+CSTL_TARGET("avx2")
+static inline uint64_t cSimd_eq_double_avx2(const uint8_t* p, const double key)
+{
+    const __m256d v = _mm256_loadu_pd((const double*) p);
+    const __m256d eq = _mm256_cmp_pd(v, _mm256_set1_pd(key), _CMP_EQ_UQ);
+    return (uint32_t) _mm256_movemask_epi8(_mm256_castpd_si256(eq));
+}
+
+/* find checks two vectors per iteration, their masks fit together in one 64-bit word */
+#define CSIMD_GENERATE_SEARCH_X86(name, T, isa, TARGET, BYTES)                                     \
+    CSTL_TARGET(TARGET)                                                                            \
+    static inline size_t cSimd_find_##name##_##isa(                                                \
+        const uint8_t* data, const size_t n, const T key)                                          \
+    {                                                                                              \
+        const size_t lanes = BYTES / sizeof(T);                                                    \
+        size_t i = 0;                                                                              \
+        for (; i + (2 * lanes) <= n; i += 2 * lanes)                                               \
+        {                                                                                          \
+            const uint64_t lo = cSimd_eq_##name##_##isa(data + (i * sizeof(T)), key);              \
+            const uint64_t hi = cSimd_eq_##name##_##isa(data + ((i + lanes) * sizeof(T)), key);    \
+            if (lo | hi)                                                                           \
+                return i + (cSimd_ctz64(lo | (hi << BYTES)) / sizeof(T));                          \
+        }                                                                                          \
+        if (i + lanes <= n)                                                                        \
+        {                                                                                          \
+            const uint64_t mask = cSimd_eq_##name##_##isa(data + (i * sizeof(T)), key);            \
+            if (mask)                                                                              \
+                return i + (cSimd_ctz64(mask) / sizeof(T));                                        \
+            i += lanes;                                                                            \
+        }                                                                                          \
+        const size_t rest = cSimd_find_##name##_scalar(data + (i * sizeof(T)), n - i, key);        \
+        return (rest == CSIMD_NPOS) ? CSIMD_NPOS : i + rest;                                       \
+    }                                                                                              \
+                                                                                                   \
+    CSTL_TARGET(TARGET)                                                                            \
+    static inline size_t cSimd_find_last_##name##_##isa(                                           \
+        const uint8_t* data, const size_t n, const T key)                                          \
+    {                                                                                              \
+        const size_t lanes = BYTES / sizeof(T);                                                    \
+        size_t i = n;                                                                              \
+        while (i >= lanes)                                                                         \
+        {                                                                                          \
+            i -= lanes;                                                                            \
+            const uint64_t mask = cSimd_eq_##name##_##isa(data + (i * sizeof(T)), key);            \
+            if (mask)                                                                              \
+                return i + ((63 - cSimd_clz64(mask)) / sizeof(T));                                 \
+        }                                                                                          \
+        return cSimd_find_last_##name##_scalar(data, i, key);                                      \
+    }                                                                                              \
+                                                                                                   \
+    CSTL_TARGET(TARGET)                                                                            \
+    static inline size_t cSimd_count_##name##_##isa(                                               \
+        const uint8_t* data, const size_t n, const T key)                                          \
+    {                                                                                              \
+        const size_t lanes = BYTES / sizeof(T);                                                    \
+        size_t bits = 0, i = 0;                                                                    \
+        for (; i + lanes <= n; i += lanes)                                                         \
+            bits += cSimd_popcount64(cSimd_eq_##name##_##isa(data + (i * sizeof(T)), key));        \
+        return (bits / sizeof(T)) +                                                                \
+               cSimd_count_##name##_scalar(data + (i * sizeof(T)), n - i, key);                    \
+    }
+
+CSIMD_GENERATE_SEARCH_X86(int8, int8_t, sse2, "sse2", 16)
+CSIMD_GENERATE_SEARCH_X86(int16, int16_t, sse2, "sse2", 16)
+CSIMD_GENERATE_SEARCH_X86(int32, int32_t, sse2, "sse2", 16)
+CSIMD_GENERATE_SEARCH_X86(int64, int64_t, sse2, "sse2", 16)
+CSIMD_GENERATE_SEARCH_X86(float, float, sse2, "sse2", 16)
+CSIMD_GENERATE_SEARCH_X86(double, double, sse2, "sse2", 16)
+/* Every AVX2 CPU has POPCNT, count uses it */
+CSIMD_GENERATE_SEARCH_X86(int8, int8_t, avx2, "avx2,popcnt", 32)
+CSIMD_GENERATE_SEARCH_X86(int16, int16_t, avx2, "avx2,popcnt", 32)
+CSIMD_GENERATE_SEARCH_X86(int32, int32_t, avx2, "avx2,popcnt", 32)
+CSIMD_GENERATE_SEARCH_X86(int64, int64_t, avx2, "avx2,popcnt", 32)
+CSIMD_GENERATE_SEARCH_X86(float, float, avx2, "avx2,popcnt", 32)
+CSIMD_GENERATE_SEARCH_X86(double, double, avx2, "avx2,popcnt", 32)
+
+/* AVX-512 runs the AVX2 kernels, a search is bound by memory bandwidth long before the compares */
+#define CSIMD_DISPATCH_SEARCH(op, name, T)                                                         \
+    static inline size_t cSimd_##op##_##name(const void* data, const size_t n, const T key)        \
+    {                                                                                              \
+        switch (cSimd_isa_get())                                                                   \
+        {                                                                                          \
+            case CSIMD_AVX512:                                                                     \
+            case CSIMD_AVX2:                                                                       \
+                return cSimd_##op##_##name##_avx2((const uint8_t*) data, n, key);                  \
+            case CSIMD_SSE2:                                                                       \
+                return cSimd_##op##_##name##_sse2((const uint8_t*) data, n, key);                  \
+            default:                                                                               \
+                return cSimd_##op##_##name##_scalar((const uint8_t*) data, n, key);                \
+        }                                                                                          \
+    }
+#else
+#define CSIMD_DISPATCH_SEARCH(op, name, T)                                                         \
+    static inline size_t cSimd_##op##_##name(const void* data, const size_t n, const T key)        \
+    {                                                                                              \
+        return cSimd_##op##_##name##_scalar((const uint8_t*) data, n, key);                        \
+    }
+#endif // CSTL_SIMD_X86
+
+#define CSIMD_DISPATCH_SEARCH_ALL(op)                                                              \
+    CSIMD_DISPATCH_SEARCH(op, int8, int8_t)                                                        \
+    CSIMD_DISPATCH_SEARCH(op, int16, int16_t)                                                      \
+    CSIMD_DISPATCH_SEARCH(op, int32, int32_t)                                                      \
+    CSIMD_DISPATCH_SEARCH(op, int64, int64_t)                                                      \
+    CSIMD_DISPATCH_SEARCH(op, float, float)                                                        \
+    CSIMD_DISPATCH_SEARCH(op, double, double)                                                      \
+                                                                                                   \
+    static inline size_t cSimd_##op(                                                               \
+        const void* data, const size_t n, const void* key, const cSimd_elem type)                  \
+    {                                                                                              \
+        switch (type)                                                                              \
+        {                                                                                          \
+            case CSIMD_INT8:                                                                       \
+            {                                                                                      \
+                int8_t k;                                                                          \
+                memcpy(&k, key, sizeof(k));                                                        \
+                return cSimd_##op##_int8(data, n, k);                                              \
+            }                                                                                      \
+            case CSIMD_INT16:                                                                      \
+            {                                                                                      \
+                int16_t k;                                                                         \
+                memcpy(&k, key, sizeof(k));                                                        \
+                return cSimd_##op##_int16(data, n, k);                                             \
+            }                                                                                      \
+            case CSIMD_INT32:                                                                      \
+            {                                                                                      \
+                int32_t k;                                                                         \
+                memcpy(&k, key, sizeof(k));                                                        \
+                return cSimd_##op##_int32(data, n, k);                                             \
+            }                                                                                      \
+            case CSIMD_INT64:                                                                      \
+            {                                                                                      \
+                int64_t k;                                                                         \
+                memcpy(&k, key, sizeof(k));                                                        \
+                return cSimd_##op##_int64(data, n, k);                                             \
+            }                                                                                      \
+            case CSIMD_FLOAT:                                                                      \
+            {                                                                                      \
+                float k;                                                                           \
+                memcpy(&k, key, sizeof(k));                                                        \
+                return cSimd_##op##_float(data, n, k);                                             \
+            }                                                                                      \
+            default:                                                                               \
+            {                                                                                      \
+                double k;                                                                          \
+                memcpy(&k, key, sizeof(k));                                                        \
+                return cSimd_##op##_double(data, n, k);                                            \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+/* Index of the first element equal to key, CSIMD_NPOS if none */
+CSIMD_DISPATCH_SEARCH_ALL(find)
+/* Index of the last element equal to key, CSIMD_NPOS if none */
+CSIMD_DISPATCH_SEARCH_ALL(find_last)
+/* Number of elements equal to key */
+CSIMD_DISPATCH_SEARCH_ALL(count)
+
+/*
+ * Minimum and maximum of n (> 0) elements of a primitive type in one pass, with the AVX2 min / max
+ * instructions (64-bit integers use a compare and a blend). The data does not need to be aligned.
+ * Floats and doubles are compared with < and >, so a NaN is skipped unless it is the first element
+ * (which is then returned as both the minimum and the maximum).
+ * cSimd_minmax_<name>(data, n, &min, &max) is typed, cSimd_minmax(data, n, &min, &max, type,
+ * is_unsigned) takes the type at runtime. Both return false if n is 0.
+ */
+
+#define CSIMD_GENERATE_MINMAX_SCALAR(name, T)                                                      \
+    static inline void cSimd_minmax_##name##_scalar(                                               \
+        const uint8_t* data, const size_t n, T* min, T* max)                                       \
+    {                                                                                              \
+        T lo, hi;                                                                                  \
+        memcpy(&lo, data, sizeof(T));                                                              \
+        hi = lo;                                                                                   \
+        for (size_t i = 1; i < n; i++)                                                             \
+        {                                                                                          \
+            T x;                                                                                   \
+            memcpy(&x, data + (i * sizeof(T)), sizeof(T));                                         \
+            lo = (x < lo) ? x : lo;                                                                \
+            hi = (x > hi) ? x : hi;                                                                \
+        }                                                                                          \
+        *min = lo;                                                                                 \
+        *max = hi;                                                                                 \
+    }
+
+CSIMD_GENERATE_MINMAX_SCALAR(int8, int8_t)
+CSIMD_GENERATE_MINMAX_SCALAR(uint8, uint8_t)
+CSIMD_GENERATE_MINMAX_SCALAR(int16, int16_t)
+CSIMD_GENERATE_MINMAX_SCALAR(uint16, uint16_t)
+CSIMD_GENERATE_MINMAX_SCALAR(int32, int32_t)
+CSIMD_GENERATE_MINMAX_SCALAR(uint32, uint32_t)
+CSIMD_GENERATE_MINMAX_SCALAR(int64, int64_t)
+CSIMD_GENERATE_MINMAX_SCALAR(uint64, uint64_t)
+CSIMD_GENERATE_MINMAX_SCALAR(float, float)
+CSIMD_GENERATE_MINMAX_SCALAR(double, double)
+
+#if CSTL_SIMD_X86
+
+/* AVX2 has no 64-bit min / max, pick the lanes with a signed compare (unsigned ones flip the sign
+ * bit first) */
+CSTL_TARGET("avx2")
+static inline __m256i cSimd_min_int64_avx2(const __m256i a, const __m256i b)
+{
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+
+CSTL_TARGET("avx2")
+static inline __m256i cSimd_max_int64_avx2(const __m256i a, const __m256i b)
+{
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(b, a));
+}
+
+CSTL_TARGET("avx2")
+static inline __m256i cSimd_min_uint64_avx2(const __m256i a, const __m256i b)
+{
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i gt = _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign), _mm256_xor_si256(b, sign));
+    return _mm256_blendv_epi8(a, b, gt);
+}
+
+CSTL_TARGET("avx2")
+static inline __m256i cSimd_max_uint64_avx2(const __m256i a, const __m256i b)
+{
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i gt = _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+    return _mm256_blendv_epi8(a, b, gt);
+}
+
+#define CSIMD_LOAD_SI256(p) _mm256_loadu_si256((const __m256i*) (p))
+#define CSIMD_LOAD_PS256(p) _mm256_loadu_ps((const float*) (p))
+#define CSIMD_LOAD_PD256(p) _mm256_loadu_pd((const double*) (p))
+#define CSIMD_STORE_SI256(p, v) _mm256_storeu_si256((__m256i*) (p), v)
+#define CSIMD_STORE_PS256(p, v) _mm256_storeu_ps((float*) (p), v)
+#define CSIMD_STORE_PD256(p, v) _mm256_storeu_pd((double*) (p), v)
+
+/* Two vectors per iteration, each with its own accumulators so the min / max latency of floats
+ * overlaps. The accumulators start as the first element broadcast, and MIN(x, acc) keeps acc when
+ * x is NaN, like the scalar loop. The lanes and the tail are then reduced with the scalar kernel */
+#define CSIMD_GENERATE_MINMAX_AVX2(name, T, V, SET1, LOAD, STORE, MIN, MAX)                        \
+    CSTL_TARGET("avx2")                                                                            \
+    static inline void cSimd_minmax_##name##_avx2(                                                 \
+        const uint8_t* data, const size_t n, T* min, T* max)                                       \
+    {                                                                                              \
+        const size_t lanes = 32 / sizeof(T);                                                       \
+        if (n < 2 * lanes)                                                                         \
+        {                                                                                          \
+            cSimd_minmax_##name##_scalar(data, n, min, max);                                       \
+            return;                                                                                \
+        }                                                                                          \
+        T first;                                                                                   \
+        memcpy(&first, data, sizeof(T));                                                           \
+        V lo0 = SET1(first), lo1 = lo0, hi0 = lo0, hi1 = lo0;                                      \
+        size_t i = 0;                                                                              \
+        for (; i + (2 * lanes) <= n; i += 2 * lanes)                                               \
+        {                                                                                          \
+            const V a = LOAD(data + (i * sizeof(T)));                                              \
+            const V b = LOAD(data + ((i + lanes) * sizeof(T)));                                    \
+            lo0 = MIN(a, lo0);                                                                     \
+            lo1 = MIN(b, lo1);                                                                     \
+            hi0 = MAX(a, hi0);                                                                     \
+            hi1 = MAX(b, hi1);                                                                     \
+        }                                                                                          \
+        T lo_lanes[32 / sizeof(T)], hi_lanes[32 / sizeof(T)], lo, hi, unused;                      \
+        STORE(lo_lanes, MIN(lo1, lo0));                                                            \
+        STORE(hi_lanes, MAX(hi1, hi0));                                                            \
+        cSimd_minmax_##name##_scalar((const uint8_t*) lo_lanes, lanes, &lo, &unused);              \
+        cSimd_minmax_##name##_scalar((const uint8_t*) hi_lanes, lanes, &unused, &hi);              \
+        if (i < n)                                                                                 \
+        {                                                                                          \
+            T tail_lo, tail_hi;                                                                    \
+            cSimd_minmax_##name##_scalar(data + (i * sizeof(T)), n - i, &tail_lo, &tail_hi);       \
+            lo = (tail_lo < lo) ? tail_lo : lo;                                                    \
+            hi = (tail_hi > hi) ? tail_hi : hi;                                                    \
+        }                                                                                          \
+        *min = lo;                                                                                 \
+        *max = hi;                                                                                 \
+    }
+
+CSIMD_GENERATE_MINMAX_AVX2(int8, int8_t, __m256i, _mm256_set1_epi8, CSIMD_LOAD_SI256,
+                           CSIMD_STORE_SI256, _mm256_min_epi8, _mm256_max_epi8)
+CSIMD_GENERATE_MINMAX_AVX2(uint8, uint8_t, __m256i, _mm256_set1_epi8, CSIMD_LOAD_SI256,
+                           CSIMD_STORE_SI256, _mm256_min_epu8, _mm256_max_epu8)
+CSIMD_GENERATE_MINMAX_AVX2(int16, int16_t, __m256i, _mm256_set1_epi16, CSIMD_LOAD_SI256,
+                           CSIMD_STORE_SI256, _mm256_min_epi16, _mm256_max_epi16)
+CSIMD_GENERATE_MINMAX_AVX2(uint16, uint16_t, __m256i, _mm256_set1_epi16, CSIMD_LOAD_SI256,
+                           CSIMD_STORE_SI256, _mm256_min_epu16, _mm256_max_epu16)
+CSIMD_GENERATE_MINMAX_AVX2(int32, int32_t, __m256i, _mm256_set1_epi32, CSIMD_LOAD_SI256,
+                           CSIMD_STORE_SI256, _mm256_min_epi32, _mm256_max_epi32)
+CSIMD_GENERATE_MINMAX_AVX2(uint32, uint32_t, __m256i, _mm256_set1_epi32, CSIMD_LOAD_SI256,
+                           CSIMD_STORE_SI256, _mm256_min_epu32, _mm256_max_epu32)
+CSIMD_GENERATE_MINMAX_AVX2(int64, int64_t, __m256i, _mm256_set1_epi64x, CSIMD_LOAD_SI256,
+                           CSIMD_STORE_SI256, cSimd_min_int64_avx2, cSimd_max_int64_avx2)
+CSIMD_GENERATE_MINMAX_AVX2(uint64, uint64_t, __m256i, _mm256_set1_epi64x, CSIMD_LOAD_SI256,
+                           CSIMD_STORE_SI256, cSimd_min_uint64_avx2, cSimd_max_uint64_avx2)
+CSIMD_GENERATE_MINMAX_AVX2(float, float, __m256, _mm256_set1_ps, CSIMD_LOAD_PS256,
+                           CSIMD_STORE_PS256, _mm256_min_ps, _mm256_max_ps)
+CSIMD_GENERATE_MINMAX_AVX2(double, double, __m256d, _mm256_set1_pd, CSIMD_LOAD_PD256,
+                           CSIMD_STORE_PD256, _mm256_min_pd, _mm256_max_pd)
+
+/* SSE2 lacks most of the integer min / max, CPUs without AVX2 run the scalar loop (which the
+ * compiler may vectorize itself) */
+#define CSIMD_DISPATCH_MINMAX(name, T)                                                             \
+    static inline bool cSimd_minmax_##name(const void* data, const size_t n, T* min, T* max)       \
+    {                                                                                              \
+        if (n == 0)                                                                                \
+            return false;                                                                          \
+        switch (cSimd_isa_get())                                                                   \
+        {                                                                                          \
+            case CSIMD_AVX512:                                                                     \
+            case CSIMD_AVX2:                                                                       \
+                cSimd_minmax_##name##_avx2((const uint8_t*) data, n, min, max);                    \
+                break;                                                                             \
+            default:                                                                               \
+                cSimd_minmax_##name##_scalar((const uint8_t*) data, n, min, max);                  \
+                break;                                                                             \
+        }                                                                                          \
+        return true;                                                                               \
+    }
+#else
+#define CSIMD_DISPATCH_MINMAX(name, T)                                                             \
+    static inline bool cSimd_minmax_##name(const void* data, const size_t n, T* min, T* max)       \
+    {                                                                                              \
+        if (n == 0)                                                                                \
+            return false;                                                                          \
+        cSimd_minmax_##name##_scalar((const uint8_t*) data, n, min, max);                          \
+        return true;                                                                               \
+    }
+#endif // CSTL_SIMD_X86
+
+CSIMD_DISPATCH_MINMAX(int8, int8_t)
+CSIMD_DISPATCH_MINMAX(uint8, uint8_t)
+CSIMD_DISPATCH_MINMAX(int16, int16_t)
+CSIMD_DISPATCH_MINMAX(uint16, uint16_t)
+CSIMD_DISPATCH_MINMAX(int32, int32_t)
+CSIMD_DISPATCH_MINMAX(uint32, uint32_t)
+CSIMD_DISPATCH_MINMAX(int64, int64_t)
+CSIMD_DISPATCH_MINMAX(uint64, uint64_t)
+CSIMD_DISPATCH_MINMAX(float, float)
+CSIMD_DISPATCH_MINMAX(double, double)
+
+/* min and max point to one element of the given type, is_unsigned only matters for integers */
+#define CSIMD_MINMAX_CASE(name, T)                                                                 \
+    {                                                                                              \
+        T lo, hi;                                                                                  \
+        if (! cSimd_minmax_##name(data, n, &lo, &hi))                                              \
+            return false;                                                                          \
+        memcpy(min, &lo, sizeof(T));                                                               \
+        memcpy(max, &hi, sizeof(T));                                                               \
+        return true;                                                                               \
+    }
+
+static inline bool cSimd_minmax(const void* data,
+                                const size_t n,
+                                void* min,
+                                void* max,
+                                const cSimd_elem type,
+                                const bool is_unsigned)
+{
+    switch (type)
+    {
+        case CSIMD_INT8:
+            if (is_unsigned)
+                CSIMD_MINMAX_CASE(uint8, uint8_t)
+            CSIMD_MINMAX_CASE(int8, int8_t)
+        case CSIMD_INT16:
+            if (is_unsigned)
+                CSIMD_MINMAX_CASE(uint16, uint16_t)
+            CSIMD_MINMAX_CASE(int16, int16_t)
+        case CSIMD_INT32:
+            if (is_unsigned)
+                CSIMD_MINMAX_CASE(uint32, uint32_t)
+            CSIMD_MINMAX_CASE(int32, int32_t)
+        case CSIMD_INT64:
+            if (is_unsigned)
+                CSIMD_MINMAX_CASE(uint64, uint64_t)
+            CSIMD_MINMAX_CASE(int64, int64_t)
+        case CSIMD_FLOAT:
+            CSIMD_MINMAX_CASE(float, float)
+        default:
+            CSIMD_MINMAX_CASE(double, double)
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_SIMD_H
@@ -0,0 +1,209 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * cSpscQueue - a lock-free bounded queue for exactly one producer thread and one consumer thread.
+ *
+ * The producer only writes tail and the consumer only writes head, each published with a release
+ * store and read by the other side with an acquire load, so no read-modify-write is ever needed.
+ * Both indices live on their own cache line next to a private copy of the other index, which is
+ * only refreshed when the queue looks full (producer) or empty (consumer): in steady state the two
+ * threads do not touch each other's lines at all. The capacity is a power of two, slots are
+ * picked with a mask instead of a modulo. Requires a C11 compiler with <stdatomic.h>.
+ */
+
+#pragma once
+
+#ifndef CSTL_SPSC_QUEUE_H
+#define CSTL_SPSC_QUEUE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef CSTL_ALIGNAS
+#ifdef __cplusplus
+#define CSTL_ALIGNAS(n) alignas(n)
+#else
+#define CSTL_ALIGNAS(n) _Alignas(n)
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Alignment of the producer and consumer halves of a queue, so they never share a line */
+#define CSPSC_CACHE_LINE 64
+
+/**
+ * Generate a single-producer/single-consumer queue of T and its associated functions
+ * @param T type of the elements
+ * @param CPY of signature void T_cpy(T* dest, const T* src)
+ *
+ * @note enqueue* may only be called from one thread at a time and dequeue* from one other thread
+ * at a time, size and empty may be called from either
+ */
+#define CSPSC_QUEUE_GENERATE(T, CPY)                                                               \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        CSTL_ALIGNAS(CSPSC_CACHE_LINE) _Atomic size_t head; /* next slot to read */                \
+        size_t cached_tail; /* consumer's copy of tail */                                          \
+        CSTL_ALIGNAS(CSPSC_CACHE_LINE) _Atomic size_t tail; /* next slot to write */               \
+        size_t cached_head; /* producer's copy of head */                                          \
+        CSTL_ALIGNAS(CSPSC_CACHE_LINE) T* buffer;                                                  \
+        size_t mask; /* capacity - 1 */                                                            \
+    } cSpscQueue_##T;                                                                              \
+                                                                                                   \
+    /* Initialize an empty queue over buffer, capacity must be a power of two (returns false       \
+     * otherwise). This is not atomic, finish it before sharing the queue with the other thread */ \
+    static inline bool cSpscQueue_##T##_init_from_buffer(                                          \
+        cSpscQueue_##T* queue, T* buffer, const size_t capacity)                                   \
+    {                                                                                              \
+        if ((capacity == 0) || (capacity & (capacity - 1)))                                        \
+            return false;                                                                          \
+        atomic_init(&queue->head, 0);                                                              \
+        atomic_init(&queue->tail, 0);                                                              \
+        queue->cached_head = 0;                                                                    \
+        queue->cached_tail = 0;                                                                    \
+        queue->buffer = buffer;                                                                    \
+        queue->mask = capacity - 1;                                                                \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Free slots as seen by the producer, re-reading head only when fewer than wanted */          \
+    static inline size_t cSpscQueue_##T##_free_slots(cSpscQueue_##T* queue, const size_t tail,     \
+                                                     const size_t wanted)                          \
+    {                                                                                              \
+        size_t free_slots = queue->mask + 1 - (tail - queue->cached_head);                         \
+        if (free_slots < wanted)                                                                   \
+        {                                                                                          \
+            queue->cached_head = atomic_load_explicit(&queue->head, memory_order_acquire);         \
+            free_slots = queue->mask + 1 - (tail - queue->cached_head);                            \
+        }                                                                                          \
+        return free_slots;                                                                         \
+    }                                                                                              \
+                                                                                                   \
+    /* Filled slots as seen by the consumer, re-reading tail only when fewer than wanted */        \
+    static inline size_t cSpscQueue_##T##_used_slots(cSpscQueue_##T* queue, const size_t head,     \
+                                                     const size_t wanted)                          \
+    {                                                                                              \
+        size_t used_slots = queue->cached_tail - head;                                             \
+        if (used_slots < wanted)                                                                   \
+        {                                                                                          \
+            queue->cached_tail = atomic_load_explicit(&queue->tail, memory_order_acquire);         \
+            used_slots = queue->cached_tail - head;                                                \
+        }                                                                                          \
+        return used_slots;                                                                         \
+    }                                                                                              \
+                                                                                                   \
+    /* Producer: append a copy of element, false if the queue is full */                           \
+    static inline bool cSpscQueue_##T##_enqueue(cSpscQueue_##T* queue, const T* element)           \
+    {                                                                                              \
+        const size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);              \
+        if (cSpscQueue_##T##_free_slots(queue, tail, 1) == 0)                                      \
+            return false;                                                                          \
+        CPY(&queue->buffer[tail & queue->mask], element);                                          \
+        atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);                       \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Consumer: remove the oldest element into out (if not NULL), false if the queue is empty */  \
+    static inline bool cSpscQueue_##T##_dequeue(cSpscQueue_##T* queue, T* out)                     \
+    {                                                                                              \
+        const size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);              \
+        if (cSpscQueue_##T##_used_slots(queue, head, 1) == 0)                                      \
+            return false;                                                                          \
+        if (out)                                                                                   \
+            CPY(out, &queue->buffer[head & queue->mask]);                                          \
+        atomic_store_explicit(&queue->head, head + 1, memory_order_release);                       \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Producer: append up to n elements as at most two contiguous copies and a single release     \
+     * store. Returns the number appended, fewer than n if the queue fills up */                   \
+    static inline size_t cSpscQueue_##T##_enqueue_n(                                               \
+        cSpscQueue_##T* queue, const T* elements, size_t n)                                        \
+    {                                                                                              \
+        const size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);              \
+        const size_t free_slots = cSpscQueue_##T##_free_slots(queue, tail, n);                     \
+        if (n > free_slots)                                                                        \
+            n = free_slots;                                                                        \
+        const size_t start = tail & queue->mask;                                                   \
+        const size_t first = (n < queue->mask + 1 - start) ? n : queue->mask + 1 - start;          \
+        for (size_t i = 0; i < first; i++)                                                         \
+            CPY(&queue->buffer[start + i], &elements[i]);                                          \
+        for (size_t i = first; i < n; i++)                                                         \
+            CPY(&queue->buffer[i - first], &elements[i]);                                          \
+        atomic_store_explicit(&queue->tail, tail + n, memory_order_release);                       \
+        return n;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    /* Consumer: remove up to n of the oldest elements into out, in order. Returns the number      \
+     * removed, fewer than n if the queue runs empty */                                            \
+    static inline size_t cSpscQueue_##T##_dequeue_n(cSpscQueue_##T* queue, T* out, size_t n)       \
+    {                                                                                              \
+        const size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);              \
+        const size_t used_slots = cSpscQueue_##T##_used_slots(queue, head, n);                     \
+        if (n > used_slots)                                                                        \
+            n = used_slots;                                                                        \
+        const size_t start = head & queue->mask;                                                   \
+        const size_t first = (n < queue->mask + 1 - start) ? n : queue->mask + 1 - start;          \
+        for (size_t i = 0; i < first; i++)                                                         \
+            CPY(&out[i], &queue->buffer[start + i]);                                               \
+        for (size_t i = first; i < n; i++)                                                         \
+            CPY(&out[i], &queue->buffer[i - first]);                                               \
+        atomic_store_explicit(&queue->head, head + n, memory_order_release);                       \
+        return n;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    /* Number of queued elements, only a snapshot while the other thread is running */             \
+    static inline size_t cSpscQueue_##T##_size(cSpscQueue_##T* queue)                              \
+    {                                                                                              \
+        const size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);              \
+        const size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);              \
+        return (tail >= head) ? tail - head : 0;                                                   \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool cSpscQueue_##T##_empty(cSpscQueue_##T* queue)                               \
+    {                                                                                              \
+        return cSpscQueue_##T##_size(queue) == 0;                                                  \
+    }
+
+/* Create a queue of type T with capacity (a power of two) slots statically, the user must
+ * CSPSC_QUEUE_GENERATE(T, CPY) before creating the queue */
+#define CSPSC_QUEUE_CREATE(name, T, capacity)                                                      \
+    T name##_buf[capacity];                                                                        \
+    cSpscQueue_##T name;                                                                           \
+    cSpscQueue_##T##_init_from_buffer(&name, name##_buf, capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_SPSC_QUEUE_H
@@ -0,0 +1,131 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * Opt-in instrumentation shared by the cSTL containers.
+ *
+ * Define CSTL_STATS before including any cSTL header (or pass -DCSTL_STATS) and cArray and cBitset
+ * count the work they do in counters that are static and thread-local, so per translation unit and
+ * per thread, read with their _stats_get functions. Without it the CSTATS_ macros expand to
+ * nothing, so the containers compile exactly as if they were not there.
+ */
+
+#pragma once
+
+#ifndef CSTL_STATS_H
+#define CSTL_STATS_H
+
+#ifdef CSTL_STATS
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Storage class of the counters, one copy per thread so counting needs no atomics */
+#if defined(__cplusplus)
+#define CSTL_THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+#define CSTL_THREAD_LOCAL __declspec(thread)
+#else
+#define CSTL_THREAD_LOCAL _Thread_local
+#endif
+
+/* Time spent in a family of functions, nested and recursive calls are only timed once */
+typedef struct
+{
+    uint64_t calls; // outermost calls
+    uint64_t ns;    // total wall time of those calls
+    int depth;      // calls in progress
+} cStats_timer;
+
+typedef struct
+{
+    cStats_timer* timer;
+    uint64_t start;
+} cStats_scope;
+
+static inline uint64_t cStats_now_ns(void)
+{
+    struct timespec ts;
+#ifdef CLOCK_MONOTONIC
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static inline cStats_scope cStats_scope_begin(cStats_timer* timer)
+{
+    cStats_scope scope = {timer, 0};
+    if (timer->depth++ == 0)
+        scope.start = cStats_now_ns();
+    return scope;
+}
+
+static inline void cStats_scope_end(cStats_scope* scope)
+{
+    if (--scope->timer->depth == 0)
+    {
+        scope->timer->calls++;
+        scope->timer->ns += cStats_now_ns() - scope->start;
+    }
+}
+
+/* stats.field += n */
+#define CSTATS_ADD(stats, field, n) ((stats).field += (uint64_t) (n))
+
+/* stats.field = max(stats.field, value) */
+#define CSTATS_MAX(stats, field, value)                                                            \
+    ((stats).field = ((uint64_t) (value) > (stats).field) ? (uint64_t) (value) : (stats).field)
+
+/* Time the rest of the enclosing block into the cStats_timer stats.field, whichever way it is
+ * left. Needs the cleanup attribute of GCC and Clang, other compilers do not time anything */
+#if defined(__GNUC__) || defined(__clang__)
+#define CSTATS_TIME_SCOPE(stats, field)                                                            \
+    cStats_scope cstats_scope __attribute__((cleanup(cStats_scope_end))) =                         \
+        cStats_scope_begin(&(stats).field)
+#else
+#define CSTATS_TIME_SCOPE(stats, field) ((void) 0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#else
+
+#define CSTATS_ADD(stats, field, n) ((void) 0)
+#define CSTATS_MAX(stats, field, value) ((void) 0)
+#define CSTATS_TIME_SCOPE(stats, field) ((void) 0)
+
+#endif // CSTL_STATS
+
+#endif // CSTL_STATS_H
@@ -0,0 +1,279 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Nithin M
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/*
+ * cVector - a growable array with 64-bit sizes, allocating through a cAllocator.
+ *
+ * Unlike cArray, which works in a fixed buffer and refuses a push when it is full, a cVector
+ * doubles its capacity when it runs out of room, so n pushes cost O(n) copies in total. The
+ * memory comes from the cAllocator the vector was initialized with: the C heap, an arena (for
+ * temporary vectors freed all at once) or huge pages (for very large vectors). Sizes and indices
+ * are size_t, so a vector can hold more than 2^31 elements.
+ */
+
+#pragma once
+
+#ifndef CSTL_VECTOR_H
+#define CSTL_VECTOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cAllocator.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Capacity of the first allocation of a vector */
+#ifndef CVECTOR_MIN_CAPACITY
+#define CVECTOR_MIN_CAPACITY 8
+#endif
+
+/**
+ * Generate a growable vector of T and its associated functions
+ * @param T type of the elements
+ * @param CPY of signature void T_cpy(T* dest, const T* src)
+ *
+ * @note Growing moves the elements with the allocator's resize, i.e. byte for byte, which is
+ * fine for any C type
+ */
+#define CVECTOR_GENERATE(T, CPY)                                                                   \
+    typedef struct                                                                                 \
+    {                                                                                              \
+        T* array;                                                                                  \
+        size_t size;                                                                               \
+        size_t capacity;                                                                           \
+        cAllocator allocator;                                                                      \
+    } cVector_##T;                                                                                 \
+                                                                                                   \
+    /* Initialize an empty vector, nothing is allocated until the first element is added */        \
+    static inline void cVector_##T##_init(cVector_##T* vector, const cAllocator allocator)         \
+    {                                                                                              \
+        vector->array = NULL;                                                                      \
+        vector->size = 0;                                                                          \
+        vector->capacity = 0;                                                                      \
+        vector->allocator = allocator;                                                             \
+    }                                                                                              \
+                                                                                                   \
+    /* Give the memory back to the allocator, the vector is empty (and usable) again */            \
+    static inline void cVector_##T##_free(cVector_##T* vector)                                     \
+    {                                                                                              \
+        if (vector->array)                                                                         \
+        {                                                                                          \
+            vector->allocator.release(                                                             \
+                vector->allocator.context, vector->array, vector->capacity * sizeof(T));           \
+        }                                                                                          \
+        vector->array = NULL;                                                                      \
+        vector->size = 0;                                                                          \
+        vector->capacity = 0;                                                                      \
+    }                                                                                              \
+                                                                                                   \
+    /* Reallocate to exactly capacity elements (at least size), false if the allocator fails */    \
+    static inline bool cVector_##T##_reallocate(cVector_##T* vector, const size_t capacity)        \
+    {                                                                                              \
+        if (capacity > SIZE_MAX / sizeof(T))                                                       \
+            return false;                                                                          \
+        T* array;                                                                                  \
+        if (! vector->array)                                                                       \
+        {                                                                                          \
+            array = (T*) vector->allocator.alloc(                                                  \
+                vector->allocator.context, capacity * sizeof(T), CSTL_ALIGNOF(T));                 \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            array = (T*) vector->allocator.resize(vector->allocator.context, vector->array,        \
+                                                  vector->capacity * sizeof(T),                    \
+                                                  capacity * sizeof(T), CSTL_ALIGNOF(T));          \
+        }                                                                                          \
+        if (! array)                                                                               \
+            return false;                                                                          \
+        vector->array = array;                                                                     \
+        vector->capacity = capacity;                                                               \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Make room for at least capacity elements in one allocation, so the next pushes up to that   \
+     * size never reallocate. False if the allocator fails (the vector is unchanged) */            \
+    static inline bool cVector_##T##_reserve(cVector_##T* vector, const size_t capacity)           \
+    {                                                                                              \
+        if (capacity <= vector->capacity)                                                          \
+            return true;                                                                           \
+        return cVector_##T##_reallocate(vector, capacity);                                         \
+    }                                                                                              \
+                                                                                                   \
+    /* Make room for at least min_capacity elements, doubling the capacity */                      \
+    static inline bool cVector_##T##_grow(cVector_##T* vector, const size_t min_capacity)          \
+    {                                                                                              \
+        if (min_capacity <= vector->capacity)                                                      \
+            return true;                                                                           \
+        size_t capacity = (vector->capacity > SIZE_MAX / 2) ? SIZE_MAX : vector->capacity * 2;     \
+        capacity = (capacity < CVECTOR_MIN_CAPACITY) ? CVECTOR_MIN_CAPACITY : capacity;            \
+        capacity = (capacity < min_capacity) ? min_capacity : capacity;                            \
+        return cVector_##T##_reallocate(vector, capacity);                                         \
+    }                                                                                              \
+                                                                                                   \
+    /* Shrink the allocation to size elements (or free it if the vector is empty). False if the    \
+     * allocator fails, the vector is then unchanged */                                            \
+    static inline bool cVector_##T##_shrink_to_fit(cVector_##T* vector)                            \
+    {                                                                                              \
+        if (vector->size == vector->capacity)                                                      \
+            return true;                                                                           \
+        if (vector->size == 0)                                                                     \
+        {                                                                                          \
+            cVector_##T##_free(vector);                                                            \
+            return true;                                                                           \
+        }                                                                                          \
+        return cVector_##T##_reallocate(vector, vector->size);                                     \
+    }                                                                                              \
+                                                                                                   \
+    /* Index of element if it points into the first size elements of the array, else SIZE_MAX.     \
+     * Lets the functions below take an element of the vector itself across a reallocation */      \
+    static inline size_t cVector_##T##_index_of(const cVector_##T* vector, const T* element)       \
+    {                                                                                              \
+        const uintptr_t start = (uintptr_t) vector->array, at = (uintptr_t) element;               \
+        if (! vector->array || (at < start) || (at - start >= vector->size * sizeof(T)))           \
+            return SIZE_MAX;                                                                       \
+        return (size_t) (at - start) / sizeof(T);                                                  \
+    }                                                                                              \
+                                                                                                   \
+    /* Add an element at the end, amortized O(1). False only if the allocator fails. element may   \
+     * be an element of the vector */                                                              \
+    static inline bool cVector_##T##_push(cVector_##T* vector, const T* element)                   \
+    {                                                                                              \
+        if (vector->size == vector->capacity)                                                      \
+        {                                                                                          \
+            const size_t from = cVector_##T##_index_of(vector, element);                           \
+            if (! cVector_##T##_grow(vector, vector->size + 1))                                    \
+                return false;                                                                      \
+            element = (from != SIZE_MAX) ? &vector->array[from] : element;                         \
+        }                                                                                          \
+        CPY(&vector->array[vector->size], element);                                                \
+        vector->size++;                                                                            \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Add n elements at the end, growing at most once. elements may be a range of the vector */   \
+    static inline bool cVector_##T##_push_n(                                                       \
+        cVector_##T* vector, const T* elements, const size_t n)                                    \
+    {                                                                                              \
+        const size_t from = cVector_##T##_index_of(vector, elements);                              \
+        if ((n > SIZE_MAX - vector->size) || ! cVector_##T##_grow(vector, vector->size + n))       \
+            return false;                                                                          \
+        elements = (from != SIZE_MAX) ? &vector->array[from] : elements;                           \
+        for (size_t i = 0; i < n; i++)                                                             \
+            CPY(&vector->array[vector->size + i], &elements[i]);                                   \
+        vector->size += n;                                                                         \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Remove the last element and copy it to out (if not NULL), false if the vector is empty */   \
+    static inline bool cVector_##T##_pop(cVector_##T* vector, T* out)                              \
+    {                                                                                              \
+        if (vector->size == 0)                                                                     \
+            return false;                                                                          \
+        vector->size--;                                                                            \
+        if (out)                                                                                   \
+            CPY(out, &vector->array[vector->size]);                                                \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Insert element at index (<= size), shifting the following elements. element may be an       \
+     * element of the vector */                                                                    \
+    static inline bool cVector_##T##_insert(                                                       \
+        cVector_##T* vector, const T* element, const size_t index)                                 \
+    {                                                                                              \
+        if (index > vector->size)                                                                  \
+            return false;                                                                          \
+        const size_t from = cVector_##T##_index_of(vector, element);                               \
+        if ((vector->size == vector->capacity) && ! cVector_##T##_grow(vector, vector->size + 1))  \
+            return false;                                                                          \
+        for (size_t i = vector->size; i > index; i--)                                              \
+            CPY(&vector->array[i], &vector->array[i - 1]);                                         \
+        if (from != SIZE_MAX)                                                                      \
+            element = &vector->array[(from >= index) ? from + 1 : from];                           \
+        CPY(&vector->array[index], element);                                                       \
+        vector->size++;                                                                            \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Remove the element at index, shifting the following elements */                             \
+    static inline bool cVector_##T##_delete(cVector_##T* vector, const size_t index)               \
+    {                                                                                              \
+        if (index >= vector->size)                                                                 \
+            return false;                                                                          \
+        for (size_t i = index; i + 1 < vector->size; i++)                                          \
+            CPY(&vector->array[i], &vector->array[i + 1]);                                         \
+        vector->size--;                                                                            \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Pointer to the element at index, or NULL if index is out of bounds */                       \
+    static inline T* cVector_##T##_at(const cVector_##T* vector, const size_t index)               \
+    {                                                                                              \
+        return (index < vector->size) ? &vector->array[index] : NULL;                              \
+    }                                                                                              \
+                                                                                                   \
+    /* Set the size, new elements are copies of fill (if not NULL, may be an element of the        \
+     * vector). Grows like push, so growing one element at a time is amortized O(1). False if the  \
+     * allocator fails */                                                                          \
+    static inline bool cVector_##T##_resize(cVector_##T* vector, const size_t size, const T* fill) \
+    {                                                                                              \
+        const size_t from = cVector_##T##_index_of(vector, fill);                                  \
+        if ((size > vector->size) && ! cVector_##T##_grow(vector, size))                           \
+            return false;                                                                          \
+        fill = (from != SIZE_MAX) ? &vector->array[from] : fill;                                   \
+        if (fill)                                                                                  \
+        {                                                                                          \
+            for (size_t i = vector->size; i < size; i++)                                           \
+                CPY(&vector->array[i], fill);                                                      \
+        }                                                                                          \
+        vector->size = size;                                                                       \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Remove every element, the capacity is kept */                                               \
+    static inline void cVector_##T##_clear(cVector_##T* vector)                                    \
+    {                                                                                              \
+        vector->size = 0;                                                                          \
+    }
+
+/* Loop over every element of a vector, e.g.
+ * int* x;
+ * CVECTOR_FOREACH(&vec, x) { ... } */
+#define CVECTOR_FOREACH(vector, element)                                                           \
+    for (size_t element##_i = 0;                                                                   \
+         (element##_i < (vector)->size) && ((element) = &(vector)->array[element##_i], 1);         \
+         element##_i++)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTL_VECTOR_H
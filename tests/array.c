@@ -0,0 +1,61 @@
+/*
+ * cArray regression tests.
+ *
+ * Build and run: make -C tests
+ */
+
+#include "cArray.h"
+#include <assert.h>
+
+CARRAY_GENERATE_PRIMITIVE(int)
+
+/* Truthy values other than 1 */
+#define BIT1(x) (*(x) & 2)
+CARRAY_GENERATE_PREDICATE(int, bit1, BIT1)
+
+static void test_predicate_truthy(void)
+{
+    const int values[] = {2, 3, 6, 4};
+    CARRAY_CREATE(arr, int, 8)
+    for (int i = 0; i < 3; i++)
+        cArray_int_push(&arr, &values[i]);
+    assert(cArray_int_all_of_bit1(&arr));
+    assert(cArray_int_any_of_bit1(&arr));
+    assert(cArray_int_count_if_bit1(&arr) == 3);
+
+    cArray_int_push(&arr, &values[3]);
+    assert(! cArray_int_all_of_bit1(&arr));
+    assert(cArray_int_any_of_bit1(&arr));
+    assert(cArray_int_count_if_bit1(&arr) == 3);
+}
+
+/* Integers in reverse order: the SIMD search still applies, the SIMD minmax must not */
+typedef int rint;
+static inline void rint_cpy(rint* dest, const rint* src)
+{
+    *dest = *src;
+}
+static inline int rint_cmp(const rint* a, const rint* b)
+{
+    return (*b > *a) - (*b < *a);
+}
+CARRAY_GENERATE_EX(rint, rint_cpy, rint_cmp, CARRAY_INTEGER | CARRAY_TRIVIAL)
+
+static void test_minmax_custom_order(void)
+{
+    const rint values[] = {5, -3, 9, 0, 7};
+    CARRAY_CREATE(arr, rint, 8)
+    for (int i = 0; i < 5; i++)
+        cArray_rint_push(&arr, &values[i]);
+    rint min, max;
+    assert(cArray_rint_minmax(&arr, 0, arr.size - 1, &min, &max));
+    assert(min == 9 && max == -3);
+    assert(cArray_rint_find(&arr, &values[3]) == 3);
+}
+
+int main(void)
+{
+    test_predicate_truthy();
+    test_minmax_custom_order();
+    return 0;
+}
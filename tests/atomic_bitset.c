@@ -0,0 +1,83 @@
+/*
+ * cAtomicBitset regression tests.
+ *
+ * Build and run: make -C tests
+ */
+
+#include "cAtomicBitset.h"
+#include <assert.h>
+#include <pthread.h>
+
+#define NUM_SLOTS 1024
+#define OPS_PER_THREAD 20000
+#define HELD_PER_THREAD 8
+#define NUM_THREADS 8
+
+static _Atomic uint64_t slots_buf[CBITSET64_WORDS(NUM_SLOTS)];
+static cAtomicBitset slots;
+static _Atomic int owners[NUM_SLOTS];
+static _Atomic int violations;
+
+typedef struct
+{
+    pthread_t thread;
+    int id;
+    bool use_hint;
+} worker;
+
+/* Claim and release HELD_PER_THREAD slots at a time, counting the owners of every slot */
+static void* worker_run(void* arg)
+{
+    const worker* w = (const worker*) arg;
+    size_t held[HELD_PER_THREAD];
+    size_t hint = w->use_hint ? (size_t) w->id * NUM_SLOTS / NUM_THREADS : 0;
+
+    for (int op = 0; op < OPS_PER_THREAD; op += HELD_PER_THREAD)
+    {
+        for (int k = 0; k < HELD_PER_THREAD; k++)
+        {
+            held[k] = cAtomicBitset_claim_first_zero(&slots, hint);
+            if (held[k] == CBITSET_NPOS)
+            {
+                atomic_fetch_add(&violations, 1);
+                return NULL;
+            }
+            if (atomic_fetch_add_explicit(&owners[held[k]], 1, memory_order_relaxed) != 0)
+                atomic_fetch_add(&violations, 1);
+            if (w->use_hint)
+                hint = held[k];
+        }
+        for (int k = 0; k < HELD_PER_THREAD; k++)
+        {
+            if (atomic_fetch_sub_explicit(&owners[held[k]], 1, memory_order_relaxed) != 1)
+                atomic_fetch_add(&violations, 1);
+            if (! cAtomicBitset_test_and_clear(&slots, held[k]))
+                atomic_fetch_add(&violations, 1);
+        }
+    }
+    return NULL;
+}
+
+/* No slot is ever claimed by two threads at once, and every slot is released at the end */
+static void test_claim_exclusive(const bool use_hint)
+{
+    worker workers[NUM_THREADS];
+    cAtomicBitset_init_from_buffer(&slots, slots_buf, NUM_SLOTS);
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        workers[i].id = i;
+        workers[i].use_hint = use_hint;
+        assert(pthread_create(&workers[i].thread, NULL, worker_run, &workers[i]) == 0);
+    }
+    for (int i = 0; i < NUM_THREADS; i++)
+        pthread_join(workers[i].thread, NULL);
+    assert(atomic_load(&violations) == 0);
+    assert(cAtomicBitset_count(&slots) == 0);
+}
+
+int main(void)
+{
+    test_claim_exclusive(false);
+    test_claim_exclusive(true);
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * cExternalSort regression tests.
+ *
+ * Build and run: make -C tests
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "cExternalSort.h"
+#include <assert.h>
+#include <dirent.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+typedef uint64_t u64;
+
+CARRAY_GENERATE_PRIMITIVE(u64)
+CARRAY_GENERATE_EXTERNAL_SORT(u64, u64_cpy, u64_cmp)
+
+/* 8 chunks of 1024 records, so 8 runs merged 2 at a time */
+#define RECORDS 8192
+#define MEMORY 8192
+
+static char dir[] = "/tmp/cstl_test_XXXXXX";
+static char runs[64], input[64], output[64];
+
+static void write_input(void)
+{
+    FILE* file = fopen(input, "wb");
+    assert(file);
+    uint64_t x = 88172645463325252ULL;
+    for (int i = 0; i < RECORDS; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        assert(fwrite(&x, sizeof(x), 1, file) == 1);
+    }
+    assert(fclose(file) == 0);
+}
+
+static int count_files(const char* path)
+{
+    DIR* d = opendir(path);
+    assert(d);
+    int n = 0;
+    struct dirent* entry;
+    while ((entry = readdir(d)))
+        n += (entry->d_name[0] != '.');
+    closedir(d);
+    return n;
+}
+
+/* Sort with files limited to max_file bytes (0 for no limit), writes past it fail with EFBIG */
+static bool sort_limited(const rlim_t max_file)
+{
+    struct rlimit saved, limit;
+    assert(getrlimit(RLIMIT_FSIZE, &saved) == 0);
+    limit = saved;
+    if (max_file)
+        limit.rlim_cur = max_file;
+    assert(setrlimit(RLIMIT_FSIZE, &limit) == 0);
+
+    cExtSort_config config = cExtSort_default_config();
+    config.memory = MEMORY;
+    config.temp_dir = runs;
+    const bool ok = cArray_u64_external_sort(input, output, &config);
+    assert(setrlimit(RLIMIT_FSIZE, &saved) == 0);
+    return ok;
+}
+
+static void test_sorted(void)
+{
+    assert(sort_limited(0));
+    FILE* file = fopen(output, "rb");
+    assert(file);
+    u64 prev = 0, x;
+    int n = 0;
+    for (; fread(&x, sizeof(x), 1, file) == 1; n++)
+    {
+        assert(x >= prev);
+        prev = x;
+    }
+    fclose(file);
+    assert(n == RECORDS);
+    assert(count_files(runs) == 0);
+}
+
+/* A failed write deletes the partial run, in the first phase and in an intermediate merge */
+static void test_write_failure_cleanup(void)
+{
+    assert(! sort_limited(MEMORY / 2));
+    assert(count_files(runs) == 0);
+    assert(! sort_limited(MEMORY + MEMORY / 2));
+    assert(count_files(runs) == 0);
+}
+
+int main(void)
+{
+    signal(SIGXFSZ, SIG_IGN);
+    assert(mkdtemp(dir));
+    snprintf(runs, sizeof(runs), "%s/runs", dir);
+    snprintf(input, sizeof(input), "%s/input", dir);
+    snprintf(output, sizeof(output), "%s/output", dir);
+    assert(mkdir(runs, 0700) == 0);
+    write_input();
+
+    test_sorted();
+    test_write_failure_cleanup();
+
+    unlink(input);
+    unlink(output);
+    rmdir(runs);
+    rmdir(dir);
+    return 0;
+}
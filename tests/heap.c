@@ -0,0 +1,60 @@
+/*
+ * cHeap regression tests.
+ *
+ * Build and run: make -C tests
+ */
+
+#include "cHeap.h"
+#include <assert.h>
+
+static inline void int_cpy(int* dest, const int* src)
+{
+    *dest = *src;
+}
+
+static inline int int_cmp(const int* a, const int* b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+/* Several arities of the same element type in one file */
+CHEAP_GENERATE(int, int_cpy, int_cmp)
+CHEAP_GENERATE_D(int_2, int, int_cpy, int_cmp, 2)
+CINDEXED_HEAP_GENERATE_D(int_8, int, int_cpy, int_cmp, 8)
+
+static void test_arities(void)
+{
+    const int values[] = {5, 3, 9, 1, 7, 2, 8};
+    CHEAP_CREATE(quad, int, 8)
+    int buf[8];
+    cHeap_int_2 binary;
+    cHeap_int_2_init_from_buffer(&binary, buf, 8);
+    for (int i = 0; i < 7; i++)
+    {
+        assert(cHeap_int_push(&quad, &values[i]));
+        assert(cHeap_int_2_push(&binary, &values[i]));
+    }
+    int a, b, prev = 0;
+    while (cHeap_int_pop(&quad, &a))
+    {
+        assert(cHeap_int_2_pop(&binary, &b));
+        assert((a == b) && (a >= prev));
+        prev = a;
+    }
+    assert(binary.size == 0);
+
+    int ids[7], pos[7], keys[7];
+    cIndexedHeap_int_8 queue;
+    cIndexedHeap_int_8_init_from_buffer(&queue, ids, pos, keys, 7);
+    for (int id = 0; id < 7; id++)
+        assert(cIndexedHeap_int_8_push(&queue, id, &values[id]));
+    int id, key;
+    assert(cIndexedHeap_int_8_pop(&queue, &id, &key));
+    assert((id == 3) && (key == 1));
+}
+
+int main(void)
+{
+    test_arities();
+    return 0;
+}
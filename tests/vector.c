@@ -0,0 +1,97 @@
+/*
+ * cVector regression tests.
+ *
+ * Build and run: make -C tests
+ */
+
+#include "cVector.h"
+#include <assert.h>
+
+static inline void int_cpy(int* dest, const int* src)
+{
+    *dest = *src;
+}
+
+CVECTOR_GENERATE(int, int_cpy)
+
+/* A vector of 0, 1, ..., n - 1 with no spare capacity, so the next push reallocates */
+static void fill_full(cVector_int* vec, const int n)
+{
+    cVector_int_init(vec, cAllocator_heap());
+    for (int i = 0; i < n; i++)
+        cVector_int_push(vec, &i);
+    cVector_int_shrink_to_fit(vec);
+    assert(vec->size == vec->capacity);
+}
+
+static void test_push_self(void)
+{
+    cVector_int vec;
+    fill_full(&vec, 5);
+    assert(cVector_int_push(&vec, &vec.array[1]));
+    assert(vec.size == 6 && vec.array[5] == 1);
+    cVector_int_free(&vec);
+}
+
+static void test_push_n_self(void)
+{
+    cVector_int vec;
+    fill_full(&vec, 5);
+    assert(cVector_int_push_n(&vec, vec.array, vec.size));
+    assert(vec.size == 10);
+    for (int i = 0; i < 10; i++)
+        assert(vec.array[i] == i % 5);
+    cVector_int_free(&vec);
+}
+
+static void test_insert_self(void)
+{
+    cVector_int vec;
+    fill_full(&vec, 5);
+    assert(cVector_int_insert(&vec, &vec.array[3], 1));
+    const int expected[] = {0, 3, 1, 2, 3, 4};
+    for (int i = 0; i < 6; i++)
+        assert(vec.array[i] == expected[i]);
+    assert(cVector_int_insert(&vec, &vec.array[0], 6));
+    assert(vec.size == 7 && vec.array[6] == 0);
+    assert(cVector_int_insert(&vec, &vec.array[2], 0));
+    assert(vec.size == 8 && vec.array[0] == 1 && vec.array[3] == 1);
+    cVector_int_free(&vec);
+}
+
+static void test_resize_fill_self(void)
+{
+    cVector_int vec;
+    fill_full(&vec, 5);
+    assert(cVector_int_resize(&vec, 8, &vec.array[4]));
+    for (int i = 5; i < 8; i++)
+        assert(vec.array[i] == 4);
+    cVector_int_free(&vec);
+}
+
+/* Growing one element at a time reallocates O(log n) times, like push */
+static void test_resize_geometric(void)
+{
+    cVector_int vec;
+    cVector_int_init(&vec, cAllocator_heap());
+    const int zero = 0;
+    int reallocations = 0;
+    for (size_t size = 1; size <= 1024; size++)
+    {
+        const size_t capacity = vec.capacity;
+        assert(cVector_int_resize(&vec, size, &zero));
+        reallocations += (vec.capacity != capacity);
+    }
+    assert(reallocations <= 8);
+    cVector_int_free(&vec);
+}
+
+int main(void)
+{
+    test_push_self();
+    test_push_n_self();
+    test_insert_self();
+    test_resize_fill_self();
+    test_resize_geometric();
+    return 0;
+}